@@ -176,37 +176,30 @@ npc_get_path (EngChunk chunk[], Entity *entity, int path_id)
         int offset_x = 0;
         int offset_y = 0;
 
-        if (chunk[1].chunk_x == chunk[0].chunk_x - 1)
-            offset_x = TILESX;
-
-        if (chunk[2].chunk_y == chunk[0].chunk_y - 1)
-            offset_y = TILESY;
+        /* Path tiles are relative to the top-left chunk of the window. */
+        eng_chunk_get_window_origin (chunk, &offset_x, &offset_y);
+        offset_x = -offset_x * TILESX;
+        offset_y = -offset_y * TILESY;
 
         switch (path_id) {
         /* From bridge to village. */
         case 0:
-            for (int i = 0; i < NBCHUNKS; i++) {
-                if (chunk[i].chunk_x == 0 && chunk[i].chunk_y == 0) {
-                    entity->path = eng_pathfind_get_path (chunk,
-                                                          22 + offset_x,
-                                                          4 + offset_y,
-                                                          35 + offset_x,
-                                                          10 + offset_y);
-                    break;
-                }
+            if (eng_chunk_get_chunk (chunk, 0, 0) != NULL) {
+                entity->path = eng_pathfind_get_path (chunk,
+                                                      22 + offset_x,
+                                                      4 + offset_y,
+                                                      35 + offset_x,
+                                                      10 + offset_y);
             }
             break;
         /* From village to bridge. */
         case 1:
-            for (int i = 0; i < NBCHUNKS; i++) {
-                if (chunk[i].chunk_x == 0 && chunk[i].chunk_y == 0) {
-                    entity->path = eng_pathfind_get_path (chunk,
-                                                          35 + offset_x,
-                                                          10 + offset_y,
-                                                          22 + offset_x,
-                                                          4 + offset_y);
-                    break;
-                }
+            if (eng_chunk_get_chunk (chunk, 0, 0) != NULL) {
+                entity->path = eng_pathfind_get_path (chunk,
+                                                      35 + offset_x,
+                                                      10 + offset_y,
+                                                      22 + offset_x,
+                                                      4 + offset_y);
             }
             break;
         }
@@ -25,6 +25,11 @@
 #include "../Mini_Engine/HUD/hud.h"
 #include "../Mini_Engine/Time/time.h"
 #include "../Mini_Engine/Chunks/chunk.h"
+#include "../Mini_Engine/Chunks/chunk_directory.h"
+#include "../Mini_Engine/Chunks/chunk_region.h"
+#include "../Mini_Engine/Chunks/chunk_streamer.h"
+#include "../Mini_Engine/Chunks/chunk_writer.h"
+#include "../Mini_Engine/Chunks/tile.h"
 #include "../Mini_Engine/Characters/character.h"
 #include "../Mini_Engine/Collision/collision_handler.h"
 #include "../Mini_Engine/Events/events.h"
@@ -36,6 +41,7 @@
 #include "character/player.h"
 #include "objects/objects.h"
 #include "hud/hud_handler.h"
+#include "map/collision.h"
 #include "map/map.h"
 
 int
@@ -91,6 +97,8 @@ main (int argc, char * argv[])
     for (int i = 0; i < NBCHUNKS; i++)
         chunk[i] = eng_chunk_create_chunk ();
 
+    eng_chunk_directory_set_window (chunk);
+
     /* Initialize characters. */
     int nb_entities = 7;
     EngCollision collision = {false, false, false, false};
@@ -114,6 +122,16 @@ main (int argc, char * argv[])
     /* Run engine unit tests. */
     eng_test_all();
 
+    /*
+     * The chunks around the player are loaded right away, the next ones are
+     * loaded in the background. Tiles and objects get their collision while
+     * they are loaded.
+     */
+    set_tile_properties ();
+    object_register_footprints ();
+    map_handler (chunk, entity[0].character);
+    eng_chunk_streamer_start ();
+
     printf ("Walk using the directional arrows on your keyboard.\n");
 
     /*---- Main Loop. -------------------------------------------------------*/
@@ -125,6 +143,9 @@ main (int argc, char * argv[])
         /* Updating the map. */
         map_handler (chunk, entity[0].character);
 
+        /* Write chunk edits to their files once in a while. */
+        eng_chunk_writer_update ();
+
         /* Updating entities. */
         for (int i = 0; i < nb_entities; i++) {
             eng_char_update (entity[0].character, &entity[i].character);
@@ -151,6 +172,7 @@ main (int argc, char * argv[])
 
         /* Rendering. */
         if (eng_has_time_elapsed (&render_timer, true, ENG_MILLISECOND, 17)) {
+            eng_tile_set_animation_clock (eng_get_real_time ());
             eng_render_tiles (renderer, chunk, entity[0].character,
                               tile_text, 1);
             /*
@@ -176,6 +198,12 @@ main (int argc, char * argv[])
     for (int i = 0; i < nb_entities; i++)
         eng_char_destroy_character (&render_char[i]);
 
+    eng_chunk_directory_clear ();
+    eng_chunk_streamer_stop ();
+    eng_chunk_writer_flush ();
+    eng_chunk_region_unmap_all ();
+    eng_tile_clear_properties ();
+
     for (int i = 0; i < NBCHUNKS; i++)
         eng_chunk_destroy (&chunk[i]);
 
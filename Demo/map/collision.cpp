@@ -3,19 +3,22 @@
 /* Author: YOAN BERNATCHEZ                                                   */
 /* Created On: 2020-10-18                                                    */
 /* Developed Using: SDL2                                                     */
-/* Function: Provides a function that sets collision in chunks.              */
+/* Function: Provides a function that sets the properties of the tiles.      */
 /*===========================================================================*/
 
 #include "../../Mini_Engine/Engine/globals.h"
 #include "../../Mini_Engine/Chunks/tile.h"
 #include "collision.h"
 
-/* Sets certain tiles in the array of chunks to have collision. */
+/*
+ * Registers the properties of the tiles of the tile sheet. Tiles 0 to 44 are
+ * walls, except for tile 42.
+ */
 void
-set_map_collisions (EngChunk chunk[])
+set_tile_properties (void)
 {
     for (int i = 0; i < 45; i++)
-        eng_tile_set_collision (chunk, i, true);
+        eng_tile_register_properties (i, ENG_TILE_SOLID, 1);
 
-    eng_tile_set_collision (chunk, 42, false);
+    eng_tile_register_properties (42, 0, 1);
 }
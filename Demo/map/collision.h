@@ -4,10 +4,9 @@
 #include "../../Mini_Engine/Engine/globals.h"
 
 /**
- * @brief Sets certain tiles in the array of chunks to have collision.
- *
- * @param chunk: Array of chunk to modify collision of.
+ * @brief Registers the properties of the tiles of the tile sheet, such as
+ *        collision. Must be called before the chunks are loaded.
  */
-void set_map_collisions (EngChunk chunk[]);
+void set_tile_properties (void);
 
 #endif /* COLLISION_H_INCLUDED */
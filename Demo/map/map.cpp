@@ -11,11 +11,11 @@
 #include "../../Mini_Engine/Chunks/chunk.h"
 #include "../../Mini_Engine/Characters/character.h"
 #include "../objects/objects.h"
-#include "collision.h"
 
 /*
- * Keeps the map updated by rotating chunks, setting tile collisions
- * and assigning object properties.
+ * Keeps the map updated by rotating chunks and assigning object properties.
+ * Tile collision is given by the chunk loader. Chunks ahead of the character
+ * are prefetched.
  */
 void
 map_handler (EngChunk chunk[], EngCharacter character)
@@ -29,8 +29,10 @@ map_handler (EngChunk chunk[], EngCharacter character)
                                               character.y,
                                               char_chunk_x,
                                               char_chunk_y);
-    if (is_map_changed) {
-        set_map_collisions (chunk);
+    if (is_map_changed)
         object_assign_properties (chunk);
-    }
+
+    /* Load the chunks ahead of the player in the background. */
+    eng_chunk_prefetch_chunks (chunk, character.x, character.y,
+                               character.direction);
 }
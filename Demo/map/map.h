@@ -4,8 +4,8 @@
 #include "../../Mini_Engine/Engine/globals.h"
 
 /**
- * @brief Keeps the map updated by rotating chunks, setting tile collisions
- *        and assigning object properties.
+ * @brief Keeps the map updated by rotating chunks and assigning object
+ *        properties.
  *
  * @param chunk:     Array of chunk containing object and tile information.
  * @param character: Character used as reference point for updating.
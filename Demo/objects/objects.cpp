@@ -10,9 +10,32 @@
 #include <SDL.h>
 #include <SDL_image.h>
 #include "../../Mini_Engine/Chunks/chunk.h"
+#include "../../Mini_Engine/Chunks/objects.h"
 #include "objects.h"
 #include "wheat.h"
 
+/** Number of object ids of the object sheet, one past the last id. */
+#define OBJECT_NB_IDS 11
+
+/*---------------------------------------------------------------------------*/
+/* Local function prototypes                                                 */
+/*---------------------------------------------------------------------------*/
+
+/**
+ * @brief Gives an object the properties linked to its id, such as its
+ *        sprite, and returns the collision footprint of the objects of that
+ *        id.
+ *
+ * @param id:        The object id.
+ * @param object:    Object receiving the properties.
+ * @param footprint: Receives the footprint of the id, empty if the objects
+ *                   of that id have no collision.
+ *
+ * @return True if the id has defined properties, false otherwise.
+ */
+static bool get_object_properties (int id, EngObject *object,
+                                   SDL_Rect *footprint);
+
 /*
  * Returns a sprite sheet texture that contains the graphics of all the
  * objects.
@@ -65,135 +88,210 @@ tile_get_texture (SDL_Renderer *renderer)
 void
 object_assign_properties (EngChunk chunk[])
 {
+    SDL_Rect footprint;
+
     for (int i = 0; i < NBCHUNKS; i++) {
         for (int j = 0; j < chunk[i].nb_objects; j++) {
-            switch (chunk[i].object[j].id) {
-            /* Sign. */
-            case 0:
-                chunk[i].object[j].src.x = 0;
-                chunk[i].object[j].src.y = 0;
-                chunk[i].object[j].src.w = 40;
-                chunk[i].object[j].src.h = 42;
-                chunk[i].object[j].center_y = 40;
-                chunk[i].object[j].nb_frames = 1;
-                chunk[i].object[j].render_mode = ENG_RENDER_HYBRID;
-                chunk[i].object[j].texture_index = 0;
-                break;
-            /* Red tree. */
-            case 1:
-                chunk[i].object[j].src.x = 54;
-                chunk[i].object[j].src.y = 0;
-                chunk[i].object[j].src.w = 180;
-                chunk[i].object[j].src.h = 190;
-                chunk[i].object[j].center_y = 150;
-                chunk[i].object[j].nb_frames = 1;
-                chunk[i].object[j].render_mode = ENG_RENDER_HYBRID;
-                chunk[i].object[j].texture_index = 0;
-                break;
-            /* Small desk with apple. */
-            case 2:
-                chunk[i].object[j].src.x = 246;
-                chunk[i].object[j].src.y = 0;
-                chunk[i].object[j].src.w = 64;
-                chunk[i].object[j].src.h = 64;
-                chunk[i].object[j].center_y = 0;
-                chunk[i].object[j].nb_frames = 1;
-                chunk[i].object[j].render_mode = ENG_RENDER_HYBRID;
-                chunk[i].object[j].texture_index = 0;
-                break;
-            /* Yellow bed. */
-            case 3:
-                chunk[i].object[j].src.x = 334;
-                chunk[i].object[j].src.y = 0;
-                chunk[i].object[j].src.w = 64;
-                chunk[i].object[j].src.h = 128;
-                chunk[i].object[j].center_y = 0;
-                chunk[i].object[j].nb_frames = 1;
-                chunk[i].object[j].render_mode = ENG_RENDER_HYBRID;
-                chunk[i].object[j].texture_index = 0;
-                break;
-            /* Door mat. */
-            case 4:
-                chunk[i].object[j].src.x = 245;
-                chunk[i].object[j].src.y = 83;
-                chunk[i].object[j].src.w = 68;
-                chunk[i].object[j].src.h = 37;
-                chunk[i].object[j].center_y = 0;
-                chunk[i].object[j].nb_frames = 1;
-                chunk[i].object[j].render_mode = ENG_RENDER_BACKGROUND;
-                chunk[i].object[j].texture_index = 0;
-                break;
-            /* Wheat. */
-            case 5:
-                chunk[i].object[j].src.x = 494;
-                chunk[i].object[j].src.y = 0;
-                chunk[i].object[j].src.w = 66;
-                chunk[i].object[j].src.h = 89;
-                chunk[i].object[j].center_y = 82;
-                chunk[i].object[j].nb_frames = 2;
-                chunk[i].object[j].render_mode = ENG_RENDER_HYBRID;
-                chunk[i].object[j].texture_index = 0;
-                break;
-            /* Blue bed. */
-            case 6:
-                chunk[i].object[j].src.x = 408;
-                chunk[i].object[j].src.y = 0;
-                chunk[i].object[j].src.w = 64;
-                chunk[i].object[j].src.h = 128;
-                chunk[i].object[j].center_y = 0;
-                chunk[i].object[j].nb_frames = 1;
-                chunk[i].object[j].render_mode = ENG_RENDER_HYBRID;
-                chunk[i].object[j].texture_index = 0;
-                break;
-            /* Green bed. */
-            case 7:
-                chunk[i].object[j].src.x = 334;
-                chunk[i].object[j].src.y = 135;
-                chunk[i].object[j].src.w = 64;
-                chunk[i].object[j].src.h = 128;
-                chunk[i].object[j].center_y = 0;
-                chunk[i].object[j].nb_frames = 1;
-                chunk[i].object[j].render_mode = ENG_RENDER_HYBRID;
-                chunk[i].object[j].texture_index = 0;
-                break;
-            /* Red bed. */
-            case 8:
-                chunk[i].object[j].src.x = 408;
-                chunk[i].object[j].src.y = 135;
-                chunk[i].object[j].src.w = 64;
-                chunk[i].object[j].src.h = 128;
-                chunk[i].object[j].center_y = 0;
-                chunk[i].object[j].nb_frames = 1;
-                chunk[i].object[j].render_mode = ENG_RENDER_HYBRID;
-                chunk[i].object[j].texture_index = 0;
-                break;
-            /* Small desk. */
-            case 9:
-                chunk[i].object[j].src.x = 245;
-                chunk[i].object[j].src.y = 142;
-                chunk[i].object[j].src.w = 64;
-                chunk[i].object[j].src.h = 64;
-                chunk[i].object[j].center_y = 0;
-                chunk[i].object[j].nb_frames = 1;
-                chunk[i].object[j].render_mode = ENG_RENDER_HYBRID;
-                chunk[i].object[j].texture_index = 0;
-                break;
-            /* Stove top. */
-            case 10:
-                chunk[i].object[j].src.x = 246;
-                chunk[i].object[j].src.y = 211;
-                chunk[i].object[j].src.w = 64;
-                chunk[i].object[j].src.h = 79;
-                chunk[i].object[j].center_y = 0;
-                chunk[i].object[j].nb_frames = 1;
-                chunk[i].object[j].render_mode = ENG_RENDER_HYBRID;
-                chunk[i].object[j].texture_index = 0;
-                break;
-            }
+            get_object_properties (chunk[i].object[j].id, &chunk[i].object[j],
+                                   &footprint);
         }
     }
 }
 
+/*
+ * Registers the collision footprints of the objects of the object sheet. The
+ * footprints cover the base of the objects, so characters can walk behind
+ * the top of trees and signs. Door mats and wheat have no collision.
+ */
+void
+object_register_footprints (void)
+{
+    EngObject object = eng_object_create_object (0, 0, 0);
+    SDL_Rect footprint;
+
+    for (int id = 0; id < OBJECT_NB_IDS; id++) {
+        if (get_object_properties (id, &object, &footprint))
+            eng_object_register_footprint (id, footprint);
+    }
+}
+
+/*
+ * Gives an object the properties linked to its id, and returns the collision
+ * footprint of the objects of that id next to them.
+ */
+static bool
+get_object_properties (int id, EngObject *object, SDL_Rect *footprint)
+{
+    footprint->x = 0;
+    footprint->y = 0;
+    footprint->w = 0;
+    footprint->h = 0;
+
+    switch (id) {
+    /* Sign. */
+    case 0:
+        object->src.x = 0;
+        object->src.y = 0;
+        object->src.w = 40;
+        object->src.h = 42;
+        object->center_y = 40;
+        object->nb_frames = 1;
+        object->render_mode = ENG_RENDER_HYBRID;
+        object->texture_index = 0;
+        footprint->x = 6;
+        footprint->y = -10;
+        footprint->w = 28;
+        footprint->h = 12;
+        break;
+    /* Red tree. */
+    case 1:
+        object->src.x = 54;
+        object->src.y = 0;
+        object->src.w = 180;
+        object->src.h = 190;
+        object->center_y = 150;
+        object->nb_frames = 1;
+        object->render_mode = ENG_RENDER_HYBRID;
+        object->texture_index = 0;
+        footprint->x = 70;
+        footprint->y = 0;
+        footprint->w = 40;
+        footprint->h = 30;
+        break;
+    /* Small desk with apple. */
+    case 2:
+        object->src.x = 246;
+        object->src.y = 0;
+        object->src.w = 64;
+        object->src.h = 64;
+        object->center_y = 0;
+        object->nb_frames = 1;
+        object->render_mode = ENG_RENDER_HYBRID;
+        object->texture_index = 0;
+        footprint->x = 0;
+        footprint->y = 16;
+        footprint->w = 64;
+        footprint->h = 48;
+        break;
+    /* Yellow bed. */
+    case 3:
+        object->src.x = 334;
+        object->src.y = 0;
+        object->src.w = 64;
+        object->src.h = 128;
+        object->center_y = 0;
+        object->nb_frames = 1;
+        object->render_mode = ENG_RENDER_HYBRID;
+        object->texture_index = 0;
+        footprint->x = 0;
+        footprint->y = 8;
+        footprint->w = 64;
+        footprint->h = 120;
+        break;
+    /* Door mat. */
+    case 4:
+        object->src.x = 245;
+        object->src.y = 83;
+        object->src.w = 68;
+        object->src.h = 37;
+        object->center_y = 0;
+        object->nb_frames = 1;
+        object->render_mode = ENG_RENDER_BACKGROUND;
+        object->texture_index = 0;
+        break;
+    /* Wheat. */
+    case 5:
+        object->src.x = 494;
+        object->src.y = 0;
+        object->src.w = 66;
+        object->src.h = 89;
+        object->center_y = 82;
+        object->nb_frames = 2;
+        object->render_mode = ENG_RENDER_HYBRID;
+        object->texture_index = 0;
+        break;
+    /* Blue bed. */
+    case 6:
+        object->src.x = 408;
+        object->src.y = 0;
+        object->src.w = 64;
+        object->src.h = 128;
+        object->center_y = 0;
+        object->nb_frames = 1;
+        object->render_mode = ENG_RENDER_HYBRID;
+        object->texture_index = 0;
+        footprint->x = 0;
+        footprint->y = 8;
+        footprint->w = 64;
+        footprint->h = 120;
+        break;
+    /* Green bed. */
+    case 7:
+        object->src.x = 334;
+        object->src.y = 135;
+        object->src.w = 64;
+        object->src.h = 128;
+        object->center_y = 0;
+        object->nb_frames = 1;
+        object->render_mode = ENG_RENDER_HYBRID;
+        object->texture_index = 0;
+        footprint->x = 0;
+        footprint->y = 8;
+        footprint->w = 64;
+        footprint->h = 120;
+        break;
+    /* Red bed. */
+    case 8:
+        object->src.x = 408;
+        object->src.y = 135;
+        object->src.w = 64;
+        object->src.h = 128;
+        object->center_y = 0;
+        object->nb_frames = 1;
+        object->render_mode = ENG_RENDER_HYBRID;
+        object->texture_index = 0;
+        footprint->x = 0;
+        footprint->y = 8;
+        footprint->w = 64;
+        footprint->h = 120;
+        break;
+    /* Small desk. */
+    case 9:
+        object->src.x = 245;
+        object->src.y = 142;
+        object->src.w = 64;
+        object->src.h = 64;
+        object->center_y = 0;
+        object->nb_frames = 1;
+        object->render_mode = ENG_RENDER_HYBRID;
+        object->texture_index = 0;
+        footprint->x = 0;
+        footprint->y = 16;
+        footprint->w = 64;
+        footprint->h = 48;
+        break;
+    /* Stove top. */
+    case 10:
+        object->src.x = 246;
+        object->src.y = 211;
+        object->src.w = 64;
+        object->src.h = 79;
+        object->center_y = 0;
+        object->nb_frames = 1;
+        object->render_mode = ENG_RENDER_HYBRID;
+        object->texture_index = 0;
+        footprint->x = 0;
+        footprint->y = 16;
+        footprint->w = 64;
+        footprint->h = 63;
+        break;
+    default:
+        return false;
+    }
+
+    return true;
+}
+
 /* Handles changes and updates objects on the map. */
 void
 object_handler (EngChunk chunk[], double *timer)
@@ -1,5 +1,5 @@
-#ifndef OBJECTS_H_INCLUDED
-#define OBJECTS_H_INCLUDED
+#ifndef DEMO_OBJECTS_H_INCLUDED
+#define DEMO_OBJECTS_H_INCLUDED
 
 /**
  * @brief Returns a sprite sheet texture that contains the graphics of all the
@@ -29,6 +29,13 @@ SDL_Texture * tile_get_texture (SDL_Renderer *renderer);
  */
 void object_assign_properties (EngChunk chunk[]);
 
+/**
+ * @brief Registers the collision footprints of the objects of the object
+ *        sheet, defined with the other properties of their id. Must be
+ *        called before the chunks are loaded.
+ */
+void object_register_footprints (void);
+
 /**
  * @brief Handles changes and updates objects on the map.
  *
@@ -37,4 +44,4 @@ void object_assign_properties (EngChunk chunk[]);
  */
 void object_handler (EngChunk chunk[], double *timer);
 
-#endif /* OBJECTS_H_INCLUDED */
+#endif /* DEMO_OBJECTS_H_INCLUDED */
@@ -0,0 +1,167 @@
+/*===========================================================================*/
+/* File: bench_chunk_storage.cpp                                             */
+/* Author: YOAN BERNATCHEZ                                                   */
+/* Created On: 2026-10-16                                                    */
+/* Developed Using: SDL2                                                     */
+/* Function: Measures the size on disk and the load time of the text and     */
+/*           binary chunk formats on the Demo chunks.                        */
+/*===========================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../Engine/globals.h"
+#include "../Chunks/chunk.h"
+#include "../Chunks/chunk_binary.h"
+#include "../Chunks/chunk_parser.h"
+#include "../Chunks/tile.h"
+#include "../File_Utilities/file_utilities.h"
+#include "../Time/time.h"
+#include "benchmarks.h"
+#include "bench_chunk_storage.h"
+
+#define BENCH_NB_LOADS 20    /**< Number of times every chunk is loaded. */
+
+static void bench_text (EngPoint2d position[], int nb_chunks);
+static void bench_binary (EngPoint2d position[], int nb_chunks,
+                          int compression, const char *name);
+static void bench_memory (EngPoint2d position[], int nb_chunks);
+
+void
+bench_chunk_storage (void)
+{
+    EngPoint2d position[BENCH_MAX_CHUNKS];
+    int nb_chunks = bench_find_chunks (position);
+
+    printf ("\n> Benchmarking chunk storage on %d Demo chunk(s)...\n\n",
+            nb_chunks);
+
+    if (nb_chunks > 0) {
+        printf ("%-12s %12s %14s\n", "Format", "Disk (bytes)", "Load (us)");
+        bench_text (position, nb_chunks);
+        bench_binary (position, nb_chunks, ENG_COMPRESSION_NONE, "binary");
+        bench_binary (position, nb_chunks, ENG_COMPRESSION_AUTO, "binary rle");
+        bench_memory (position, nb_chunks);
+    }
+}
+
+/* Measures the size and the load time of the text chunk files. */
+static void
+bench_text (EngPoint2d position[], int nb_chunks)
+{
+    EngChunk chunk = eng_chunk_create_chunk ();
+    long disk_size = 0;
+    long size = 0;
+    double start = 0;
+    const char *file_name = NULL;
+
+    for (int i = 0; i < nb_chunks; i++) {
+        file_name = eng_chunk_get_file_name (position[i].x, position[i].y);
+        free (eng_file_read_file (file_name, &size));
+        free ((char*) file_name);
+        disk_size += size;
+    }
+
+    start = eng_get_precise_time ();
+
+    for (int n = 0; n < BENCH_NB_LOADS; n++) {
+        for (int i = 0; i < nb_chunks; i++) {
+            chunk.chunk_x = position[i].x;
+            chunk.chunk_y = position[i].y;
+            eng_chunk_parse_text_file (&chunk, NULL);
+            eng_chunk_destroy (&chunk);
+        }
+    }
+
+    printf ("%-12s %12ld %14.2f\n", "text", disk_size,
+            (eng_get_precise_time () - start) * 1000000 /
+            (BENCH_NB_LOADS * nb_chunks));
+}
+
+/*
+ * Measures the size and the load time of binary chunk files written with an
+ * encoding. The files are written to the temporary directory, then read and
+ * decoded the same way as eng_chunk_binary_load () does, and removed.
+ */
+static void
+bench_binary (EngPoint2d position[], int nb_chunks, int compression,
+              const char *name)
+{
+    EngChunk chunk = eng_chunk_create_chunk ();
+    long disk_size = 0;
+    long size = 0;
+    double start = 0;
+    char *buffer = NULL;
+    char temp_name[32];
+    const char *file_name[BENCH_MAX_CHUNKS];
+    FILE *file = NULL;
+
+    for (int i = 0; i < nb_chunks; i++) {
+        chunk.chunk_x = position[i].x;
+        chunk.chunk_y = position[i].y;
+        eng_chunk_parse_text_file (&chunk, NULL);
+        buffer = eng_chunk_binary_encode (&chunk, compression, &size);
+        eng_chunk_destroy (&chunk);
+
+        snprintf (temp_name, 32, "bench_chunk_%d.bin", i);
+        file_name[i] = bench_get_temp_file_name (temp_name);
+        file = fopen (file_name[i], "wb");
+
+        if (file != NULL && buffer != NULL) {
+            fwrite (buffer, 1, size, file);
+            disk_size += size;
+        }
+
+        file = eng_file_close_file (file);
+        free (buffer);
+    }
+
+    start = eng_get_precise_time ();
+
+    for (int n = 0; n < BENCH_NB_LOADS; n++) {
+        for (int i = 0; i < nb_chunks; i++) {
+            chunk.chunk_x = position[i].x;
+            chunk.chunk_y = position[i].y;
+            buffer = eng_file_read_file (file_name[i], &size);
+
+            if (buffer != NULL)
+                eng_chunk_binary_decode (&chunk, buffer, size);
+
+            free (buffer);
+            eng_chunk_destroy (&chunk);
+        }
+    }
+
+    printf ("%-12s %12ld %14.2f\n", name, disk_size,
+            (eng_get_precise_time () - start) * 1000000 /
+            (BENCH_NB_LOADS * nb_chunks));
+
+    for (int i = 0; i < nb_chunks; i++) {
+        remove (file_name[i]);
+        free ((char*) file_name[i]);
+    }
+}
+
+/*
+ * Measures the memory used by the tiles of the loaded chunks, compared to
+ * 16 bit ids for every tile.
+ */
+static void
+bench_memory (EngPoint2d position[], int nb_chunks)
+{
+    EngChunk chunk = eng_chunk_create_chunk ();
+    long memory_size = 0;
+
+    for (int i = 0; i < nb_chunks; i++) {
+        chunk.chunk_x = position[i].x;
+        chunk.chunk_y = position[i].y;
+        eng_chunk_parse_text_file (&chunk, NULL);
+        memory_size += eng_tile_get_memory_size (&chunk) +
+                       sizeof(chunk.tile_collision);
+        eng_chunk_destroy (&chunk);
+    }
+
+    printf ("\nTile memory per chunk: %ld bytes (%ld bytes without palette)\n",
+            memory_size / nb_chunks,
+            (long) (TILESX * TILESY * sizeof(int16_t) +
+                    sizeof(chunk.tile_collision)));
+}
@@ -0,0 +1,6 @@
+#ifndef BENCH_CHUNK_STORAGE_H_INCLUDED
+#define BENCH_CHUNK_STORAGE_H_INCLUDED
+
+void bench_chunk_storage (void);
+
+#endif /* BENCH_CHUNK_STORAGE_H_INCLUDED */
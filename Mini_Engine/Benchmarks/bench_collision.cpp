@@ -0,0 +1,380 @@
+/*===========================================================================*/
+/* File: bench_collision.cpp                                                 */
+/* Author: YOAN BERNATCHEZ                                                   */
+/* Created On: 2026-10-16                                                    */
+/* Developed Using: SDL2                                                     */
+/* Function: Measures the cost of the character collision against the        */
+/*           tiles and the objects of the Demo chunks.                       */
+/*===========================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../Engine/globals.h"
+#include "../Characters/character.h"
+#include "../Chunks/chunk.h"
+#include "../Chunks/objects.h"
+#include "../Chunks/tile.h"
+#include "../Collision/collision_handler.h"
+#include "../Time/time.h"
+#include "benchmarks.h"
+#include "bench_collision.h"
+
+#define BENCH_NB_QUERIES 100000 /**< Number of collision queries per case. */
+#define BENCH_NB_CASES 4        /**< Number of hit box and speed cases.    */
+#define BENCH_OBJECT_ID 1000    /**< Id of the objects added to the chunks. */
+
+/* Local structures. */
+typedef struct _BenchCase {
+    const char *name;
+    int width;
+    int height;
+    int speed;
+} BenchCase;
+/**< Size of the hit boxes and speed of the characters of a case. */
+
+static void bench_batch (EngChunk chunk[], EngCharacter character[]);
+static void bench_objects (EngChunk chunk[], EngCharacter character[]);
+static void add_objects (EngChunk chunk[], int nb_objects, bool is_clustered);
+static void create_queries (EngChunk chunk[], BenchCase bench_case,
+                            EngCharacter character[]);
+static EngCollision get_corner_collision (EngChunk chunk[],
+                                          EngCharacter character,
+                                          EngEvent event);
+static bool check_collision_on_tile (EngChunk chunk[], EngPoint2d point,
+                                     int offset_x, int offset_y);
+
+/* Keeps the queries from being removed by the compiler. */
+static volatile long bench_result = 0;
+
+/*
+ * Compares the collision of the characters tested at the corners of their
+ * hit box, as it was done before, with the swept hit box collision. Missed
+ * walls are the queries where the corners find no collision while a tile
+ * with collision is crossed.
+ */
+void
+bench_collision (void)
+{
+    static const BenchCase bench_case[BENCH_NB_CASES] = {
+        {"player", 25, 20, 3},
+        {"villager", 40, 40, 2},
+        {"wide", 3 * TILESIZE, TILESIZE / 2, 3},
+        {"fast", 25, 20, 3 * TILESIZE}
+    };
+    EngChunk chunk[NBCHUNKS];
+    EngCharacter *character = (EngCharacter*)
+                              malloc (BENCH_NB_QUERIES * sizeof(EngCharacter));
+    EngEvent event = {true, true, true, true, false};
+    EngCollision corner = {false, false, false, false};
+    EngCollision swept = {false, false, false, false};
+    double corner_time = 0;
+    double swept_time = 0;
+    double start = 0;
+    long result = 0;
+    int nb_missed = 0;
+
+    printf ("\n> Benchmarking tile collision on %d Demo chunk(s)...\n\n",
+            NBCHUNKS);
+
+    if (character == NULL || !bench_load_window (chunk, true)) {
+        free (character);
+        return;
+    }
+
+    printf ("%-10s %14s %12s %14s\n", "Case", "Corners (ns)", "Swept (ns)",
+            "Missed walls");
+
+    for (int i = 0; i < BENCH_NB_CASES; i++) {
+        create_queries (chunk, bench_case[i], character);
+
+        start = eng_get_precise_time ();
+
+        for (int j = 0; j < BENCH_NB_QUERIES; j++) {
+            corner = get_corner_collision (chunk, character[j], event);
+            result += corner.left + corner.right + corner.up + corner.down;
+        }
+
+        corner_time = eng_get_precise_time () - start;
+        start = eng_get_precise_time ();
+
+        for (int j = 0; j < BENCH_NB_QUERIES; j++) {
+            swept = eng_get_char_collision (chunk, character[j], event);
+            result -= swept.left + swept.right + swept.up + swept.down;
+        }
+
+        swept_time = eng_get_precise_time () - start;
+        nb_missed = 0;
+
+        for (int j = 0; j < BENCH_NB_QUERIES; j++) {
+            corner = get_corner_collision (chunk, character[j], event);
+            swept = eng_get_char_collision (chunk, character[j], event);
+            nb_missed += (swept.left && !corner.left) +
+                         (swept.right && !corner.right) +
+                         (swept.up && !corner.up) +
+                         (swept.down && !corner.down);
+        }
+
+        printf ("%-10s %14.1f %12.1f %14d\n", bench_case[i].name,
+                corner_time * 1000000000 / BENCH_NB_QUERIES,
+                swept_time * 1000000000 / BENCH_NB_QUERIES, nb_missed);
+    }
+
+    bench_result += result;
+    bench_batch (chunk, character);
+    bench_objects (chunk, character);
+
+    for (int i = 0; i < NBCHUNKS; i++)
+        eng_chunk_destroy (&chunk[i]);
+
+    free (character);
+}
+
+/*
+ * Compares the collision of characters resolved one at a time with the
+ * collision of all the characters resolved in one batch, for villagers
+ * walking in random directions.
+ */
+static void
+bench_batch (EngChunk chunk[], EngCharacter character[])
+{
+    static const BenchCase villager = {"villager", 40, 40, 2};
+    static const int nb_characters[3] = {100, 1000, BENCH_NB_QUERIES};
+    EngPoint2d *move = (EngPoint2d*)
+                       malloc (BENCH_NB_QUERIES * sizeof(EngPoint2d));
+    EngCollision *collision = (EngCollision*)
+                              malloc (BENCH_NB_QUERIES * sizeof(EngCollision));
+    double single_time = 0;
+    double batch_time = 0;
+    double start = 0;
+    int nb_runs = 0;
+
+    if (move == NULL || collision == NULL) {
+        free (move);
+        free (collision);
+        return;
+    }
+
+    create_queries (chunk, villager, character);
+
+    for (int i = 0; i < BENCH_NB_QUERIES; i++) {
+        move[i].x = (rand () % 3 - 1) * villager.speed;
+        move[i].y = (rand () % 3 - 1) * villager.speed;
+    }
+
+    printf ("\n%-10s %14s %12s\n", "Villagers", "Single (ns)",
+            "Batch (ns)");
+
+    for (int i = 0; i < 3; i++) {
+        nb_runs = BENCH_NB_QUERIES / nb_characters[i];
+        start = eng_get_precise_time ();
+
+        for (int n = 0; n < nb_runs; n++) {
+            for (int j = 0; j < nb_characters[i]; j++) {
+                eng_get_chars_collision (chunk, &character[j], &move[j],
+                                         &collision[j], 1);
+            }
+        }
+
+        single_time = eng_get_precise_time () - start;
+        start = eng_get_precise_time ();
+
+        for (int n = 0; n < nb_runs; n++) {
+            eng_get_chars_collision (chunk, character, move, collision,
+                                     nb_characters[i]);
+        }
+
+        batch_time = eng_get_precise_time () - start;
+
+        printf ("%-10d %14.1f %12.1f\n", nb_characters[i],
+                single_time * 1000000000 / (nb_runs * nb_characters[i]),
+                batch_time * 1000000000 / (nb_runs * nb_characters[i]));
+    }
+
+    for (int i = 0; i < BENCH_NB_QUERIES; i++)
+        bench_result += collision[i].left + collision[i].down;
+
+    free (move);
+    free (collision);
+}
+
+/*
+ * Measures the batch collision of villagers with more and more objects in
+ * every chunk. The objects are either spread over the chunks or clustered in
+ * one cell of their object grid, where few villagers are: with the object
+ * grid, the cost follows the objects near the villagers.
+ */
+static void
+bench_objects (EngChunk chunk[], EngCharacter character[])
+{
+    static const BenchCase villager = {"villager", 40, 40, 2};
+    static const int nb_objects[4] = {0, 100, 1000, 10000};
+    SDL_Rect footprint = {0, 0, 40, 30};
+    EngPoint2d *move = (EngPoint2d*)
+                       malloc (BENCH_NB_QUERIES * sizeof(EngPoint2d));
+    EngCollision *collision = (EngCollision*)
+                              malloc (BENCH_NB_QUERIES * sizeof(EngCollision));
+    double time[2] = {0, 0};
+    double start = 0;
+
+    if (move == NULL || collision == NULL) {
+        free (move);
+        free (collision);
+        return;
+    }
+
+    eng_object_register_footprint (BENCH_OBJECT_ID, footprint);
+    create_queries (chunk, villager, character);
+
+    for (int i = 0; i < BENCH_NB_QUERIES; i++) {
+        move[i].x = (rand () % 3 - 1) * villager.speed;
+        move[i].y = (rand () % 3 - 1) * villager.speed;
+    }
+
+    /* The first run only brings the characters in the caches. */
+    eng_get_chars_collision (chunk, character, move, collision,
+                             BENCH_NB_QUERIES);
+
+    printf ("\n%-10s %14s %15s\n", "Objects", "Spread (ns)",
+            "Clustered (ns)");
+
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 2; j++) {
+            add_objects (chunk, nb_objects[i], j == 1);
+            start = eng_get_precise_time ();
+            eng_get_chars_collision (chunk, character, move, collision,
+                                     BENCH_NB_QUERIES);
+            time[j] = eng_get_precise_time () - start;
+        }
+
+        printf ("%-10d %14.1f %15.1f\n", nb_objects[i] * NBCHUNKS,
+                time[0] * 1000000000 / BENCH_NB_QUERIES,
+                time[1] * 1000000000 / BENCH_NB_QUERIES);
+    }
+
+    for (int i = 0; i < BENCH_NB_QUERIES; i++)
+        bench_result += collision[i].left + collision[i].down;
+
+    eng_object_clear_footprints ();
+    free (move);
+    free (collision);
+}
+
+/*
+ * Replaces the objects of every chunk by objects with a footprint, placed at
+ * random over the chunk or in its first cell of the object grid.
+ */
+static void
+add_objects (EngChunk chunk[], int nb_objects, bool is_clustered)
+{
+    int range_x = is_clustered ? ENG_OBJECT_CELL_SIZE - 40 :
+                                 TILESX * TILESIZE - 40;
+    int range_y = is_clustered ? ENG_OBJECT_CELL_SIZE - 30 :
+                                 TILESY * TILESIZE - 30;
+
+    srand (0);
+
+    for (int i = 0; i < NBCHUNKS; i++) {
+        eng_object_allocate (&chunk[i], nb_objects);
+
+        for (int j = 0; j < nb_objects; j++) {
+            chunk[i].object[j] =
+            eng_object_create_object (BENCH_OBJECT_ID, rand () % range_x,
+                                      rand () % range_y);
+        }
+
+        eng_object_build_grid (&chunk[i]);
+    }
+}
+
+/*
+ * Places characters of a case on random walkable tiles of the chunk window,
+ * the same positions being used for every run.
+ */
+static void
+create_queries (EngChunk chunk[], BenchCase bench_case,
+                EngCharacter character[])
+{
+    int min_x = (-CHUNKSX / 2) * TILESX * TILESIZE;
+    int min_y = (-CHUNKSY / 2) * TILESY * TILESIZE;
+    int x = 0;
+    int y = 0;
+    EngChunk *curr_chunk = NULL;
+
+    srand (0);
+
+    for (int i = 0; i < BENCH_NB_QUERIES; i++) {
+        do {
+            x = min_x + rand () % (CHUNKSX * TILESX * TILESIZE);
+            y = min_y + rand () % (CHUNKSY * TILESY * TILESIZE);
+            curr_chunk = eng_chunk_get_chunk (chunk, eng_char_get_chunk_x (x),
+                                              eng_char_get_chunk_y (y));
+        } while (eng_tile_has_collision (curr_chunk, eng_char_get_tile_x (x),
+                                         eng_char_get_tile_y (y)));
+
+        character[i] = eng_char_create_character (0, 0, 0, 0, 50, 75,
+                                                  bench_case.width,
+                                                  bench_case.height, true);
+        character[i].hitbox.x = x;
+        character[i].hitbox.y = y;
+        character[i].speed = bench_case.speed;
+    }
+}
+
+/*
+ * Returns the collision of a character by testing the tiles under the two
+ * corners of its hit box on each side, the way eng_get_char_collision did
+ * before the hit box was swept.
+ */
+static EngCollision
+get_corner_collision (EngChunk chunk[], EngCharacter character,
+                      EngEvent event)
+{
+    EngCollision collision = {false, false, false, false};
+    EngPoint2d top_left = {character.hitbox.x, character.hitbox.y};
+    EngPoint2d top_right = {character.hitbox.x + character.hitbox.w,
+                            character.hitbox.y};
+    EngPoint2d bottom_left = {character.hitbox.x, character.hitbox.y +
+                              character.hitbox.h};
+    EngPoint2d bottom_right = {character.hitbox.x + character.hitbox.w,
+                               character.hitbox.y + character.hitbox.h};
+    int speed = character.speed;
+
+    if (event.left_pressed) {
+        collision.left = check_collision_on_tile (chunk, top_left, -speed, 0) ||
+                         check_collision_on_tile (chunk, bottom_left, -speed,
+                                                  0);
+    }
+    if (event.right_pressed) {
+        collision.right = check_collision_on_tile (chunk, top_right, speed,
+                                                   0) ||
+                          check_collision_on_tile (chunk, bottom_right, speed,
+                                                   0);
+    }
+    if (event.up_pressed) {
+        collision.up = check_collision_on_tile (chunk, top_left, 0, -speed) ||
+                       check_collision_on_tile (chunk, top_right, 0, -speed);
+    }
+    if (event.down_pressed) {
+        collision.down = check_collision_on_tile (chunk, bottom_left, 0,
+                                                  speed) ||
+                         check_collision_on_tile (chunk, bottom_right, 0,
+                                                  speed);
+    }
+
+    return collision;
+}
+
+/* Checks if a point moved by an offset ends up on a tile with collision. */
+static bool
+check_collision_on_tile (EngChunk chunk[], EngPoint2d point, int offset_x,
+                         int offset_y)
+{
+    EngChunk *curr_chunk =
+    eng_chunk_get_chunk (chunk, eng_char_get_chunk_x (point.x + offset_x),
+                         eng_char_get_chunk_y (point.y + offset_y));
+
+    return curr_chunk == NULL ||
+           eng_tile_has_collision (curr_chunk,
+                                   eng_char_get_tile_x (point.x + offset_x),
+                                   eng_char_get_tile_y (point.y + offset_y));
+}
@@ -0,0 +1,6 @@
+#ifndef BENCH_COLLISION_H_INCLUDED
+#define BENCH_COLLISION_H_INCLUDED
+
+void bench_collision (void);
+
+#endif /* BENCH_COLLISION_H_INCLUDED */
@@ -0,0 +1,242 @@
+/*===========================================================================*/
+/* File: bench_pathfinding.cpp                                               */
+/* Author: YOAN BERNATCHEZ                                                   */
+/* Created On: 2026-10-16                                                    */
+/* Developed Using: SDL2                                                     */
+/* Function: Measures the cost of the path searches and flow fields on       */
+/*           the tiles of the Demo chunks.                                   */
+/*===========================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../Engine/globals.h"
+#include "../Chunks/chunk.h"
+#include "../Chunks/clearance.h"
+#include "../Chunks/pathfinding.h"
+#include "../Chunks/tile.h"
+#include "../Time/time.h"
+#include "benchmarks.h"
+#include "bench_pathfinding.h"
+
+#define BENCH_NB_PATHS 200 /**< Number of paths searched per case. */
+
+#define BENCH_NB_METHODS 3  /**< Number of path search methods measured. */
+#define BENCH_NEAR_RANGE 8  /**< Largest distance of the near paths. */
+#define BENCH_GOAL_X (35 + TILESX * (CHUNKSX / 2)) /**< Village tile in x. */
+#define BENCH_GOAL_Y (10 + TILESY * (CHUNKSY / 2)) /**< Village tile in y. */
+
+/* Local structures. */
+typedef struct _BenchPath {
+    EngPoint2d start;
+    EngPoint2d end;
+} BenchPath;
+/**< Starting and ending tiles of a path, relative to the chunk window. */
+
+typedef struct _BenchMethod {
+    const char *name;
+    const EngPath * (*find_path) (EngPathContext *context, EngChunk chunk[],
+                                  int starting_tile_x, int starting_tile_y,
+                                  int ending_tile_x, int ending_tile_y,
+                                  int clearance);
+} BenchMethod;
+/**< Path search method measured. */
+
+static void create_paths (BenchPath path[], int range);
+static void bench_case (EngChunk chunk[], const char *name, int range);
+static void bench_goal (EngChunk chunk[], const char *name);
+
+/* Keeps the searches from being removed by the compiler. */
+static volatile long bench_result = 0;
+
+/*
+ * Measures the time taken and the number of tiles expanded to find paths
+ * between random free tiles of the chunk window, in the Demo chunks and in a
+ * window without walls, where a breadth-first search spreads over the whole
+ * window. Characters heading to the same goal in the window without walls are
+ * measured with a search per character and with a shared flow field.
+ */
+void
+bench_pathfinding (void)
+{
+    EngChunk chunk[NBCHUNKS];
+
+    printf ("\n> Benchmarking pathfinding on %d Demo chunk(s)...\n\n",
+            NBCHUNKS);
+    printf ("%-10s %-8s %12s %12s %8s\n", "Window", "Method", "Path (us)",
+            "Expanded", "Found");
+
+    if (bench_load_window (chunk, true)) {
+        bench_case (chunk, "demo", 0);
+        bench_case (chunk, "near", BENCH_NEAR_RANGE);
+    }
+
+    for (int i = 0; i < NBCHUNKS; i++)
+        eng_chunk_destroy (&chunk[i]);
+
+    bench_load_window (chunk, false);
+    bench_case (chunk, "open", 0);
+    bench_goal (chunk, "goal");
+
+    for (int i = 0; i < NBCHUNKS; i++)
+        eng_chunk_destroy (&chunk[i]);
+}
+
+/*
+ * Picks random starting and ending tiles without collision, the ending tiles
+ * at most range tiles away in x and y from the starting tiles (anywhere if
+ * range is 0).
+ */
+static void
+create_paths (BenchPath path[], int range)
+{
+    EngPoint2d *point = NULL;
+
+    srand (21);
+
+    for (int i = 0; i < BENCH_NB_PATHS * 2; i++) {
+        point = i % 2 == 0 ? &path[i / 2].start : &path[i / 2].end;
+
+        do {
+            point->x = rand () % (TILESX * CHUNKSX);
+            point->y = rand () % (TILESY * CHUNKSY);
+
+            if (i % 2 == 1 && range > 0) {
+                point->x = path[i / 2].start.x + rand () % (2 * range + 1) -
+                           range;
+                point->y = path[i / 2].start.y + rand () % (2 * range + 1) -
+                           range;
+            }
+        } while (eng_clearance_get_window_tile (point->x, point->y) == 0);
+    }
+}
+
+/*
+ * Searches the paths of a case with every method and prints the time taken
+ * and the number of tiles expanded per path.
+ */
+static void
+bench_case (EngChunk chunk[], const char *name, int range)
+{
+    static const BenchMethod bench_method[BENCH_NB_METHODS] = {
+        {"bfs", eng_pathfind_find_path},
+        {"astar", eng_pathfind_find_path_astar},
+        {"jump", eng_pathfind_find_path_jump}
+    };
+    BenchPath path[BENCH_NB_PATHS];
+    EngPathContext *context = eng_pathfind_create_context ();
+    const EngPath *found = NULL;
+    double start = 0;
+    double time = 0;
+    long nb_expanded = 0;
+    int nb_found = 0;
+
+    if (context == NULL)
+        return;
+
+    eng_clearance_update_window (chunk);
+    create_paths (path, range);
+
+    for (int i = 0; i < BENCH_NB_METHODS; i++) {
+        nb_expanded = 0;
+        nb_found = 0;
+        start = eng_get_precise_time ();
+
+        for (int j = 0; j < BENCH_NB_PATHS; j++) {
+            found = bench_method[i].find_path (context, chunk,
+                                               path[j].start.x,
+                                               path[j].start.y, path[j].end.x,
+                                               path[j].end.y, 1);
+            nb_expanded += context->nb_expanded;
+
+            if (found != NULL) {
+                nb_found++;
+                bench_result += found->nb_steps;
+            }
+        }
+
+        time = eng_get_precise_time () - start;
+
+        printf ("%-10s %-8s %12.1f %12ld %8d\n", name, bench_method[i].name,
+                time * 1000000 / BENCH_NB_PATHS,
+                nb_expanded / BENCH_NB_PATHS, nb_found);
+    }
+
+    eng_pathfind_destroy_context (&context);
+}
+
+/*
+ * Moves characters from random free tiles to the village tile the Demo NPC
+ * walks to, searching a path for each character or reading the direction of
+ * each step from the flow field of the village tile, and prints the time
+ * taken per character. The flow field is requested at every step, as a
+ * character would, so the time includes the cache lookups and the field
+ * computed once. Only the tiles around the village reach it in the Demo, so
+ * the window without walls is used.
+ */
+static void
+bench_goal (EngChunk chunk[], const char *name)
+{
+    BenchPath path[BENCH_NB_PATHS];
+    EngPathContext *context = eng_pathfind_create_context ();
+    const EngFlowField *field = NULL;
+    const EngPath *found = NULL;
+    double start = 0;
+    double time = 0;
+    int direction = 0;
+    int nb_found = 0;
+    int x = 0;
+    int y = 0;
+
+    if (context == NULL)
+        return;
+
+    eng_clearance_update_window (chunk);
+
+    if (eng_clearance_get_window_tile (BENCH_GOAL_X, BENCH_GOAL_Y) == 0) {
+        eng_pathfind_destroy_context (&context);
+        return;
+    }
+
+    create_paths (path, 0);
+    start = eng_get_precise_time ();
+
+    for (int i = 0; i < BENCH_NB_PATHS; i++) {
+        found = eng_pathfind_find_path (context, chunk, path[i].start.x,
+                                        path[i].start.y, BENCH_GOAL_X,
+                                        BENCH_GOAL_Y, 1);
+
+        for (int j = 0; found != NULL && j < found->nb_steps; j++)
+            bench_result += found->direction[j];
+
+        nb_found += found != NULL;
+    }
+
+    time = eng_get_precise_time () - start;
+    printf ("%-10s %-8s %12.1f %12s %8d\n", name, "bfs",
+            time * 1000000 / BENCH_NB_PATHS, "-", nb_found);
+
+    nb_found = 0;
+    start = eng_get_precise_time ();
+
+    for (int i = 0; i < BENCH_NB_PATHS; i++) {
+        x = path[i].start.x;
+        y = path[i].start.y;
+
+        do {
+            field = eng_pathfind_get_flow_field (chunk, BENCH_GOAL_X,
+                                                 BENCH_GOAL_Y, 1);
+            direction = eng_pathfind_get_flow_direction (field, x, y);
+            x += direction == ENG_RIGHT ? 1 : direction == ENG_LEFT ? -1 : 0;
+            y += direction == ENG_DOWN ? 1 : direction == ENG_UP ? -1 : 0;
+            bench_result += direction;
+        } while (direction != -1);
+
+        nb_found += x == BENCH_GOAL_X && y == BENCH_GOAL_Y;
+    }
+
+    time = eng_get_precise_time () - start;
+    printf ("%-10s %-8s %12.1f %12s %8d\n", name, "flow",
+            time * 1000000 / BENCH_NB_PATHS, "-", nb_found);
+
+    eng_pathfind_destroy_context (&context);
+}
@@ -0,0 +1,6 @@
+#ifndef BENCH_PATHFINDING_H_INCLUDED
+#define BENCH_PATHFINDING_H_INCLUDED
+
+void bench_pathfinding (void);
+
+#endif /* BENCH_PATHFINDING_H_INCLUDED */
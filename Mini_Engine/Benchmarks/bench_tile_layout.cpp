@@ -0,0 +1,322 @@
+/*===========================================================================*/
+/* File: bench_tile_layout.cpp                                               */
+/* Author: YOAN BERNATCHEZ                                                   */
+/* Created On: 2026-10-16                                                    */
+/* Developed Using: SDL2                                                     */
+/* Function: Measures the cost of tile accesses with the row and Morton      */
+/*           tile layouts on the Demo chunks.                                */
+/*===========================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "../Engine/globals.h"
+#include "../Chunks/chunk.h"
+#include "../Chunks/chunk_parser.h"
+#include "../Chunks/tile.h"
+#include "../Time/time.h"
+#include "benchmarks.h"
+#include "bench_tile_layout.h"
+
+#define BENCH_NB_REPEATS 20  /**< Number of times every workload is run. */
+#define BENCH_NB_PROBES 4096 /**< Number of collision probes per chunk. */
+
+/** Enumeration of the tile layouts compared. */
+enum BenchLayout {BENCH_ROW, BENCH_COLUMN, BENCH_MORTON, BENCH_NB_LAYOUTS};
+
+/* Local structures. */
+typedef struct _BenchChunk {
+    int16_t *id;
+    uint8_t *is_solid;
+} BenchChunk;
+/**< Tile ids and collision of a chunk, stored in one of the layouts. */
+
+static int get_side (void);
+static int get_index (int layout, int side, int x, int y);
+static bool load_chunks (EngPoint2d position[], int nb_chunks, int side,
+                         BenchChunk chunk[][BENCH_NB_LAYOUTS]);
+static double bench_render (BenchChunk chunk[][BENCH_NB_LAYOUTS],
+                            int nb_chunks, int layout, int side);
+static double bench_collision (BenchChunk chunk[][BENCH_NB_LAYOUTS],
+                               int nb_chunks, int layout, int side,
+                               EngPoint2d probe[]);
+static double bench_bfs (BenchChunk chunk[][BENCH_NB_LAYOUTS], int nb_chunks,
+                         int layout, int side);
+
+/* Keeps the workloads from being removed by the compiler. */
+static volatile long bench_result = 0;
+
+/*
+ * Compares the row by row, column by column and Morton (Z curve) tile layouts
+ * on the tile accesses of the render, collision and pathfinding loops.
+ */
+void
+bench_tile_layout (void)
+{
+    static const char *layout_name[BENCH_NB_LAYOUTS] = {"row-major",
+                                                        "column-major",
+                                                        "morton"};
+    EngPoint2d position[BENCH_MAX_CHUNKS];
+    EngPoint2d probe[BENCH_NB_PROBES];
+    BenchChunk (*chunk)[BENCH_NB_LAYOUTS] = NULL;
+    int nb_chunks = bench_find_chunks (position);
+    int side = get_side ();
+
+    printf ("\n> Benchmarking tile layouts on %d Demo chunk(s)...\n\n",
+            nb_chunks);
+
+    chunk = (BenchChunk (*)[BENCH_NB_LAYOUTS])
+            calloc (nb_chunks + 1, sizeof(*chunk));
+
+    if (nb_chunks == 0 || chunk == NULL ||
+        !load_chunks (position, nb_chunks, side, chunk)) {
+        free (chunk);
+        return;
+    }
+
+    /* The same probes are used for every layout. */
+    srand (0);
+
+    for (int i = 0; i < BENCH_NB_PROBES; i++) {
+        probe[i].x = 1 + rand () % (TILESX - 2);
+        probe[i].y = 1 + rand () % (TILESY - 2);
+    }
+
+    printf ("%-13s %12s %15s %10s\n", "Layout", "Render (us)",
+            "Collision (us)", "BFS (us)");
+
+    for (int layout = 0; layout < BENCH_NB_LAYOUTS; layout++) {
+        printf ("%-13s %12.2f %15.2f %10.2f\n", layout_name[layout],
+                bench_render (chunk, nb_chunks, layout, side),
+                bench_collision (chunk, nb_chunks, layout, side, probe),
+                bench_bfs (chunk, nb_chunks, layout, side));
+    }
+
+    for (int i = 0; i < nb_chunks; i++) {
+        for (int layout = 0; layout < BENCH_NB_LAYOUTS; layout++) {
+            free (chunk[i][layout].id);
+            free (chunk[i][layout].is_solid);
+        }
+    }
+
+    free (chunk);
+}
+
+/*
+ * Returns the side of the smallest square holding a chunk whose side is a
+ * power of two, as the Morton layout requires.
+ */
+static int
+get_side (void)
+{
+    int side = 1;
+
+    while (side < TILESX || side < TILESY)
+        side *= 2;
+
+    return side;
+}
+
+/* Returns the position of a tile in one of the layouts. */
+static int
+get_index (int layout, int side, int x, int y)
+{
+    switch (layout) {
+    case BENCH_COLUMN:
+        return x * side + y;
+    case BENCH_MORTON:
+        return eng_tile_get_morton_index (x, y);
+    default:
+        return y * side + x;
+    }
+}
+
+/*
+ * Loads the Demo chunks and copies their tile ids and collision in every
+ * layout. The walls are the same as in the Demo.
+ */
+static bool
+load_chunks (EngPoint2d position[], int nb_chunks, int side,
+             BenchChunk chunk[][BENCH_NB_LAYOUTS])
+{
+    EngChunk engine_chunk = eng_chunk_create_chunk ();
+    int index = 0;
+
+    bench_register_demo_walls ();
+
+    for (int i = 0; i < nb_chunks; i++) {
+        engine_chunk.chunk_x = position[i].x;
+        engine_chunk.chunk_y = position[i].y;
+        eng_chunk_parse_text_file (&engine_chunk, NULL);
+
+        for (int layout = 0; layout < BENCH_NB_LAYOUTS; layout++) {
+            chunk[i][layout].id = (int16_t*)
+                                  calloc (side * side, sizeof(int16_t));
+            chunk[i][layout].is_solid = (uint8_t*) calloc (side * side, 1);
+
+            if (chunk[i][layout].id == NULL ||
+                chunk[i][layout].is_solid == NULL) {
+                eng_chunk_destroy (&engine_chunk);
+                eng_tile_clear_properties ();
+                return false;
+            }
+
+            for (int y = 0; y < TILESY; y++) {
+                for (int x = 0; x < TILESX; x++) {
+                    index = get_index (layout, side, x, y);
+                    chunk[i][layout].id[index] =
+                    eng_tile_get_id (&engine_chunk, x, y);
+                    chunk[i][layout].is_solid[index] =
+                    eng_tile_has_collision (&engine_chunk, x, y);
+                }
+            }
+        }
+
+        eng_chunk_destroy (&engine_chunk);
+    }
+
+    eng_tile_clear_properties ();
+
+    return true;
+}
+
+/*
+ * Measures the render loop, which reads the id of every tile row by row to
+ * find its source rectangle in the tile sheet.
+ */
+static double
+bench_render (BenchChunk chunk[][BENCH_NB_LAYOUTS], int nb_chunks, int layout,
+              int side)
+{
+    double start = eng_get_precise_time ();
+    long result = 0;
+    int id = 0;
+
+    for (int n = 0; n < BENCH_NB_REPEATS; n++) {
+        for (int i = 0; i < nb_chunks; i++) {
+            for (int y = 0; y < TILESY; y++) {
+                for (int x = 0; x < TILESX; x++) {
+                    id = chunk[i][layout].id[get_index (layout, side, x, y)];
+                    result += id % 10 + id / 10;
+                }
+            }
+        }
+    }
+
+    bench_result += result;
+
+    return (eng_get_precise_time () - start) * 1000000 /
+           (BENCH_NB_REPEATS * nb_chunks);
+}
+
+/*
+ * Measures the collision probes, which read the collision of the four tiles
+ * around a point.
+ */
+static double
+bench_collision (BenchChunk chunk[][BENCH_NB_LAYOUTS], int nb_chunks,
+                 int layout, int side, EngPoint2d probe[])
+{
+    double start = eng_get_precise_time ();
+    const uint8_t *is_solid = NULL;
+    long result = 0;
+    int x = 0;
+    int y = 0;
+
+    for (int n = 0; n < BENCH_NB_REPEATS; n++) {
+        for (int i = 0; i < nb_chunks; i++) {
+            is_solid = chunk[i][layout].is_solid;
+
+            for (int j = 0; j < BENCH_NB_PROBES; j++) {
+                x = probe[j].x;
+                y = probe[j].y;
+                result += is_solid[get_index (layout, side, x - 1, y)] +
+                          is_solid[get_index (layout, side, x + 1, y)] +
+                          is_solid[get_index (layout, side, x, y - 1)] +
+                          is_solid[get_index (layout, side, x, y + 1)];
+            }
+        }
+    }
+
+    bench_result += result;
+
+    return (eng_get_precise_time () - start) * 1000000 /
+           (BENCH_NB_REPEATS * nb_chunks);
+}
+
+/*
+ * Measures a breadth first search over the walkable tiles of a chunk, from
+ * its first walkable tile, like the pathfinding wave.
+ */
+static double
+bench_bfs (BenchChunk chunk[][BENCH_NB_LAYOUTS], int nb_chunks, int layout,
+           int side)
+{
+    static const int offset_x[4] = {1, -1, 0, 0};
+    static const int offset_y[4] = {0, 0, 1, -1};
+    EngPoint2d *queue = (EngPoint2d*) malloc (TILESX * TILESY *
+                                              sizeof(EngPoint2d));
+    uint8_t *is_visited = (uint8_t*) malloc (side * side);
+    const uint8_t *is_solid = NULL;
+    double start = eng_get_precise_time ();
+    double duration = 0;
+    long result = 0;
+    int first = 0;
+    int last = 0;
+    int x = 0;
+    int y = 0;
+
+    if (queue == NULL || is_visited == NULL) {
+        free (queue);
+        free (is_visited);
+        return 0;
+    }
+
+    for (int n = 0; n < BENCH_NB_REPEATS; n++) {
+        for (int i = 0; i < nb_chunks; i++) {
+            is_solid = chunk[i][layout].is_solid;
+            memcpy (is_visited, is_solid, side * side);
+            first = 0;
+            last = 0;
+
+            for (int j = 0; j < TILESX * TILESY && last == 0; j++) {
+                x = j % TILESX;
+                y = j / TILESX;
+
+                if (!is_visited[get_index (layout, side, x, y)]) {
+                    is_visited[get_index (layout, side, x, y)] = true;
+                    queue[last].x = x;
+                    queue[last++].y = y;
+                }
+            }
+
+            while (first < last) {
+                for (int d = 0; d < 4; d++) {
+                    x = queue[first].x + offset_x[d];
+                    y = queue[first].y + offset_y[d];
+
+                    if (x >= 0 && x < TILESX && y >= 0 && y < TILESY &&
+                        !is_visited[get_index (layout, side, x, y)]) {
+                        is_visited[get_index (layout, side, x, y)] = true;
+                        queue[last].x = x;
+                        queue[last++].y = y;
+                    }
+                }
+
+                first++;
+            }
+
+            result += last;
+        }
+    }
+
+    bench_result += result;
+    duration = (eng_get_precise_time () - start) * 1000000 /
+               (BENCH_NB_REPEATS * nb_chunks);
+
+    free (queue);
+    free (is_visited);
+
+    return duration;
+}
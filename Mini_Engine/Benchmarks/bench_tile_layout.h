@@ -0,0 +1,6 @@
+#ifndef BENCH_TILE_LAYOUT_H_INCLUDED
+#define BENCH_TILE_LAYOUT_H_INCLUDED
+
+void bench_tile_layout (void);
+
+#endif /* BENCH_TILE_LAYOUT_H_INCLUDED */
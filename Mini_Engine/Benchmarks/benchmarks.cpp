@@ -0,0 +1,147 @@
+/*===========================================================================*/
+/* File: benchmarks.cpp                                                      */
+/* Author: YOAN BERNATCHEZ                                                   */
+/* Created On: 2026-10-16                                                    */
+/* Developed Using: SDL2                                                     */
+/* Function: This file manages all the benchmarks measuring the cost of the  */
+/*           engine functions on the Demo data.                              */
+/*===========================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../Chunks/chunk.h"
+#include "../Chunks/chunk_parser.h"
+#include "../Chunks/tile.h"
+#include "../File_Utilities/file_utilities.h"
+#include "benchmarks.h"
+#include "bench_chunk_storage.h"
+#include "bench_collision.h"
+#include "bench_pathfinding.h"
+#include "bench_tile_layout.h"
+
+/*
+ * This function calls all the other benchmark functions. Benchmarks must be
+ * run from the root of the project, where the Demo directory is located.
+ */
+void
+eng_bench_all (void)
+{
+    printf ("!---- ENGINE BENCHMARKS BEGIN ----!\n");
+
+    bench_chunk_storage ();
+    bench_tile_layout ();
+    bench_collision ();
+    bench_pathfinding ();
+
+    printf ("\n!---- ENGINE BENCHMARKS END ----!\n");
+}
+
+/*
+ * Lists the chunks of the Demo which have a text chunk file, up to
+ * BENCH_MAX_CHUNKS chunks.
+ */
+int
+bench_find_chunks (EngPoint2d position[])
+{
+    int nb_chunks = 0;
+    const char *file_name = NULL;
+    FILE *file = NULL;
+
+    for (int y = -BENCH_CHUNK_RANGE; y <= BENCH_CHUNK_RANGE; y++) {
+        for (int x = -BENCH_CHUNK_RANGE; x <= BENCH_CHUNK_RANGE; x++) {
+            file_name = eng_chunk_get_file_name (x, y);
+            file = fopen (file_name, "r");
+
+            if (file != NULL && nb_chunks < BENCH_MAX_CHUNKS) {
+                position[nb_chunks].x = x;
+                position[nb_chunks].y = y;
+                nb_chunks++;
+            }
+
+            file = eng_file_close_file (file);
+            free ((char*) file_name);
+        }
+    }
+
+    return nb_chunks;
+}
+
+/*
+ * Returns the name of a file in the temporary directory of the system, so
+ * that benchmarks never write over the files of the Demo.
+ */
+const char *
+bench_get_temp_file_name (const char *name)
+{
+    char file_name[256];
+    const char *directory = getenv ("TMPDIR");
+
+    if (directory == NULL)
+        directory = getenv ("TEMP");
+
+    if (directory == NULL)
+        directory = getenv ("TMP");
+
+#ifdef _WIN32
+    if (directory == NULL)
+        directory = ".";
+#else
+    if (directory == NULL)
+        directory = "/tmp";
+#endif
+
+    snprintf (file_name, 256, "%s/%s", directory, name);
+
+    return strdup (file_name);
+}
+
+/*
+ * Registers the tiles with collision of the Demo: every tile id from 0 to 44
+ * is a wall except 42. The properties must be cleared once the chunks are
+ * loaded.
+ */
+void
+bench_register_demo_walls (void)
+{
+    for (int i = 0; i < 45; i++)
+        eng_tile_register_properties (i, i != 42 ? ENG_TILE_SOLID : 0, 1);
+}
+
+/*
+ * Loads the chunk window around chunk 0,0 of the Demo, with the walls of the
+ * Demo or with no tile with collision.
+ */
+bool
+bench_load_window (EngChunk chunk[], bool has_walls)
+{
+    EngChunk *curr_chunk = NULL;
+    int chunk_x = 0;
+    int chunk_y = 0;
+    bool is_loaded = true;
+
+    if (has_walls)
+        bench_register_demo_walls ();
+
+    for (int i = 0; i < NBCHUNKS; i++) {
+        chunk_x = i % CHUNKSX - CHUNKSX / 2;
+        chunk_y = i / CHUNKSX - CHUNKSY / 2;
+        chunk[eng_chunk_get_index (chunk_x, chunk_y)] =
+        eng_chunk_create_chunk ();
+    }
+
+    for (int i = 0; i < NBCHUNKS; i++) {
+        chunk_x = i % CHUNKSX - CHUNKSX / 2;
+        chunk_y = i / CHUNKSX - CHUNKSY / 2;
+        curr_chunk = &chunk[eng_chunk_get_index (chunk_x, chunk_y)];
+        curr_chunk->chunk_x = chunk_x;
+        curr_chunk->chunk_y = chunk_y;
+
+        if (has_walls && !eng_chunk_parse_text_file (curr_chunk, NULL))
+            is_loaded = false;
+    }
+
+    eng_tile_clear_properties ();
+
+    return is_loaded;
+}
@@ -0,0 +1,17 @@
+#ifndef BENCHMARKS_H_INCLUDED
+#define BENCHMARKS_H_INCLUDED
+
+#include "../Engine/globals.h"
+#include "../Chunks/chunk.h"
+
+/** Chunks from -BENCH_CHUNK_RANGE to BENCH_CHUNK_RANGE are searched. */
+#define BENCH_CHUNK_RANGE 20
+#define BENCH_MAX_CHUNKS 256 /**< Maximum number of chunks measured. */
+
+void eng_bench_all (void);
+int bench_find_chunks (EngPoint2d position[]);
+const char * bench_get_temp_file_name (const char *name);
+void bench_register_demo_walls (void);
+bool bench_load_window (EngChunk chunk[], bool has_walls);
+
+#endif /* BENCHMARKS_H_INCLUDED */
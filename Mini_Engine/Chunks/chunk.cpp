@@ -7,35 +7,71 @@
 /*===========================================================================*/
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <math.h>
 #include "chunk.h"
+#include "chunk_binary.h"
+#include "chunk_cache.h"
+#include "chunk_directory.h"
+#include "chunk_parser.h"
+#include "chunk_region.h"
+#include "chunk_streamer.h"
+#include "chunk_writer.h"
 #include "tile.h"
 #include "objects.h"
+#include "../File_Utilities/file_utilities.h"
+
+/** Cost of the last chunk loaded by eng_chunk_load_chunk (). */
+static EngChunkLoadStats load_stats = {0, 0, 0, 0};
 
 /*---------------------------------------------------------------------------*/
 /* Local function prototypes                                                 */
 /*---------------------------------------------------------------------------*/
 
 /**
- * @brief Sets the updated state of all chunks to false if they had a change in
- *        chunk id.
+ * @brief Returns the positive remainder of a division, so that negative chunk
+ *        coordinates also wrap around the chunk window.
+ *
+ * @param value:   The dividend.
+ * @param divisor: The divisor (larger than zero).
+ *
+ * @return The remainder, between 0 and divisor - 1.
+ */
+static int wrap_index (int value, int divisor);
+
+/**
+ * @brief Finds the first chunk in x or in y of the chunk window around a
+ *        position. The window is centered on the half chunk the position is
+ *        in.
+ *
+ * @param position:  Position in pixels, in x or in y.
+ * @param chunk:     Chunk in which the position is (in x or in y).
+ * @param length:    Length of a chunk in pixels, in x or in y.
+ * @param nb_chunks: Number of chunks of the window, in x or in y.
  *
- * @param chunk: Array of chunks to update.
+ * @return The first chunk of the window.
  */
-static void set_chunk_update_state (EngChunk chunk[]);
+static int get_window_start (int position, int chunk, int length,
+                             int nb_chunks);
 
 /*---------------------------------------------------------------------------*/
 /* Chunk functions implementation                                            */
 /*---------------------------------------------------------------------------*/
 
-/* Sets the main chunk's (chunk[0]) position. */
+/*
+ * Sets the main chunk's position, which is stored in the slot of the chunk
+ * window that corresponds to its coordinates.
+ */
 void
 eng_chunk_set_main_chunk (EngChunk chunk[], int chunk_x, int chunk_y)
 {
+    int index = eng_chunk_get_index (chunk_x, chunk_y);
+
     /* Sets a certain starting chunk. */
     if (NBCHUNKS > 0) {
-        chunk[0].chunk_x = chunk_x;
-        chunk[0].chunk_y = chunk_y;
+        chunk[index].chunk_x = chunk_x;
+        chunk[index].chunk_y = chunk_y;
     }
     else
         printf("Impossible to initiate an empty chunk array.\n");
@@ -43,25 +79,134 @@ eng_chunk_set_main_chunk (EngChunk chunk[], int chunk_x, int chunk_y)
 
 /*
  * Loads data such as tile data and object data to a singular chunk, determined
- * by the chunkIndex.
+ * by the chunkIndex. Chunks found in the chunk cache are not read again.
+ * Pinned chunks are copied from the chunk directory.
+ * When the chunk streamer runs, the other chunks are requested to its thread
+ * and placeholder tiles are shown until they are loaded. Otherwise, the binary
+ * chunk file is used when it exists and the text chunk file is read once and
+ * parsed from memory. Edits not written yet come before all of these. The
+ * object grid is built once the objects are loaded. The cost of the load is
+ * kept in the load statistics.
  */
 bool
 eng_chunk_load_chunk (EngChunk *chunk, bool force_load)
 {
     bool result = false;
+    bool is_cached = false;
+    bool is_streamed = !force_load && eng_chunk_streamer_is_running ();
+    int nb_values_parsed = 0;
+    EngFileStats file_stats;
+
+    /* A placeholder is replaced as soon as its chunk has been loaded. */
+    if (chunk->is_placeholder && !force_load) {
+        if (eng_chunk_writer_find (chunk->chunk_x, chunk->chunk_y) != NULL) {
+            eng_chunk_destroy (chunk);
+            result = eng_chunk_writer_fetch (chunk);
+        }
+        else if (eng_chunk_directory_fetch (chunk))
+            result = true;
+        else if (eng_chunk_cache_contains (chunk->chunk_x, chunk->chunk_y))
+            result = eng_chunk_cache_fetch (chunk);
+        else if (!eng_chunk_streamer_collect (chunk))
+            eng_chunk_streamer_request (chunk->chunk_x, chunk->chunk_y);
+        else
+            result = true;
 
+        if (result) {
+            chunk->is_placeholder = false;
+            chunk->updated = true;
+            eng_object_build_grid (chunk);
+        }
+    }
     /* Load tile and object data into one chunk. */
-    if (!chunk->updated || force_load) {
+    else if (!chunk->updated || force_load) {
+        file_stats = eng_file_get_stats ();
         eng_chunk_destroy (chunk);
-        eng_tile_load_tiles (chunk);
-        eng_object_load_objects (chunk);
-        chunk->updated = true;
+        chunk->is_placeholder = false;
+
+        /* A forced load must read the files, the cached copy is outdated. */
+        if (eng_chunk_writer_fetch (chunk))
+            is_cached = true;
+        else if (force_load)
+            eng_chunk_cache_invalidate (chunk->chunk_x, chunk->chunk_y);
+        else {
+            is_cached = eng_chunk_directory_fetch (chunk) ||
+                        eng_chunk_cache_fetch (chunk);
+        }
+
+        if (!is_cached && is_streamed) {
+            if (!eng_chunk_streamer_collect (chunk)) {
+                eng_chunk_streamer_request (chunk->chunk_x, chunk->chunk_y);
+                eng_chunk_streamer_set_placeholder (chunk);
+            }
+        }
+        else if (!is_cached)
+            eng_chunk_read_chunk (chunk, &nb_values_parsed);
+
+        /* Keep the difference in file statistics caused by this load. */
+        load_stats.nb_file_opens = eng_file_get_stats ().nb_opens -
+                                   file_stats.nb_opens;
+        load_stats.nb_file_reads = eng_file_get_stats ().nb_reads -
+                                   file_stats.nb_reads;
+        load_stats.nb_bytes_read = eng_file_get_stats ().nb_bytes_read -
+                                   file_stats.nb_bytes_read;
+        load_stats.nb_values_parsed = nb_values_parsed;
+
+        if (!chunk->is_placeholder)
+            eng_object_build_grid (chunk);
+
+        chunk->updated = !chunk->is_placeholder;
         result = true;
     }
 
     return result;
 }
 
+/*
+ * Reads a chunk from the first chunk file found: binary, text, then region.
+ * Loose chunk files come first so an edited chunk overrides its packed copy.
+ */
+bool
+eng_chunk_read_chunk (EngChunk *chunk, int *nb_values_parsed)
+{
+    bool result = false;
+    long size = 0;
+    char *buffer = NULL;
+    const char *file_name = NULL;
+
+    if (nb_values_parsed != NULL)
+        *nb_values_parsed = 0;
+
+    if (eng_chunk_binary_load (chunk))
+        return true;
+
+    file_name = eng_chunk_get_file_name (chunk->chunk_x, chunk->chunk_y);
+    buffer = eng_file_read_file (file_name, &size);
+
+    if (buffer != NULL) {
+        result = eng_chunk_parse_text_buffer (chunk, buffer, size,
+                                              nb_values_parsed);
+        free (buffer);
+    }
+    else if (!(result = eng_chunk_region_load (chunk))) {
+        /* Chunks without data are left empty instead of keeping old tiles. */
+        eng_tile_fill (chunk, 0);
+
+        printf ("Error: Could not open file %s\n", file_name);
+    }
+
+    free ((char*) file_name);
+
+    return result;
+}
+
+/* Returns the cost of the last chunk loaded by eng_chunk_load_chunk (). */
+EngChunkLoadStats
+eng_chunk_get_load_stats (void)
+{
+    return load_stats;
+}
+
 /*
  * Loads data such as tile data and object data to all chunks in the array of
  * chunks sent in parameters.
@@ -79,24 +224,29 @@ eng_chunk_load_chunks (EngChunk chunk[], bool force_load)
             eng_chunk_load_chunk (&chunk[i], force_load);
     }
 
+    /* Prefetched chunks wait in the chunk cache until they are needed. */
+    eng_chunk_streamer_store_loaded ();
+
     return result;
 }
 
 /*
- * This function updates the chunkX and chunkY coordinates for every chunk in
- * the chunk array and rotates the chunks based on character coordinates
- * if necessary.
- * chunk[0] is the main chunk and always contains the selected character.
- * chunk[1] is the horizontal chunk.
- * chunk[2] is the vertical chunk.
- * chunk[3] is the diagonal chunk.
+ * This function updates the chunk window based on character coordinates and
+ * loads the chunks that entered it.
+ * The window is a ring buffer of CHUNKSX by CHUNKSY chunks indexed by world
+ * chunk coordinates (see eng_chunk_get_index ()), so chunks that stay in the
+ * window never move. Crossing a chunk border only replaces the row or the
+ * column of chunks that left the window.
  */
 bool
 eng_chunk_rotate_chunks (EngChunk chunk[], int char_x, int char_y,
                          int char_chunk_x, int char_chunk_y)
 {
-    int chunk_pixel_lenght = TILESIZE * TILESX; /* Length of chunk in pixels.*/
-    int chunk_pixel_height = TILESIZE * TILESY; /* Height of chunk in pixels.*/
+    int start_x = get_window_start (char_x, char_chunk_x, TILESIZE * TILESX,
+                                    CHUNKSX);
+    int start_y = get_window_start (char_y, char_chunk_y, TILESIZE * TILESY,
+                                    CHUNKSY);
+    int index = 0;
 
     /* Save chunk data to oldChunk. */
     for (int i = 0; i < NBCHUNKS; i++) {
@@ -104,86 +254,165 @@ eng_chunk_rotate_chunks (EngChunk chunk[], int char_x, int char_y,
         chunk[i].old_chunk_y = chunk[i].chunk_y;
     }
 
-    /* Update main chunk to be the one the character is in. */
-    if (NBCHUNKS > 0) {
-        chunk[0].chunk_x = char_chunk_x;
-        chunk[0].chunk_y = char_chunk_y;
-    }
-
     /*
-     * Horizontal chunk update.
-     * The horizontal chunk is always chunkX[0] - 1 or chunkX[0] + 1 and
-     * chunkY[0], depending on the selected character's coordinates.
+     * Every chunk of the window has its own slot. Slots holding another chunk
+     * keep it in the chunk cache and need to be loaded.
      */
-    if (NBCHUNKS > 1) {
-        if (char_x >= char_chunk_x * chunk_pixel_lenght &&
-            char_x < char_chunk_x * chunk_pixel_lenght +
-            chunk_pixel_lenght / 2) {
-            chunk[1].chunk_x = chunk[0].chunk_x - 1;
-        }
-        else {
-            chunk[1].chunk_x = chunk[0].chunk_x + 1;
-        }
+    for (int x = start_x; x < start_x + CHUNKSX; x++) {
+        for (int y = start_y; y < start_y + CHUNKSY; y++) {
+            index = eng_chunk_get_index (x, y);
 
-        chunk[1].chunk_y = chunk[0].chunk_y;
-    }
+            if (chunk[index].chunk_x != x || chunk[index].chunk_y != y) {
+                /*
+                 * Edits are written when their chunk leaves the window, the
+                 * copy in the window may predate them and is not cached,
+                 * even when the edits could not be written.
+                 */
+                if (eng_chunk_writer_flush_chunk (chunk[index].chunk_x,
+                                                  chunk[index].chunk_y) ==
+                    ENG_FLUSH_NOTHING_PENDING && chunk[index].updated) {
+                    eng_chunk_cache_store (&chunk[index]);
+                }
 
-    /*
-     * Vertical chunk update.
-     * The vertical chunk is always chunkX[0] and chunkY[0] - 1
-     * or chunkY[0] + 1, depending on the selected character's coordinates.
-     */
-    if (NBCHUNKS > 2) {
-        if (char_y >= char_chunk_y * chunk_pixel_height &&
-            char_y < char_chunk_y * chunk_pixel_height +
-            chunk_pixel_height / 2) {
-            chunk[2].chunk_y = chunk[0].chunk_y - 1;
-        }
-        else {
-            chunk[2].chunk_y = chunk[0].chunk_y + 1;
+                chunk[index].chunk_x = x;
+                chunk[index].chunk_y = y;
+                chunk[index].updated = false;
+                chunk[index].is_placeholder = false;
+            }
         }
-        chunk[2].chunk_x = chunk[0].chunk_x;
     }
 
-    /*
-     * Diagonal chunk update.
-     * The diagonal chunk always has the same chunkX value as the horizontal
-     * chunk and the same chunkY value as the vertical chunk.
-     */
-    if (NBCHUNKS > 3) {
-        chunk[3].chunk_x = chunk[1].chunk_x;
-        chunk[3].chunk_y = chunk[2].chunk_y;
-    }
-
-    /* Update the chunks' update states. */
-    set_chunk_update_state (chunk);
-
     /* Update chunks if there was a change. */
     return eng_chunk_load_chunks (chunk, false);
 }
 
 /*
- * Sets the updated state of all chunks to false if they had a change in chunk
- * id.
+ * Requests the chunks a character is heading toward to the chunk streamer.
+ * The chunk window is computed for a point ahead of the character in the
+ * direction it is facing, and chunks that are neither in the chunk window nor
+ * in the chunk cache are requested.
  */
-static void
-set_chunk_update_state (EngChunk chunk[])
+int
+eng_chunk_prefetch_chunks (EngChunk chunk[], int char_x, int char_y,
+                           int direction)
 {
-    for (int i = 0; i < NBCHUNKS; i++) {
-        if (chunk[i].chunk_x != chunk[i].old_chunk_x ||
-            chunk[i].chunk_y != chunk[i].old_chunk_y) {
-            chunk[i].updated = false;
+    int nb_requests = 0;
+    int ahead_x = char_x;
+    int ahead_y = char_y;
+    int start_x = 0;
+    int start_y = 0;
+
+    if (!eng_chunk_streamer_is_running ())
+        return 0;
+
+    if (direction == ENG_DOWN)
+        ahead_y += ENG_CHUNK_PREFETCH_DISTANCE;
+    else if (direction == ENG_UP)
+        ahead_y -= ENG_CHUNK_PREFETCH_DISTANCE;
+    else if (direction == ENG_RIGHT)
+        ahead_x += ENG_CHUNK_PREFETCH_DISTANCE;
+    else if (direction == ENG_LEFT)
+        ahead_x -= ENG_CHUNK_PREFETCH_DISTANCE;
+
+    start_x = get_window_start (ahead_x,
+                                floor ((double) ahead_x / (TILESIZE * TILESX)),
+                                TILESIZE * TILESX, CHUNKSX);
+    start_y = get_window_start (ahead_y,
+                                floor ((double) ahead_y / (TILESIZE * TILESY)),
+                                TILESIZE * TILESY, CHUNKSY);
+
+    for (int x = start_x; x < start_x + CHUNKSX; x++) {
+        for (int y = start_y; y < start_y + CHUNKSY; y++) {
+            if (eng_chunk_get_chunk (chunk, x, y) == NULL &&
+                !eng_chunk_cache_contains (x, y) &&
+                !eng_chunk_streamer_is_requested (x, y) &&
+                eng_chunk_streamer_request (x, y)) {
+                nb_requests++;
+            }
         }
     }
+
+    return nb_requests;
+}
+
+/*
+ * Returns the index of the slot of the chunk window that holds a chunk.
+ * Chunks are stored at (chunk_x mod CHUNKSX) + (chunk_y mod CHUNKSY) *
+ * CHUNKSX, which is different for every chunk of a window.
+ */
+int
+eng_chunk_get_index (int chunk_x, int chunk_y)
+{
+    return wrap_index (chunk_x, CHUNKSX) +
+           wrap_index (chunk_y, CHUNKSY) * CHUNKSX;
+}
+
+/*
+ * Returns the chunk of the chunk window at the chunk coordinates in
+ * parameters, or NULL if the slot of these coordinates holds another chunk.
+ */
+EngChunk *
+eng_chunk_get_chunk (EngChunk chunk[], int chunk_x, int chunk_y)
+{
+    EngChunk *result = &chunk[eng_chunk_get_index (chunk_x, chunk_y)];
+
+    if (result->chunk_x != chunk_x || result->chunk_y != chunk_y)
+        result = NULL;
+
+    return result;
+}
+
+/*
+ * Returns the first chunk in x and in y of the chunk window, which is the
+ * top-left chunk of the window.
+ */
+void
+eng_chunk_get_window_origin (EngChunk chunk[], int *chunk_x, int *chunk_y)
+{
+    *chunk_x = chunk[0].chunk_x;
+    *chunk_y = chunk[0].chunk_y;
+
+    for (int i = 1; i < NBCHUNKS; i++) {
+        if (chunk[i].chunk_x < *chunk_x)
+            *chunk_x = chunk[i].chunk_x;
+
+        if (chunk[i].chunk_y < *chunk_y)
+            *chunk_y = chunk[i].chunk_y;
+    }
+}
+
+/* Returns the positive remainder of a division. */
+static int
+wrap_index (int value, int divisor)
+{
+    int remainder = value % divisor;
+
+    return remainder < 0 ? remainder + divisor : remainder;
+}
+
+/*
+ * Finds the first chunk of the chunk window around a position. The window is
+ * centered on the half chunk the position is in: with two chunks, the second
+ * chunk is the neighbour on the side of the half the position is in.
+ */
+static int
+get_window_start (int position, int chunk, int length, int nb_chunks)
+{
+    int half_chunk = chunk * 2 + 1;
+
+    if (position >= chunk * length && position < chunk * length + length / 2)
+        half_chunk--;
+
+    return (int) floor ((half_chunk - nb_chunks + 1) / 2.0);
 }
 
 /* Returns a file name corresponding to the directory of a chunk data file. */
 const char *
 eng_chunk_get_file_name (int chunk_x, int chunk_y)
 {
-    char fileName[30];
+    char fileName[40];
 
-    sprintf (fileName, "Demo/chunks/%d,%d.txt", chunk_x, chunk_y);
+    snprintf (fileName, 40, "Demo/chunks/%d,%d.txt", chunk_x, chunk_y);
 
     return strdup (fileName);
 }
@@ -200,11 +429,19 @@ eng_chunk_create_chunk (void)
     chunk.chunk_y = 0;
     chunk.nb_objects = 0;
     chunk.updated = false;
+    chunk.is_placeholder = false;
 
-    for (int i = 0; i < TILESX; i++) {
-        for (int j = 0; j < TILESY; j++)
-            chunk.tile[i][j] = eng_tile_create_tile ();
-    }
+    chunk.tile_bits = 0;
+    chunk.nb_palette_ids = 0;
+    chunk.tile_palette = NULL;
+    chunk.tile_data = NULL;
+    chunk.tile_clearance = NULL;
+    chunk.object_grid = NULL;
+    chunk.object_grid_dirty = false;
+
+    memset (chunk.tile_collision, 0, sizeof(chunk.tile_collision));
+    eng_clearance_mark_chunk (&chunk);
+    chunk.clearance_version = 0;
 
     return chunk;
 }
@@ -214,5 +451,6 @@ void
 eng_chunk_destroy (EngChunk *chunk)
 {
     eng_tile_reset_collision (chunk);
+    eng_tile_deallocate_tiles (chunk);
     eng_object_deallocate (chunk);
 }
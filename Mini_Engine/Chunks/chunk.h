@@ -5,8 +5,24 @@
 #include <SDL.h>
 #include "../Engine/globals.h"
 
+/** Distance in pixels looked ahead of a character to prefetch chunks. */
+#define ENG_CHUNK_PREFETCH_DISTANCE (TILESIZE * TILESX / 2)
+
+typedef struct _EngChunkLoadStats {
+    int nb_file_opens;
+    int nb_file_reads;
+    long nb_bytes_read;
+    int nb_values_parsed;
+} EngChunkLoadStats;
+/**<
+ * Structure containing the cost of the last chunk load: the number of files
+ * opened, the number of whole file reads, the number of bytes read and the
+ * number of integers parsed from text data.
+ */
+
 /**
- * @brief Sets the main chunk's (chunk[0]) position.
+ * @brief Sets the main chunk's position, in the slot of the chunk array that
+ *        corresponds to its coordinates.
  *
  * @param chunk:   Chunk array to be modified.
  * @param chunk_x: The chunk in x to set to the main chunk.
@@ -15,7 +31,12 @@
 void eng_chunk_set_main_chunk (EngChunk chunk[], int chunk_x, int chunk_y);
 
 /**
- * @brief Loads tile and object data to a chunk.
+ * @brief Loads tile and object data to a chunk. Chunks in the chunk cache are
+ *        taken from memory. When the chunk streamer runs, other chunks are
+ *        loaded by its thread and show placeholder tiles meanwhile.
+ *        Otherwise the binary chunk file is used when it exists and the text
+ *        chunk file is read once and parsed from memory. A forced load always
+ *        reads the files on the calling thread.
  *
  * @param chunk:       Chunk to store data to.
  * @param chunk_index: The index of the chunk array to load data into.
@@ -28,6 +49,15 @@ void eng_chunk_set_main_chunk (EngChunk chunk[], int chunk_x, int chunk_y);
  */
 bool eng_chunk_load_chunk (EngChunk *chunk, bool force_load);
 
+/**
+ * @brief Returns the cost of the last chunk loaded by eng_chunk_load_chunk ().
+ *
+ * @return A structure containing the file and parse counts of the last load.
+ *
+ * @sa eng_file_get_stats ()
+ */
+EngChunkLoadStats eng_chunk_get_load_stats (void);
+
 /**
  * @brief Loads tile and object data to all chunks in the array of chunks
  *        in parameters.
@@ -44,7 +74,9 @@ bool eng_chunk_load_chunk (EngChunk *chunk, bool force_load);
 bool eng_chunk_load_chunks (EngChunk chunk[], bool force_load);
 
 /**
- * @brief Rotates chunks based on character coordinates.
+ * @brief Updates the window of CHUNKSX by CHUNKSY chunks around a character
+ *        and loads the chunks that entered it. Chunks that stay in the window
+ *        keep their slot (see eng_chunk_get_index ()).
  *
  * @param chunk:        Chunk array containing tile and object data.
  * @param char_x:       Position of the character in x.
@@ -57,6 +89,78 @@ bool eng_chunk_load_chunks (EngChunk chunk[], bool force_load);
 bool eng_chunk_rotate_chunks (EngChunk chunk[], int char_x, int char_y,
                               int char_chunk_x, int char_chunk_y);
 
+/**
+ * @brief Returns the index of the slot of the chunk array that holds a chunk.
+ *        The chunk array is a ring buffer of CHUNKSX by CHUNKSY chunks
+ *        indexed by world chunk coordinates.
+ *
+ * @param chunk_x: The chunk in x.
+ * @param chunk_y: The chunk in y.
+ *
+ * @return The index of the slot, from 0 to NBCHUNKS - 1.
+ *
+ * @sa eng_chunk_get_chunk ()
+ */
+int eng_chunk_get_index (int chunk_x, int chunk_y);
+
+/**
+ * @brief Returns a chunk of the chunk array from its world chunk coordinates.
+ *
+ * @param chunk:   Chunk array to search.
+ * @param chunk_x: The chunk in x.
+ * @param chunk_y: The chunk in y.
+ *
+ * @return The chunk, or NULL if it is not in the chunk array.
+ *
+ * @sa eng_chunk_get_index ()
+ */
+EngChunk * eng_chunk_get_chunk (EngChunk chunk[], int chunk_x, int chunk_y);
+
+/**
+ * @brief Returns the top-left chunk of the chunk window. Tile coordinates
+ *        used by the pathfinding are relative to this chunk.
+ *
+ * @param chunk:   Chunk array of the window.
+ * @param chunk_x: Pointer receiving the first chunk in x of the window.
+ * @param chunk_y: Pointer receiving the first chunk in y of the window.
+ */
+void eng_chunk_get_window_origin (EngChunk chunk[], int *chunk_x,
+                                  int *chunk_y);
+
+/**
+ * @brief Requests the chunks a character is heading toward to the chunk
+ *        streamer, so they are loaded before the character reaches them.
+ *        Does nothing if the chunk streamer is not running.
+ *
+ * @param chunk:     Chunk array containing the chunks in memory.
+ * @param char_x:    Position of the character in x.
+ * @param char_y:    Position of the character in y.
+ * @param direction: Direction the character is facing (EngDirectionType).
+ *
+ * @return The number of chunks requested.
+ *
+ * @sa eng_chunk_streamer_start ()
+ */
+int eng_chunk_prefetch_chunks (EngChunk chunk[], int char_x, int char_y,
+                               int direction);
+
+/**
+ * @brief Reads tile and object data to a chunk from the first chunk file
+ *        found, in order: the binary chunk file, the text chunk file, then the
+ *        region file containing the chunk. A chunk without any file is left
+ *        without tiles.
+ *
+ * @param chunk:            Chunk to store data to (chunk_x and chunk_y select
+ *                          the files), its objects must have been freed.
+ * @param nb_values_parsed: Pointer receiving the number of integers parsed
+ *                          from a text chunk file (can be NULL).
+ *
+ * @return True if one of the files contained the chunk, false otherwise.
+ *
+ * @sa eng_chunk_region_pack ()
+ */
+bool eng_chunk_read_chunk (EngChunk *chunk, int *nb_values_parsed);
+
 /**
  * @brief Returns a file name corresponding to the directory of a chunk data
  *        file.
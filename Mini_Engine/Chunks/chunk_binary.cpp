@@ -0,0 +1,387 @@
+/*===========================================================================*/
+/* File: chunk_binary.cpp                                                    */
+/* Author: YOAN BERNATCHEZ                                                   */
+/* Created On: 2026-10-16                                                    */
+/* Developed Using: SDL2                                                     */
+/* Function: Provides the user with a binary chunk format that is loaded     */
+/*           with a single read, and a converter from the text format.       */
+/*===========================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "chunk.h"
+#include "chunk_binary.h"
+#include "chunk_parser.h"
+#include "objects.h"
+#include "tile.h"
+#include "../File_Utilities/file_utilities.h"
+
+/*
+ * Layout of a binary chunk file (all values are 32 bit integers stored in
+ * the byte order of the machine that wrote them):
+ *
+ * - Header: "ENGC", version, TILESX, TILESY, number of objects, encoding of
+ *           the tiles (EngCompressionType) and size of the tiles in bytes.
+ * - Tiles:  TILESX * TILESY tile ids, row by row (same order as the text
+ *           format). With ENG_COMPRESSION_RLE, the ids are stored as runs of
+ *           a count followed by the id repeated count times.
+ * - Objects: id, x and y of every object.
+ */
+
+/* Local structures. */
+typedef struct _ChunkFileHeader {
+    char magic[4];
+    int32_t version;
+    int32_t tiles_x;
+    int32_t tiles_y;
+    int32_t nb_objects;
+    int32_t compression;
+    int32_t tiles_size;
+} ChunkFileHeader;
+/**< Header found at the start of every binary chunk file. */
+
+/*---------------------------------------------------------------------------*/
+/* Local function prototypes                                                 */
+/*---------------------------------------------------------------------------*/
+
+/**
+ * @brief Counts the runs of identical ids in the tiles of a chunk, taken row
+ *        by row.
+ *
+ * @param chunk: Chunk to scan.
+ *
+ * @return The number of runs.
+ */
+static int count_runs (EngChunk *chunk);
+
+/**
+ * @brief Writes the tile ids of a chunk as runs of a count and an id.
+ *
+ * @param chunk: Chunk to encode.
+ * @param run:   Buffer receiving two integers per run.
+ */
+static void encode_runs (EngChunk *chunk, int32_t *run);
+
+/**
+ * @brief Expands runs of a count and an id into the tiles of a chunk.
+ *
+ * @param chunk:   Chunk to store the tile ids to.
+ * @param run:     Runs to expand.
+ * @param nb_runs: The number of runs.
+ *
+ * @return True if the runs covered every tile exactly, false otherwise.
+ */
+static bool decode_runs (EngChunk *chunk, const int32_t *run, int nb_runs);
+
+/*---------------------------------------------------------------------------*/
+/* Binary chunk function implementations                                     */
+/*---------------------------------------------------------------------------*/
+
+/*
+ * Loads tile and object data to a chunk from its binary chunk file. The whole
+ * file is read at once, then decoded from memory.
+ */
+bool
+eng_chunk_binary_load (EngChunk *chunk)
+{
+    bool result = false;
+    long size = 0;
+    const char *file_name =
+    eng_chunk_binary_get_file_name (chunk->chunk_x, chunk->chunk_y);
+    char *buffer = eng_file_read_file (file_name, &size);
+
+    /* A missing binary file is not an error, the text file is used. */
+    if (buffer != NULL) {
+        result = eng_chunk_binary_decode (chunk, buffer, size);
+
+        if (!result)
+            printf ("Error: invalid binary chunk file %s\n", file_name);
+
+        free (buffer);
+    }
+
+    free ((char*) file_name);
+
+    return result;
+}
+
+/* Fills a chunk with the content of a binary chunk file. */
+bool
+eng_chunk_binary_decode (EngChunk *chunk, const char *buffer, long size)
+{
+    ChunkFileHeader header;
+    const int32_t *id = NULL;
+    const int32_t *object = NULL;
+    long remaining = size - (long) sizeof(ChunkFileHeader);
+
+    if (size < (long) sizeof(ChunkFileHeader))
+        return false;
+
+    memcpy (&header, buffer, sizeof(ChunkFileHeader));
+
+    if (memcmp (header.magic, "ENGC", 4) != 0 ||
+        header.version != ENG_CHUNK_BINARY_VERSION ||
+        header.tiles_x != TILESX || header.tiles_y != TILESY ||
+        header.nb_objects < 0 || header.tiles_size < 0 ||
+        header.tiles_size % sizeof(int32_t) != 0) {
+        return false;
+    }
+
+    /*
+     * The sizes of the header are checked against the size of the file one
+     * at a time, so that a malformed file cannot make them overflow.
+     */
+    if (header.tiles_size > remaining)
+        return false;
+
+    remaining -= header.tiles_size;
+
+    if (remaining % (long) (3 * sizeof(int32_t)) != 0 ||
+        header.nb_objects != remaining / (long) (3 * sizeof(int32_t))) {
+        return false;
+    }
+
+    /* Tile ids are stored row by row, directly after the header. */
+    id = (const int32_t*) (buffer + sizeof(ChunkFileHeader));
+
+    if (header.compression == ENG_COMPRESSION_RLE) {
+        if (header.tiles_size % (2 * sizeof(int32_t)) != 0 ||
+            !decode_runs (chunk, id, header.tiles_size /
+                                     (2 * sizeof(int32_t)))) {
+            return false;
+        }
+    }
+    else if (header.compression == ENG_COMPRESSION_NONE &&
+             header.tiles_size == TILESX * TILESY * (long) sizeof(int32_t)) {
+        eng_tile_load_ids (chunk, id);
+    }
+    else
+        return false;
+
+    /* Objects follow the tiles as triplets of id, x and y. */
+    object = (const int32_t*) ((const char*) id + header.tiles_size);
+
+    eng_object_allocate (chunk, header.nb_objects);
+
+    for (int i = 0; i < header.nb_objects; i++) {
+        chunk->object[i] = eng_object_create_object (object[i * 3],
+                                                     object[i * 3 + 1],
+                                                     object[i * 3 + 2]);
+    }
+
+    return true;
+}
+
+/*
+ * Assembles the content of a binary chunk file in memory, so that it can be
+ * written at once.
+ */
+char *
+eng_chunk_binary_encode (EngChunk *chunk, int compression, long *size)
+{
+    ChunkFileHeader header = {{'E', 'N', 'G', 'C'}, ENG_CHUNK_BINARY_VERSION,
+                              TILESX, TILESY, chunk->nb_objects,
+                              ENG_COMPRESSION_NONE, 0};
+    char *buffer = NULL;
+    int32_t *id = NULL;
+    int32_t *object = NULL;
+    int nb_runs = 0;
+    long raw_size = TILESX * TILESY * sizeof(int32_t);
+
+    if (compression != ENG_COMPRESSION_NONE) {
+        nb_runs = count_runs (chunk);
+
+        /* Runs take two integers, they only pay off on repeated ids. */
+        if (compression == ENG_COMPRESSION_RLE ||
+            (long) (nb_runs * 2 * sizeof(int32_t)) < raw_size) {
+            header.compression = ENG_COMPRESSION_RLE;
+        }
+    }
+
+    if (header.compression == ENG_COMPRESSION_RLE)
+        header.tiles_size = nb_runs * 2 * sizeof(int32_t);
+    else
+        header.tiles_size = raw_size;
+
+    *size = sizeof(ChunkFileHeader) + header.tiles_size +
+            chunk->nb_objects * 3 * sizeof(int32_t);
+    buffer = (char*) malloc (*size);
+
+    if (buffer != NULL) {
+        memcpy (buffer, &header, sizeof(ChunkFileHeader));
+        id = (int32_t*) (buffer + sizeof(ChunkFileHeader));
+
+        if (header.compression == ENG_COMPRESSION_RLE)
+            encode_runs (chunk, id);
+        else {
+            for (int y = 0; y < TILESY; y++) {
+                for (int x = 0; x < TILESX; x++)
+                    id[y * TILESX + x] = eng_tile_get_id (chunk, x, y);
+            }
+        }
+
+        object = (int32_t*) ((char*) id + header.tiles_size);
+
+        for (int i = 0; i < chunk->nb_objects; i++) {
+            object[i * 3] = chunk->object[i].id;
+            object[i * 3 + 1] = chunk->object[i].x;
+            object[i * 3 + 2] = chunk->object[i].y;
+        }
+    }
+    else
+        *size = 0;
+
+    return buffer;
+}
+
+/* Writes the tile and object data of a chunk to its binary chunk file. */
+bool
+eng_chunk_binary_save (EngChunk *chunk)
+{
+    bool result = false;
+    long size = 0;
+    char *buffer = eng_chunk_binary_encode (chunk, ENG_COMPRESSION_AUTO,
+                                            &size);
+    const char *file_name =
+    eng_chunk_binary_get_file_name (chunk->chunk_x, chunk->chunk_y);
+
+    if (buffer != NULL) {
+        /* The whole file was assembled in memory so it is written at once. */
+        FILE *file = fopen (file_name, "wb");
+
+        if (file != NULL) {
+            result = fwrite (buffer, 1, size, file) == (size_t) size;
+            file = eng_file_close_file (file);
+        }
+
+        free (buffer);
+    }
+
+    if (!result)
+        printf ("Error: could not write binary chunk file %s\n", file_name);
+
+    free ((char*) file_name);
+
+    return result;
+}
+
+/* Converts the text chunk file of a chunk to the binary chunk format. */
+bool
+eng_chunk_binary_convert (int chunk_x, int chunk_y)
+{
+    bool result = false;
+    const char *file_name = eng_chunk_get_file_name (chunk_x, chunk_y);
+    FILE *file = fopen (file_name, "r");
+
+    /* Chunks without a text file are skipped silently. */
+    if (file != NULL) {
+        file = eng_file_close_file (file);
+
+        EngChunk chunk = eng_chunk_create_chunk ();
+        chunk.chunk_x = chunk_x;
+        chunk.chunk_y = chunk_y;
+
+        eng_chunk_parse_text_file (&chunk, NULL);
+        result = eng_chunk_binary_save (&chunk);
+
+        eng_chunk_destroy (&chunk);
+    }
+
+    free ((char*) file_name);
+
+    return result;
+}
+
+/*
+ * Deletes the binary chunk file of a chunk, so that the text file is used the
+ * next time the chunk is loaded.
+ */
+void
+eng_chunk_binary_remove (int chunk_x, int chunk_y)
+{
+    const char *file_name = eng_chunk_binary_get_file_name (chunk_x, chunk_y);
+
+    remove (file_name);
+
+    free ((char*) file_name);
+}
+
+/*
+ * Returns a file name corresponding to the directory of a binary chunk data
+ * file.
+ */
+const char *
+eng_chunk_binary_get_file_name (int chunk_x, int chunk_y)
+{
+    char file_name[40];
+
+    snprintf (file_name, 40, "Demo/chunks/%d,%d.bin", chunk_x, chunk_y);
+
+    return strdup (file_name);
+}
+
+/* Counts the runs of identical ids in the tiles of a chunk. */
+static int
+count_runs (EngChunk *chunk)
+{
+    int nb_runs = 1;
+    int previous_id = eng_tile_get_id (chunk, 0, 0);
+
+    for (int y = 0; y < TILESY; y++) {
+        for (int x = 0; x < TILESX; x++) {
+            if (eng_tile_get_id (chunk, x, y) != previous_id) {
+                previous_id = eng_tile_get_id (chunk, x, y);
+                nb_runs++;
+            }
+        }
+    }
+
+    return nb_runs;
+}
+
+/* Writes the tile ids of a chunk as runs of a count and an id. */
+static void
+encode_runs (EngChunk *chunk, int32_t *run)
+{
+    int nb_runs = 0;
+
+    run[0] = 0;
+    run[1] = eng_tile_get_id (chunk, 0, 0);
+
+    for (int y = 0; y < TILESY; y++) {
+        for (int x = 0; x < TILESX; x++) {
+            if (eng_tile_get_id (chunk, x, y) != run[nb_runs * 2 + 1]) {
+                nb_runs++;
+                run[nb_runs * 2] = 0;
+                run[nb_runs * 2 + 1] = eng_tile_get_id (chunk, x, y);
+            }
+
+            run[nb_runs * 2]++;
+        }
+    }
+}
+
+/* Expands runs of a count and an id into the tiles of a chunk. */
+static bool
+decode_runs (EngChunk *chunk, const int32_t *run, int nb_runs)
+{
+    int32_t id[TILESX * TILESY];
+    int index = 0;
+
+    for (int i = 0; i < nb_runs; i++) {
+        if (run[i * 2] <= 0 || run[i * 2] > TILESX * TILESY - index)
+            return false;
+
+        for (int j = 0; j < run[i * 2]; j++, index++)
+            id[index] = run[i * 2 + 1];
+    }
+
+    if (index != TILESX * TILESY)
+        return false;
+
+    eng_tile_load_ids (chunk, id);
+
+    return true;
+}
@@ -0,0 +1,103 @@
+#ifndef CHUNK_BINARY_H_INCLUDED
+#define CHUNK_BINARY_H_INCLUDED
+
+#include <stdbool.h>
+#include "../Engine/globals.h"
+
+/** Version of the binary chunk format written by eng_chunk_binary_save (). */
+#define ENG_CHUNK_BINARY_VERSION 2
+
+/**
+ * Encodings of the tile ids of a binary chunk file. ENG_COMPRESSION_AUTO
+ * picks whichever of the other encodings is the smallest for each chunk.
+ */
+enum EngCompressionType {ENG_COMPRESSION_NONE, ENG_COMPRESSION_RLE,
+                         ENG_COMPRESSION_AUTO};
+
+/**
+ * @brief Loads tile and object data to a chunk from its binary chunk file,
+ *        using a single read.
+ *
+ * @param chunk: Chunk to store data to (chunk_x and chunk_y select the file).
+ *
+ * @return True if the binary file existed and was loaded, false otherwise.
+ *
+ * @sa eng_chunk_binary_save ()
+ */
+bool eng_chunk_binary_load (EngChunk *chunk);
+
+/**
+ * @brief Writes the tile and object data of a chunk to its binary chunk file.
+ *        Tile ids are compressed when it makes the file smaller.
+ *
+ * @param chunk: Chunk to save (chunk_x and chunk_y select the file).
+ *
+ * @return True on success, false otherwise.
+ *
+ * @sa eng_chunk_binary_load ()
+ */
+bool eng_chunk_binary_save (EngChunk *chunk);
+
+/**
+ * @brief Assembles the content of a binary chunk file in memory.
+ *
+ * @param chunk:       Chunk to encode.
+ * @param compression: Encoding of the tile ids (EngCompressionType).
+ * @param size:        Pointer receiving the size of the content in bytes.
+ *
+ * @return A dynamically allocated buffer (must be freed), or NULL if memory
+ *         could not be allocated.
+ *
+ * @sa eng_chunk_binary_decode ()
+ */
+char * eng_chunk_binary_encode (EngChunk *chunk, int compression,
+                                long *size);
+
+/**
+ * @brief Fills a chunk with the tile and object data contained in the content
+ *        of a binary chunk file. Compressed tile ids are decompressed directly
+ *        into the tiles of the chunk.
+ *
+ * @param chunk:  Chunk to store data to, its objects must have been freed.
+ * @param buffer: Content of a binary chunk file.
+ * @param size:   Size of the content in bytes.
+ *
+ * @return True if the content was a valid chunk, false otherwise.
+ *
+ * @sa eng_chunk_binary_encode ()
+ */
+bool eng_chunk_binary_decode (EngChunk *chunk, const char *buffer, long size);
+
+/**
+ * @brief Converts the text chunk file of a chunk to the binary chunk format.
+ *
+ * @param chunk_x: The chunk in x of the file to convert.
+ * @param chunk_y: The chunk in y of the file to convert.
+ *
+ * @return True if a text file was found and converted, false otherwise.
+ */
+bool eng_chunk_binary_convert (int chunk_x, int chunk_y);
+
+/**
+ * @brief Deletes the binary chunk file of a chunk, so that the text file is
+ *        used the next time the chunk is loaded.
+ *
+ * @param chunk_x: The chunk in x of the file to delete.
+ * @param chunk_y: The chunk in y of the file to delete.
+ */
+void eng_chunk_binary_remove (int chunk_x, int chunk_y);
+
+/**
+ * @brief Returns a file name corresponding to the directory of a binary chunk
+ *        data file.
+ *
+ * @param chunk_x: The chunk in x which we are trying to get the file name of.
+ * @param chunk_y: The chunk in y which we are trying to get the file name of.
+ *
+ * @return A string containing the directory of the wanted binary chunk file.
+ *
+ * @sa eng_chunk_get_file_name ()
+ */
+const char * eng_chunk_binary_get_file_name (int chunk_x, int chunk_y);
+
+#endif /* CHUNK_BINARY_H_INCLUDED */
@@ -0,0 +1,257 @@
+/*===========================================================================*/
+/* File: chunk_cache.cpp                                                     */
+/* Author: YOAN BERNATCHEZ                                                   */
+/* Created On: 2026-10-16                                                    */
+/* Developed Using: SDL2                                                     */
+/* Function: Provides the user with a cache of the chunks that recently left */
+/*           the chunk array, limited by a memory budget.                    */
+/*===========================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "chunk_cache.h"
+#include "objects.h"
+#include "tile.h"
+
+/* Local structures. */
+typedef struct _CacheEntry {
+    EngChunk chunk;
+    struct _CacheEntry *previous;
+    struct _CacheEntry *next;
+} CacheEntry;
+/**< Cached chunk, linked from the most to the least recently used. */
+
+/* Local variables. */
+static CacheEntry *first_entry = NULL;  /**< Most recently used chunk. */
+static CacheEntry *last_entry = NULL;   /**< Least recently used chunk. */
+static long cache_budget = ENG_CHUNK_CACHE_DEFAULT_BUDGET;
+static EngChunkCacheStats cache_stats = {0, 0, 0, 0, 0};
+
+/*---------------------------------------------------------------------------*/
+/* Local function prototypes                                                 */
+/*---------------------------------------------------------------------------*/
+
+/**
+ * @brief Returns the number of bytes used by a chunk in the cache.
+ *
+ * @param chunk: The chunk to measure.
+ *
+ * @return The size of the chunk and of its objects in bytes.
+ */
+static long get_chunk_size (const EngChunk *chunk);
+
+/**
+ * @brief Searches a chunk in the cache.
+ *
+ * @param chunk_x: The chunk in x to search.
+ * @param chunk_y: The chunk in y to search.
+ *
+ * @return The entry of the chunk or NULL if it is not in the cache.
+ */
+static CacheEntry * find_entry (int chunk_x, int chunk_y);
+
+/**
+ * @brief Unlinks an entry from the cache and frees it. The tiles and objects
+ *        of the chunk are freed if free_data is true.
+ *
+ * @param entry:     The entry to remove.
+ * @param free_data: True if the tiles and objects of the chunk must be freed.
+ */
+static void remove_entry (CacheEntry *entry, bool free_data);
+
+/**
+ * @brief Frees the least recently used chunks until the cache fits in the
+ *        budget.
+ */
+static void fit_budget (void);
+
+/*---------------------------------------------------------------------------*/
+/* Chunk cache function implementations                                      */
+/*---------------------------------------------------------------------------*/
+
+/*
+ * Sets the maximum number of bytes used by the chunk cache. The least recently
+ * used chunks are freed until the cache fits in the budget.
+ */
+void
+eng_chunk_cache_set_budget (long budget)
+{
+    cache_budget = budget < 0 ? 0 : budget;
+
+    fit_budget ();
+}
+
+/*
+ * Keeps the data of a chunk leaving the chunk array in the cache. The chunk is
+ * left without objects since the cache now owns them.
+ */
+void
+eng_chunk_cache_store (EngChunk *chunk)
+{
+    CacheEntry *entry = NULL;
+
+    /* An older copy of the same chunk is outdated. */
+    eng_chunk_cache_invalidate (chunk->chunk_x, chunk->chunk_y);
+
+    if (get_chunk_size (chunk) <= cache_budget)
+        entry = (CacheEntry*) malloc (sizeof(CacheEntry));
+
+    if (entry != NULL) {
+        entry->chunk = *chunk;
+        entry->previous = NULL;
+        entry->next = first_entry;
+
+        if (first_entry != NULL)
+            first_entry->previous = entry;
+        else
+            last_entry = entry;
+
+        first_entry = entry;
+        cache_stats.nb_chunks++;
+        cache_stats.nb_bytes += get_chunk_size (chunk);
+
+        /* The tiles and objects now belong to the cache. */
+        chunk->tile_bits = 0;
+        chunk->nb_palette_ids = 0;
+        chunk->tile_palette = NULL;
+        chunk->tile_data = NULL;
+        chunk->tile_clearance = NULL;
+        chunk->object = NULL;
+        chunk->object_grid = NULL;
+        chunk->object_grid_dirty = false;
+        chunk->nb_objects = 0;
+
+        fit_budget ();
+    }
+    else {
+        eng_tile_deallocate_tiles (chunk);
+        eng_object_deallocate (chunk);
+    }
+}
+
+/*
+ * Retrieves the tiles, collisions and objects of a chunk from the cache. The
+ * chunk is removed from the cache on success.
+ */
+bool
+eng_chunk_cache_fetch (EngChunk *chunk)
+{
+    CacheEntry *entry = find_entry (chunk->chunk_x, chunk->chunk_y);
+    EngChunk cached_chunk;
+
+    if (entry == NULL) {
+        cache_stats.nb_misses++;
+        return false;
+    }
+
+    /* The tiles and objects now belong to the chunk again. */
+    cached_chunk = entry->chunk;
+    remove_entry (entry, false);
+
+    eng_tile_move_tiles (chunk, &cached_chunk);
+    chunk->nb_objects = cached_chunk.nb_objects;
+    chunk->object = cached_chunk.object;
+    chunk->object_grid = cached_chunk.object_grid;
+    chunk->object_grid_dirty = cached_chunk.object_grid_dirty;
+    cache_stats.nb_hits++;
+
+    return true;
+}
+
+/* Checks if a chunk is in the cache without counting a hit or a miss. */
+bool
+eng_chunk_cache_contains (int chunk_x, int chunk_y)
+{
+    return find_entry (chunk_x, chunk_y) != NULL;
+}
+
+/* Removes a chunk from the cache, used when its files are modified. */
+void
+eng_chunk_cache_invalidate (int chunk_x, int chunk_y)
+{
+    CacheEntry *entry = find_entry (chunk_x, chunk_y);
+
+    if (entry != NULL)
+        remove_entry (entry, true);
+}
+
+/* Frees every chunk held by the cache. */
+void
+eng_chunk_cache_clear (void)
+{
+    while (first_entry != NULL)
+        remove_entry (first_entry, true);
+}
+
+/* Returns the hit and miss counters and the current usage of the cache. */
+EngChunkCacheStats
+eng_chunk_cache_get_stats (void)
+{
+    cache_stats.budget = cache_budget;
+
+    return cache_stats;
+}
+
+/* Resets the hit and miss counters of the cache to zero. */
+void
+eng_chunk_cache_reset_stats (void)
+{
+    cache_stats.nb_hits = 0;
+    cache_stats.nb_misses = 0;
+}
+
+/* Returns the number of bytes used by a chunk in the cache. */
+static long
+get_chunk_size (const EngChunk *chunk)
+{
+    return sizeof(CacheEntry) + eng_tile_get_memory_size (chunk) +
+           chunk->nb_objects * sizeof(EngObject) +
+           eng_object_get_grid_memory_size (chunk);
+}
+
+/* Searches a chunk in the cache. */
+static CacheEntry *
+find_entry (int chunk_x, int chunk_y)
+{
+    for (CacheEntry *entry = first_entry; entry != NULL; entry = entry->next) {
+        if (entry->chunk.chunk_x == chunk_x &&
+            entry->chunk.chunk_y == chunk_y) {
+            return entry;
+        }
+    }
+
+    return NULL;
+}
+
+/* Unlinks an entry from the cache and frees it. */
+static void
+remove_entry (CacheEntry *entry, bool free_data)
+{
+    if (entry->previous != NULL)
+        entry->previous->next = entry->next;
+    else
+        first_entry = entry->next;
+
+    if (entry->next != NULL)
+        entry->next->previous = entry->previous;
+    else
+        last_entry = entry->previous;
+
+    cache_stats.nb_chunks--;
+    cache_stats.nb_bytes -= get_chunk_size (&entry->chunk);
+
+    if (free_data) {
+        eng_tile_deallocate_tiles (&entry->chunk);
+        eng_object_deallocate (&entry->chunk);
+    }
+
+    free (entry);
+}
+
+/* Frees the least recently used chunks until the cache fits in the budget. */
+static void
+fit_budget (void)
+{
+    while (last_entry != NULL && cache_stats.nb_bytes > cache_budget)
+        remove_entry (last_entry, true);
+}
@@ -0,0 +1,94 @@
+#ifndef CHUNK_CACHE_H_INCLUDED
+#define CHUNK_CACHE_H_INCLUDED
+
+#include <stdbool.h>
+#include "../Engine/globals.h"
+
+/** Memory budget of the chunk cache in bytes, until changed by the user. */
+#define ENG_CHUNK_CACHE_DEFAULT_BUDGET (1024 * 1024)
+
+typedef struct _EngChunkCacheStats {
+    int nb_hits;
+    int nb_misses;
+    int nb_chunks;
+    long nb_bytes;
+    long budget;
+} EngChunkCacheStats;
+/**<
+ * Structure containing the number of cache hits and misses since the last
+ * reset, and the number of chunks and bytes currently held by the cache.
+ */
+
+/**
+ * @brief Sets the maximum number of bytes used by the chunk cache. The least
+ *        recently used chunks are freed until the cache fits in the budget.
+ *
+ * @param budget: Maximum number of bytes, 0 disables the cache.
+ */
+void eng_chunk_cache_set_budget (long budget);
+
+/**
+ * @brief Keeps the data of a chunk leaving the chunk array in the cache. The
+ *        cache takes ownership of the objects of the chunk, which is left
+ *        without objects.
+ *
+ * @param chunk: Chunk to store (chunk_x and chunk_y identify the data).
+ *
+ * @sa eng_chunk_cache_fetch ()
+ */
+void eng_chunk_cache_store (EngChunk *chunk);
+
+/**
+ * @brief Retrieves the tiles, collisions and objects of a chunk from the
+ *        cache. The chunk is removed from the cache on success.
+ *
+ * @param chunk: Chunk to fill (chunk_x and chunk_y select the data), its
+ *               objects must have been freed.
+ *
+ * @return True if the chunk was in the cache, false otherwise.
+ *
+ * @sa eng_chunk_cache_store ()
+ */
+bool eng_chunk_cache_fetch (EngChunk *chunk);
+
+/**
+ * @brief Checks if a chunk is in the cache without counting a hit or a miss.
+ *
+ * @param chunk_x: The chunk in x to search.
+ * @param chunk_y: The chunk in y to search.
+ *
+ * @return True if the chunk is in the cache, false otherwise.
+ */
+bool eng_chunk_cache_contains (int chunk_x, int chunk_y);
+
+/**
+ * @brief Removes a chunk from the cache, used when its files are modified.
+ *
+ * @param chunk_x: The chunk in x to remove.
+ * @param chunk_y: The chunk in y to remove.
+ */
+void eng_chunk_cache_invalidate (int chunk_x, int chunk_y);
+
+/**
+ * @brief Frees every chunk held by the cache.
+ */
+void eng_chunk_cache_clear (void);
+
+/**
+ * @brief Returns the hit and miss counters and the current usage of the
+ *        cache.
+ *
+ * @return A structure containing the statistics of the cache.
+ *
+ * @sa eng_chunk_cache_reset_stats ()
+ */
+EngChunkCacheStats eng_chunk_cache_get_stats (void);
+
+/**
+ * @brief Resets the hit and miss counters of the cache to zero.
+ *
+ * @sa eng_chunk_cache_get_stats ()
+ */
+void eng_chunk_cache_reset_stats (void);
+
+#endif /* CHUNK_CACHE_H_INCLUDED */
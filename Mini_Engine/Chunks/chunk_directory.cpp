@@ -0,0 +1,393 @@
+/*===========================================================================*/
+/* File: chunk_directory.cpp                                                 */
+/* Author: YOAN BERNATCHEZ                                                   */
+/* Created On: 2026-10-16                                                    */
+/* Developed Using: SDL2                                                     */
+/* Function: Provides the user with a directory of the chunks in memory, the */
+/*           chunk window and the chunks pinned outside of it, found from    */
+/*           their coordinates in constant time.                             */
+/*===========================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "chunk.h"
+#include "chunk_cache.h"
+#include "chunk_directory.h"
+#include "chunk_writer.h"
+#include "objects.h"
+#include "tile.h"
+
+/** Number of entries of the directory when the first chunk is pinned. */
+#define DIRECTORY_MIN_CAPACITY 16
+
+/* Local structures. */
+typedef struct _DirectoryEntry {
+    int chunk_x;
+    int chunk_y;
+    int nb_pins;
+    EngChunk *chunk;
+} DirectoryEntry;
+/**< Pinned chunk, an entry without a chunk is free. */
+
+/* Local variables. */
+static EngChunk *window = NULL;          /**< Chunk array of the window.   */
+static DirectoryEntry *directory = NULL; /**< Hash table of pinned chunks. */
+static int capacity = 0;                 /**< Entries, a power of two.     */
+static int nb_pinned = 0;                /**< Entries holding a chunk.     */
+
+/*---------------------------------------------------------------------------*/
+/* Local function prototypes                                                 */
+/*---------------------------------------------------------------------------*/
+
+/**
+ * @brief Returns the entry where the search for a chunk begins.
+ *
+ * @param chunk_x: The chunk in x.
+ * @param chunk_y: The chunk in y.
+ *
+ * @return The index of the entry (0 to capacity - 1).
+ */
+static int get_home_index (int chunk_x, int chunk_y);
+
+/**
+ * @brief Searches a pinned chunk in the directory.
+ *
+ * @param chunk_x: The chunk in x.
+ * @param chunk_y: The chunk in y.
+ *
+ * @return The entry of the chunk or NULL if the chunk is not pinned.
+ */
+static DirectoryEntry * find_entry (int chunk_x, int chunk_y);
+
+/**
+ * @brief Gives a chunk a free entry, entries being searched from the home
+ *        index of the chunk.
+ *
+ * @param chunk: The chunk to add (chunk_x and chunk_y identify it).
+ *
+ * @return The entry given to the chunk.
+ */
+static DirectoryEntry * insert_entry (EngChunk *chunk);
+
+/**
+ * @brief Frees an entry and moves back the entries that follow it, so no
+ *        search stops on the freed entry.
+ *
+ * @param entry: The entry to free.
+ */
+static void remove_entry (DirectoryEntry *entry);
+
+/**
+ * @brief Doubles the number of entries of the directory.
+ *
+ * @return True if the directory grew, false on allocation failure.
+ */
+static bool grow_directory (void);
+
+/**
+ * @brief Gives the data of a chunk that is no longer pinned to the chunk
+ *        cache, then frees the chunk.
+ *
+ * @param chunk: The chunk to release.
+ */
+static void release_chunk (EngChunk *chunk);
+
+/*---------------------------------------------------------------------------*/
+/* Chunk directory function implementations                                  */
+/*---------------------------------------------------------------------------*/
+
+/* Sets the chunk window known by the chunk directory. */
+void
+eng_chunk_directory_set_window (EngChunk chunk[])
+{
+    window = chunk;
+}
+
+/*
+ * Keeps a chunk in memory until it is no longer pinned. The chunk is read
+ * once, from the pending edits, the chunk cache or its files.
+ */
+EngChunk *
+eng_chunk_directory_pin (int chunk_x, int chunk_y)
+{
+    DirectoryEntry *entry = find_entry (chunk_x, chunk_y);
+    EngChunk *chunk = NULL;
+
+    if (entry != NULL) {
+        entry->nb_pins++;
+        return entry->chunk;
+    }
+
+    /* The directory is kept at most half full so searches stay short. */
+    if ((nb_pinned + 1) * 2 > capacity && !grow_directory ())
+        return NULL;
+
+    chunk = (EngChunk*) malloc (sizeof(EngChunk));
+
+    if (chunk == NULL)
+        return NULL;
+
+    *chunk = eng_chunk_create_chunk ();
+    chunk->chunk_x = chunk_x;
+    chunk->chunk_y = chunk_y;
+
+    if (!eng_chunk_writer_fetch (chunk) && !eng_chunk_cache_fetch (chunk) &&
+        !eng_chunk_read_chunk (chunk, NULL)) {
+        eng_chunk_destroy (chunk);
+        free (chunk);
+        return NULL;
+    }
+
+    chunk->updated = true;
+    insert_entry (chunk)->nb_pins = 1;
+
+    return chunk;
+}
+
+/* Releases a pin on a chunk, the chunk is released with its last pin. */
+bool
+eng_chunk_directory_unpin (int chunk_x, int chunk_y)
+{
+    DirectoryEntry *entry = find_entry (chunk_x, chunk_y);
+    EngChunk *chunk = NULL;
+
+    if (entry == NULL)
+        return false;
+
+    if (--entry->nb_pins == 0) {
+        chunk = entry->chunk;
+        remove_entry (entry);
+        release_chunk (chunk);
+    }
+
+    return true;
+}
+
+/*
+ * Returns a chunk in memory. The chunk window is searched first since its
+ * chunks are the most used, then the pinned chunks. A pinned chunk edited
+ * since it was pinned is returned from the chunk writer, which holds the
+ * edits.
+ */
+const EngChunk *
+eng_chunk_directory_find (int chunk_x, int chunk_y)
+{
+    const EngChunk *chunk = NULL;
+    DirectoryEntry *entry = NULL;
+
+    if (window != NULL) {
+        chunk = eng_chunk_get_chunk (window, chunk_x, chunk_y);
+
+        if (chunk != NULL && !chunk->is_placeholder)
+            return chunk;
+    }
+
+    entry = find_entry (chunk_x, chunk_y);
+
+    if (entry == NULL)
+        return NULL;
+
+    chunk = eng_chunk_writer_find (chunk_x, chunk_y);
+
+    return chunk != NULL ? chunk : entry->chunk;
+}
+
+/* Returns the tile at a position of the world, in pixels. */
+bool
+eng_chunk_directory_get_tile (int x, int y, int *id, bool *has_collision)
+{
+    static const int chunk_width = TILESIZE * TILESX;
+    static const int chunk_height = TILESIZE * TILESY;
+    int chunk_x = x / chunk_width - (x % chunk_width < 0);
+    int chunk_y = y / chunk_height - (y % chunk_height < 0);
+    int tile_x = (x - chunk_x * chunk_width) / TILESIZE;
+    int tile_y = (y - chunk_y * chunk_height) / TILESIZE;
+    const EngChunk *chunk = eng_chunk_directory_find (chunk_x, chunk_y);
+
+    if (chunk == NULL)
+        return false;
+
+    if (id != NULL)
+        *id = eng_tile_get_id (chunk, tile_x, tile_y);
+
+    if (has_collision != NULL)
+        *has_collision = eng_tile_has_collision (chunk, tile_x, tile_y);
+
+    return true;
+}
+
+/* Copies a pinned chunk to a chunk of the chunk window. */
+bool
+eng_chunk_directory_fetch (EngChunk *chunk)
+{
+    DirectoryEntry *entry = find_entry (chunk->chunk_x, chunk->chunk_y);
+
+    if (entry == NULL)
+        return false;
+
+    eng_tile_copy_tiles (chunk, entry->chunk);
+    eng_object_allocate (chunk, entry->chunk->nb_objects);
+
+    for (int i = 0; i < chunk->nb_objects; i++)
+        chunk->object[i] = entry->chunk->object[i];
+
+    return true;
+}
+
+/* Returns the number of chunks pinned. */
+int
+eng_chunk_directory_get_nb_pinned (void)
+{
+    return nb_pinned;
+}
+
+/* Releases every pin, the chunks go to the chunk cache. */
+void
+eng_chunk_directory_clear (void)
+{
+    for (int i = 0; i < capacity; i++) {
+        if (directory[i].chunk != NULL)
+            release_chunk (directory[i].chunk);
+    }
+
+    free (directory);
+    directory = NULL;
+    capacity = 0;
+    nb_pinned = 0;
+}
+
+/*
+ * Returns the entry where the search for a chunk begins. The coordinates are
+ * mixed so neighbouring chunks do not share their home entry.
+ */
+static int
+get_home_index (int chunk_x, int chunk_y)
+{
+    unsigned int hash = (unsigned int) chunk_x * 73856093u ^
+                        (unsigned int) chunk_y * 19349663u;
+
+    hash ^= hash >> 16;
+
+    return hash & (capacity - 1);
+}
+
+/* Searches a pinned chunk in the directory. */
+static DirectoryEntry *
+find_entry (int chunk_x, int chunk_y)
+{
+    int index = 0;
+
+    if (nb_pinned == 0)
+        return NULL;
+
+    index = get_home_index (chunk_x, chunk_y);
+
+    while (directory[index].chunk != NULL) {
+        if (directory[index].chunk_x == chunk_x &&
+            directory[index].chunk_y == chunk_y) {
+            return &directory[index];
+        }
+
+        index = (index + 1) & (capacity - 1);
+    }
+
+    return NULL;
+}
+
+/* Gives a chunk the first free entry from its home index. */
+static DirectoryEntry *
+insert_entry (EngChunk *chunk)
+{
+    int index = get_home_index (chunk->chunk_x, chunk->chunk_y);
+
+    while (directory[index].chunk != NULL)
+        index = (index + 1) & (capacity - 1);
+
+    directory[index].chunk_x = chunk->chunk_x;
+    directory[index].chunk_y = chunk->chunk_y;
+    directory[index].nb_pins = 0;
+    directory[index].chunk = chunk;
+    nb_pinned++;
+
+    return &directory[index];
+}
+
+/*
+ * Frees an entry. An entry that follows it is moved back to the freed entry
+ * unless its home index lies between the two, then the entry it left is freed
+ * in turn.
+ */
+static void
+remove_entry (DirectoryEntry *entry)
+{
+    int mask = capacity - 1;
+    int index = entry - directory;
+    int next = (index + 1) & mask;
+    int home = 0;
+
+    directory[index].chunk = NULL;
+    nb_pinned--;
+
+    while (directory[next].chunk != NULL) {
+        home = get_home_index (directory[next].chunk_x,
+                               directory[next].chunk_y);
+
+        /* Distances to the next entry, going around the directory. */
+        if (((next - home) & mask) >= ((next - index) & mask)) {
+            directory[index] = directory[next];
+            directory[next].chunk = NULL;
+            index = next;
+        }
+
+        next = (next + 1) & mask;
+    }
+}
+
+/* Doubles the number of entries of the directory. */
+static bool
+grow_directory (void)
+{
+    DirectoryEntry *old_directory = directory;
+    int old_capacity = capacity;
+    int new_capacity = capacity > 0 ? capacity * 2 : DIRECTORY_MIN_CAPACITY;
+    DirectoryEntry *new_directory = (DirectoryEntry*)
+                                    calloc (new_capacity,
+                                            sizeof(DirectoryEntry));
+    DirectoryEntry *entry = NULL;
+
+    if (new_directory == NULL)
+        return false;
+
+    directory = new_directory;
+    capacity = new_capacity;
+    nb_pinned = 0;
+
+    for (int i = 0; i < old_capacity; i++) {
+        if (old_directory[i].chunk != NULL) {
+            entry = insert_entry (old_directory[i].chunk);
+            entry->nb_pins = old_directory[i].nb_pins;
+        }
+    }
+
+    free (old_directory);
+
+    return true;
+}
+
+/*
+ * Gives the data of a chunk that is no longer pinned to the chunk cache. A
+ * chunk with pending edits is written instead, the pinned copy may predate
+ * them. When they could not be written, the edits stay in the chunk writer
+ * and the pinned copy is dropped all the same.
+ */
+static void
+release_chunk (EngChunk *chunk)
+{
+    if (eng_chunk_writer_flush_chunk (chunk->chunk_x, chunk->chunk_y) ==
+        ENG_FLUSH_NOTHING_PENDING) {
+        eng_chunk_cache_store (chunk);
+    }
+
+    eng_chunk_destroy (chunk);
+    free (chunk);
+}
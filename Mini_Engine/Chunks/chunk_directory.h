@@ -0,0 +1,90 @@
+#ifndef CHUNK_DIRECTORY_H_INCLUDED
+#define CHUNK_DIRECTORY_H_INCLUDED
+
+#include <stdbool.h>
+#include "../Engine/globals.h"
+
+/**
+ * @brief Sets the chunk window known by the chunk directory. Chunks of the
+ *        window are found without being pinned.
+ *
+ * @param chunk: Chunk array of the window, NULL to forget the window.
+ */
+void eng_chunk_directory_set_window (EngChunk chunk[]);
+
+/**
+ * @brief Keeps a chunk in memory until it is unpinned as many times as it was
+ *        pinned, so it can be used outside of the chunk window without being
+ *        read again. The chunk is read the first time it is pinned, edits
+ *        made after that are found with eng_chunk_directory_find ().
+ *
+ * @param chunk_x: The chunk in x.
+ * @param chunk_y: The chunk in y.
+ *
+ * @return The pinned chunk, or NULL if the chunk has no file.
+ *
+ * @sa eng_chunk_directory_unpin ()
+ */
+EngChunk * eng_chunk_directory_pin (int chunk_x, int chunk_y);
+
+/**
+ * @brief Releases a pin on a chunk. The chunk goes to the chunk cache once it
+ *        has no pin left.
+ *
+ * @param chunk_x: The chunk in x.
+ * @param chunk_y: The chunk in y.
+ *
+ * @return True if the chunk was pinned, false otherwise.
+ *
+ * @sa eng_chunk_directory_pin ()
+ */
+bool eng_chunk_directory_unpin (int chunk_x, int chunk_y);
+
+/**
+ * @brief Returns a chunk in memory, from the chunk window or from the pinned
+ *        chunks. Chunks of the window waiting for their tiles (placeholders)
+ *        are not loaded yet. A pinned chunk with pending edits is returned
+ *        from the chunk writer, since the pinned copy predates them.
+ *
+ * @param chunk_x: The chunk in x.
+ * @param chunk_y: The chunk in y.
+ *
+ * @return The chunk, or NULL if it is not loaded.
+ */
+const EngChunk * eng_chunk_directory_find (int chunk_x, int chunk_y);
+
+/**
+ * @brief Returns the tile at a position of the world, in pixels.
+ *
+ * @param x:             Position in x, in pixels.
+ * @param y:             Position in y, in pixels.
+ * @param id:            Pointer receiving the id of the tile, or NULL.
+ * @param has_collision: Pointer receiving the collision of the tile, or NULL.
+ *
+ * @return True if the tile is loaded, false if its chunk is not loaded, in
+ *         which case id and has_collision are not changed.
+ */
+bool eng_chunk_directory_get_tile (int x, int y, int *id, bool *has_collision);
+
+/**
+ * @brief Copies a pinned chunk to a chunk of the chunk window, so a chunk
+ *        entering the window is not read again.
+ *
+ * @param chunk: Chunk receiving the copy (chunk_x and chunk_y identify the
+ *               data).
+ *
+ * @return True if the chunk was pinned and copied, false otherwise.
+ */
+bool eng_chunk_directory_fetch (EngChunk *chunk);
+
+/**
+ * @return The number of chunks pinned.
+ */
+int eng_chunk_directory_get_nb_pinned (void);
+
+/**
+ * @brief Releases every pin, the chunks go to the chunk cache.
+ */
+void eng_chunk_directory_clear (void);
+
+#endif /* CHUNK_DIRECTORY_H_INCLUDED */
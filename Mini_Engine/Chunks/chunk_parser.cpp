@@ -0,0 +1,246 @@
+/*===========================================================================*/
+/* File: chunk_parser.cpp                                                    */
+/* Author: YOAN BERNATCHEZ                                                   */
+/* Created On: 2026-10-16                                                    */
+/* Developed Using: SDL2                                                     */
+/* Function: Provides the user with a single pass parser for the text chunk  */
+/*           format, which reads a chunk file only once.                     */
+/*===========================================================================*/
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "chunk.h"
+#include "chunk_parser.h"
+#include "objects.h"
+#include "tile.h"
+#include "../File_Utilities/file_utilities.h"
+
+/*---------------------------------------------------------------------------*/
+/* Local function prototypes                                                 */
+/*---------------------------------------------------------------------------*/
+
+/**
+ * @brief Searches a word in a buffer and returns the position directly after
+ *        it.
+ *
+ * @param cursor: Position in the buffer where the search begins.
+ * @param end:    End of the buffer.
+ * @param word:   The word to search.
+ *
+ * @return The position after the word or NULL if the word was not found.
+ */
+static const char * find_after_string (const char *cursor, const char *end,
+                                       const char *word);
+
+/**
+ * @brief Parses an integer from a buffer without using the stdio functions.
+ *        Spaces, line feeds and commas in front of the integer are skipped.
+ *
+ * @param cursor: Pointer to the current position in the buffer, advanced
+ *                after the integer on success.
+ * @param end:    End of the buffer.
+ * @param value:  Pointer receiving the integer.
+ *
+ * @return True if an integer was parsed, false otherwise (also when it does
+ *         not fit in an int).
+ */
+static bool parse_int (const char **cursor, const char *end, int *value);
+
+/**
+ * @brief Counts the objects of an object list by counting its separators.
+ *
+ * @param cursor: Position in the buffer directly after "objects{".
+ * @param end:    End of the buffer.
+ *
+ * @return The number of objects in the list.
+ */
+static int count_objects (const char *cursor, const char *end);
+
+/*---------------------------------------------------------------------------*/
+/* Chunk parser function implementations                                     */
+/*---------------------------------------------------------------------------*/
+
+/*
+ * Loads tile and object data to a chunk from its text chunk file. The file is
+ * opened and read once, then tiles and objects are parsed from memory.
+ */
+bool
+eng_chunk_parse_text_file (EngChunk *chunk, int *nb_values_parsed)
+{
+    bool result = false;
+    long size = 0;
+    const char *file_name =
+    eng_chunk_get_file_name (chunk->chunk_x, chunk->chunk_y);
+    char *buffer = eng_file_read_file (file_name, &size);
+
+    if (nb_values_parsed != NULL)
+        *nb_values_parsed = 0;
+
+    if (buffer != NULL) {
+        result = eng_chunk_parse_text_buffer (chunk, buffer, size,
+                                              nb_values_parsed);
+        free (buffer);
+    }
+    else {
+        /* Chunks without data are left empty instead of keeping old tiles. */
+        eng_tile_fill (chunk, 0);
+
+        printf ("Error: Could not open file %s\n", file_name);
+    }
+
+    free ((char*) file_name);
+
+    return result;
+}
+
+/*
+ * Fills a chunk with the tiles and objects found in the content of a text
+ * chunk file. Tiles are stored row by row after "tile{" and objects are
+ * stored as "id x y" separated by commas after "objects{".
+ */
+bool
+eng_chunk_parse_text_buffer (EngChunk *chunk, const char *buffer, long size,
+                             int *nb_values_parsed)
+{
+    const char *end = buffer + size;
+    const char *cursor = find_after_string (buffer, end, "tile{");
+    int32_t tile_id[TILESX * TILESY];
+    int nb_values = 0;
+    int nb_objects = 0;
+    int error = 0;
+    int value = 0;
+    int id = 0;
+    int x = 0;
+    int y = 0;
+
+    /* Retrieve and store tile ids. */
+    if (cursor != NULL) {
+        for (int i = 0; i < TILESX * TILESY; i++) {
+            if (parse_int (&cursor, end, &value)) {
+                tile_id[i] = value;
+                nb_values++;
+            }
+            else {
+                tile_id[i] = -1;
+                error++;
+            }
+        }
+
+        eng_tile_load_ids (chunk, tile_id);
+
+        /* Handle expected more tiles. */
+        if (error > 0)
+            printf ("%d tile id(s) could not be retrieved\n", error);
+    }
+    else {
+        printf ("Error: Could not locate \"tile{\" in chunk data\n");
+        error = TILESX * TILESY;
+        cursor = buffer;
+    }
+
+    /* Retrieve and store objects. */
+    cursor = find_after_string (cursor, end, "objects{");
+
+    if (cursor != NULL) {
+        nb_objects = count_objects (cursor, end);
+        eng_object_allocate (chunk, nb_objects);
+
+        for (int i = 0; i < nb_objects; i++) {
+            if (!parse_int (&cursor, end, &id) ||
+                !parse_int (&cursor, end, &x) ||
+                !parse_int (&cursor, end, &y)) {
+                /* Only the objects parsed before the bad one are kept. */
+                printf ("Error: object %d could not be retrieved\n", i);
+                eng_object_allocate (chunk, i);
+                error++;
+                break;
+            }
+
+            nb_values += 3;
+            chunk->object[i] = eng_object_create_object (id, x, y);
+        }
+    }
+    else {
+        printf ("Error: Could not locate \"objects{\" in chunk data\n");
+        eng_object_deallocate (chunk);
+    }
+
+    if (nb_values_parsed != NULL)
+        *nb_values_parsed = nb_values;
+
+    return error == 0;
+}
+
+/* Searches a word in a buffer and returns the position directly after it. */
+static const char *
+find_after_string (const char *cursor, const char *end, const char *word)
+{
+    int word_length = strlen (word);
+
+    for (/* Empty. */; cursor + word_length <= end; cursor++) {
+        if (*cursor == word[0] &&
+            memcmp (cursor, word, word_length) == 0) {
+            return cursor + word_length;
+        }
+    }
+
+    return NULL;
+}
+
+/* Parses an integer from a buffer without using the stdio functions. */
+static bool
+parse_int (const char **cursor, const char *end, int *value)
+{
+    const char *c = *cursor;
+    bool is_negative = false;
+    int number = 0;
+
+    /* Skip the separators left by the previous value. */
+    while (c < end && (*c == ' ' || *c == ',' || *c == '\n' || *c == '\r' ||
+                       *c == '\t')) {
+        c++;
+    }
+
+    if (c < end && *c == '-') {
+        is_negative = true;
+        c++;
+    }
+
+    /* A closing bracket or any other character means there is no value. */
+    if (c >= end || *c < '0' || *c > '9')
+        return false;
+
+    while (c < end && *c >= '0' && *c <= '9') {
+        /* Values that do not fit in an int are not values. */
+        if (number > (INT_MAX - (*c - '0')) / 10)
+            return false;
+
+        number = number * 10 + (*c - '0');
+        c++;
+    }
+
+    *value = is_negative ? -number : number;
+    *cursor = c;
+
+    return true;
+}
+
+/* Counts the objects of an object list by counting its separators. */
+static int
+count_objects (const char *cursor, const char *end)
+{
+    int nb_commas = 0;
+    bool is_empty = true;
+
+    for (/* Empty. */; cursor < end && *cursor != '}'; cursor++) {
+        if (*cursor == ',')
+            nb_commas++;
+        else if (*cursor != ' ' && *cursor != '\n' && *cursor != '\r' &&
+                 *cursor != '\t')
+            is_empty = false;
+    }
+
+    return is_empty ? 0 : nb_commas + 1;
+}
@@ -0,0 +1,41 @@
+#ifndef CHUNK_PARSER_H_INCLUDED
+#define CHUNK_PARSER_H_INCLUDED
+
+#include <stdbool.h>
+#include "../Engine/globals.h"
+
+/**
+ * @brief Loads tile and object data to a chunk from its text chunk file. The
+ *        file is opened and read once, then tiles and objects are parsed from
+ *        memory in a single pass.
+ *
+ * @param chunk:            Chunk to store data to (chunk_x and chunk_y select
+ *                          the file).
+ * @param nb_values_parsed: Pointer receiving the number of integers parsed
+ *                          from the file (can be NULL).
+ *
+ * @return True if the file was found and all of its tiles were retrieved,
+ *         false otherwise.
+ *
+ * @sa eng_chunk_parse_text_buffer ()
+ */
+bool eng_chunk_parse_text_file (EngChunk *chunk, int *nb_values_parsed);
+
+/**
+ * @brief Fills a chunk with the tiles and objects found in the content of a
+ *        text chunk file.
+ *
+ * @param chunk:            Chunk to store data to.
+ * @param buffer:           Content of a text chunk file.
+ * @param size:             Size of the content in bytes.
+ * @param nb_values_parsed: Pointer receiving the number of integers parsed
+ *                          from the buffer (can be NULL).
+ *
+ * @return True if all the tiles were retrieved, false otherwise.
+ *
+ * @sa eng_chunk_parse_text_file ()
+ */
+bool eng_chunk_parse_text_buffer (EngChunk *chunk, const char *buffer,
+                                  long size, int *nb_values_parsed);
+
+#endif /* CHUNK_PARSER_H_INCLUDED */
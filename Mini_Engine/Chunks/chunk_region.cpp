@@ -0,0 +1,579 @@
+/*===========================================================================*/
+/* File: chunk_region.cpp                                                    */
+/* Author: YOAN BERNATCHEZ                                                   */
+/* Created On: 2026-10-16                                                    */
+/* Developed Using: SDL2                                                     */
+/* Function: Provides the user with region files, which pack the chunks of a */
+/*           block of ENG_REGION_SIZE by ENG_REGION_SIZE chunks in one file. */
+/*===========================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <SDL.h>
+#include "chunk.h"
+#include "chunk_binary.h"
+#include "chunk_parser.h"
+#include "chunk_region.h"
+#include "objects.h"
+#include "../File_Utilities/file_utilities.h"
+
+/*
+ * Layout of a region file (all values are 32 bit integers stored in the byte
+ * order of the machine that wrote them):
+ *
+ * - Header: "ENGR", version, ENG_REGION_SIZE, TILESX, TILESY.
+ * - Table:  offset and length of every chunk of the region, row by row. A
+ *           length of 0 means the chunk is not in the region.
+ * - Data:   content of a binary chunk file for every chunk of the table.
+ */
+
+/* Local structures. */
+typedef struct _RegionFileHeader {
+    char magic[4];
+    int32_t version;
+    int32_t region_size;
+    int32_t tiles_x;
+    int32_t tiles_y;
+} RegionFileHeader;
+/**< Header found at the start of every region file. */
+
+typedef struct _RegionEntry {
+    int32_t offset;
+    int32_t length;
+} RegionEntry;
+/**< Position of the data of a chunk in a region file. */
+
+typedef struct _MappedRegion {
+    int region_x;
+    int region_y;
+    unsigned int last_use;
+    int nb_users;
+    bool is_stale;
+
+    EngFileMapping mapping;
+} MappedRegion;
+/**<
+ * Region file kept mapped in memory between chunk loads. A mapping in use by
+ * a thread is never replaced, a stale mapping is released by its last user.
+ */
+
+/** Region files kept mapped, the system page cache holds their content. */
+static MappedRegion mapped_region[ENG_REGION_MAX_MAPPED];
+
+/** Counter giving the order in which mapped regions were used. */
+static unsigned int mapped_use = 0;
+
+/**
+ * Lock protecting the mapped regions. It is only held to find, pin or
+ * release a mapping, files are mapped and chunks decoded outside of it.
+ */
+static SDL_SpinLock mapped_lock = 0;
+
+/*---------------------------------------------------------------------------*/
+/* Local function prototypes                                                 */
+/*---------------------------------------------------------------------------*/
+
+/**
+ * @brief Returns the index of the table entry of a chunk in its region file.
+ *
+ * @param chunk_x: The chunk in x.
+ * @param chunk_y: The chunk in y.
+ *
+ * @return The index of the entry.
+ */
+static int get_entry_index (int chunk_x, int chunk_y);
+
+/**
+ * @brief Loads a chunk from its own binary or text chunk file.
+ *
+ * @param chunk: Chunk to store data to.
+ *
+ * @return True if one of the chunk files existed, false otherwise.
+ */
+static bool load_chunk_file (EngChunk *chunk);
+
+/**
+ * @brief Deletes the binary and text chunk files of the chunks packed in a
+ *        region, so that they are loaded from the region file.
+ *
+ * @param region_x: The region in x.
+ * @param region_y: The region in y.
+ * @param entry:    Table of the region, chunks with a length were packed.
+ */
+static void remove_loose_files (int region_x, int region_y,
+                                const RegionEntry entry[]);
+
+/**
+ * @brief Returns a mapped region file and pins it, mapping it in place of the
+ *        least recently used mapping that is not in use if needed.
+ *
+ * @param region_x: The region in x.
+ * @param region_y: The region in y.
+ *
+ * @return The mapped region, or NULL if its file could not be mapped or if
+ *         every mapping is in use.
+ *
+ * @sa release_mapped_region ()
+ */
+static MappedRegion * acquire_mapped_region (int region_x, int region_y);
+
+/**
+ * @brief Unpins a mapped region file, unmapping it if it became stale while
+ *        it was in use.
+ *
+ * @param region: Mapped region returned by acquire_mapped_region ().
+ */
+static void release_mapped_region (MappedRegion *region);
+
+/**
+ * @brief Searches the mappings for a region file that is still valid. Must
+ *        be called with mapped_lock.
+ *
+ * @param region_x: The region in x.
+ * @param region_y: The region in y.
+ *
+ * @return The mapped region or NULL if the region is not mapped.
+ */
+static MappedRegion * find_mapped_region (int region_x, int region_y);
+
+/**
+ * @brief Loads a chunk from the memory of a mapped region file.
+ *
+ * @param chunk:   Chunk to store data to.
+ * @param mapping: Mapping of the region file containing the chunk.
+ *
+ * @return True if the region contained the chunk, false otherwise.
+ */
+static bool load_mapped_chunk (EngChunk *chunk,
+                               const EngFileMapping *mapping);
+
+/**
+ * @brief Loads a chunk from its region file with reads, used when the region
+ *        file cannot be mapped.
+ *
+ * @param chunk: Chunk to store data to.
+ *
+ * @return True if the region contained the chunk, false otherwise.
+ */
+static bool read_chunk (EngChunk *chunk);
+
+/**
+ * @brief Checks that a region file header was written for this build.
+ *
+ * @param header: The header to check.
+ *
+ * @return True if the header is valid, false otherwise.
+ */
+static bool is_header_valid (const RegionFileHeader *header);
+
+/*---------------------------------------------------------------------------*/
+/* Region function implementations                                           */
+/*---------------------------------------------------------------------------*/
+
+/*
+ * Loads tile and object data to a chunk from the region file that contains
+ * it. The chunk is decoded directly from the mapped region file, only the
+ * pages holding its table entry and data are brought in by the system. When
+ * the file cannot be mapped, the entry and the data are read at their
+ * position in the file instead.
+ */
+bool
+eng_chunk_region_load (EngChunk *chunk)
+{
+    bool result = false;
+    int region_x = eng_chunk_region_get_region (chunk->chunk_x);
+    int region_y = eng_chunk_region_get_region (chunk->chunk_y);
+
+    /*
+     * The streamer thread loads chunks too, mappings are shared. The mapping
+     * stays pinned while the chunk is decoded, so both threads can decode at
+     * the same time.
+     */
+    MappedRegion *region = acquire_mapped_region (region_x, region_y);
+
+    if (region != NULL) {
+        result = load_mapped_chunk (chunk, &region->mapping);
+        release_mapped_region (region);
+    }
+    else
+        result = read_chunk (chunk);
+
+    return result;
+}
+
+/*
+ * Releases every region file kept mapped in memory. Mappings in use are
+ * released by their last user instead.
+ */
+void
+eng_chunk_region_unmap_all (void)
+{
+    SDL_AtomicLock (&mapped_lock);
+
+    for (int i = 0; i < ENG_REGION_MAX_MAPPED; i++) {
+        if (mapped_region[i].nb_users > 0)
+            mapped_region[i].is_stale = true;
+        else
+            eng_file_unmap_file (&mapped_region[i].mapping);
+    }
+
+    SDL_AtomicUnlock (&mapped_lock);
+}
+
+/*
+ * Packs the chunk files of the chunks of a region in a single region file.
+ * Every chunk is encoded in memory first, so the offsets of the table are
+ * known before the file is written.
+ */
+int
+eng_chunk_region_pack (int region_x, int region_y, bool remove_loose)
+{
+    int nb_entries = ENG_REGION_SIZE * ENG_REGION_SIZE;
+    int nb_chunks = 0;
+    long offset = sizeof(RegionFileHeader) + nb_entries * sizeof(RegionEntry);
+    long size = 0;
+    bool is_written = true;
+    RegionFileHeader header = {{'E', 'N', 'G', 'R'}, ENG_REGION_VERSION,
+                               ENG_REGION_SIZE, TILESX, TILESY};
+    RegionEntry *entry = (RegionEntry*) calloc (nb_entries,
+                                                sizeof(RegionEntry));
+    char **data = (char**) calloc (nb_entries, sizeof(char*));
+    EngChunk chunk = eng_chunk_create_chunk ();
+    const char *file_name = NULL;
+    FILE *file = NULL;
+
+    if (entry == NULL || data == NULL) {
+        free (entry);
+        free (data);
+        return 0;
+    }
+
+    /* Encode every chunk of the region that has a chunk file. */
+    for (int y = 0; y < ENG_REGION_SIZE; y++) {
+        for (int x = 0; x < ENG_REGION_SIZE; x++) {
+            chunk.chunk_x = region_x * ENG_REGION_SIZE + x;
+            chunk.chunk_y = region_y * ENG_REGION_SIZE + y;
+
+            if (load_chunk_file (&chunk)) {
+                data[x + y * ENG_REGION_SIZE] =
+                eng_chunk_binary_encode (&chunk, ENG_COMPRESSION_AUTO,
+                                         &size);
+                entry[x + y * ENG_REGION_SIZE].offset = offset;
+                entry[x + y * ENG_REGION_SIZE].length = size;
+                offset += size;
+                nb_chunks++;
+            }
+
+            eng_chunk_destroy (&chunk);
+        }
+    }
+
+    /* Write the header, the table and the data of the chunks in order. */
+    if (nb_chunks > 0) {
+        /* A mapped region file cannot be replaced on every platform. */
+        eng_chunk_region_unmap_all ();
+
+        file_name = eng_chunk_region_get_file_name (region_x, region_y);
+        file = fopen (file_name, "wb");
+
+        is_written = file != NULL &&
+                     fwrite (&header, sizeof(RegionFileHeader), 1, file) == 1 &&
+                     fwrite (entry, sizeof(RegionEntry), nb_entries, file) ==
+                     (size_t) nb_entries;
+
+        for (int i = 0; i < nb_entries && is_written; i++) {
+            if (entry[i].length > 0) {
+                is_written = data[i] != NULL &&
+                             fwrite (data[i], 1, entry[i].length, file) ==
+                             (size_t) entry[i].length;
+            }
+        }
+
+        file = eng_file_close_file (file);
+
+        if (!is_written) {
+            printf ("Error: could not write region file %s\n", file_name);
+            remove (file_name);
+            nb_chunks = 0;
+        }
+        else if (remove_loose)
+            remove_loose_files (region_x, region_y, entry);
+
+        free ((char*) file_name);
+    }
+
+    for (int i = 0; i < nb_entries; i++)
+        free (data[i]);
+
+    free (data);
+    free (entry);
+
+    return nb_chunks;
+}
+
+/* Returns the region that contains a chunk, in x or in y. */
+int
+eng_chunk_region_get_region (int chunk)
+{
+    /* Round toward negative infinity so chunk -1 is in region -1. */
+    if (chunk < 0)
+        return (chunk + 1) / ENG_REGION_SIZE - 1;
+
+    return chunk / ENG_REGION_SIZE;
+}
+
+/* Returns a file name corresponding to the directory of a region file. */
+const char *
+eng_chunk_region_get_file_name (int region_x, int region_y)
+{
+    char file_name[48];
+
+    snprintf (file_name, 48, "Demo/chunks/region%d,%d.reg", region_x,
+              region_y);
+
+    return strdup (file_name);
+}
+
+/* Returns the index of the table entry of a chunk in its region file. */
+static int
+get_entry_index (int chunk_x, int chunk_y)
+{
+    int x = chunk_x - eng_chunk_region_get_region (chunk_x) * ENG_REGION_SIZE;
+    int y = chunk_y - eng_chunk_region_get_region (chunk_y) * ENG_REGION_SIZE;
+
+    return x + y * ENG_REGION_SIZE;
+}
+
+/* Deletes the binary and text chunk files of the chunks packed in a region. */
+static void
+remove_loose_files (int region_x, int region_y, const RegionEntry entry[])
+{
+    int chunk_x = 0;
+    int chunk_y = 0;
+    const char *file_name = NULL;
+
+    for (int i = 0; i < ENG_REGION_SIZE * ENG_REGION_SIZE; i++) {
+        if (entry[i].length > 0) {
+            chunk_x = region_x * ENG_REGION_SIZE + i % ENG_REGION_SIZE;
+            chunk_y = region_y * ENG_REGION_SIZE + i / ENG_REGION_SIZE;
+            file_name = eng_chunk_get_file_name (chunk_x, chunk_y);
+
+            eng_chunk_binary_remove (chunk_x, chunk_y);
+            remove (file_name);
+
+            free ((char*) file_name);
+        }
+    }
+}
+
+/* Loads a chunk from its own binary or text chunk file. */
+static bool
+load_chunk_file (EngChunk *chunk)
+{
+    bool result = eng_chunk_binary_load (chunk);
+    long size = 0;
+    char *buffer = NULL;
+    const char *file_name = NULL;
+
+    if (!result) {
+        file_name = eng_chunk_get_file_name (chunk->chunk_x, chunk->chunk_y);
+        buffer = eng_file_read_file (file_name, &size);
+
+        if (buffer != NULL) {
+            eng_chunk_parse_text_buffer (chunk, buffer, size, NULL);
+            free (buffer);
+            result = true;
+        }
+
+        free ((char*) file_name);
+    }
+
+    return result;
+}
+
+/*
+ * Returns a mapped region file and pins it. A region that is not mapped yet
+ * is mapped outside of the lock, then put in place of the least recently
+ * used mapping that is not in use.
+ */
+static MappedRegion *
+acquire_mapped_region (int region_x, int region_y)
+{
+    MappedRegion *region = NULL;
+    EngFileMapping mapping = {NULL, 0, NULL};
+    EngFileMapping evicted = {NULL, 0, NULL};
+    const char *file_name = NULL;
+
+    SDL_AtomicLock (&mapped_lock);
+    region = find_mapped_region (region_x, region_y);
+
+    if (region != NULL)
+        region->nb_users++;
+
+    SDL_AtomicUnlock (&mapped_lock);
+
+    if (region != NULL)
+        return region;
+
+    file_name = eng_chunk_region_get_file_name (region_x, region_y);
+
+    if (!eng_file_map_file (file_name, &mapping)) {
+        free ((char*) file_name);
+        return NULL;
+    }
+
+    free ((char*) file_name);
+
+    SDL_AtomicLock (&mapped_lock);
+
+    /* The other thread may have mapped the same region in the meantime. */
+    region = find_mapped_region (region_x, region_y);
+
+    if (region == NULL) {
+        for (int i = 0; i < ENG_REGION_MAX_MAPPED; i++) {
+            if (mapped_region[i].nb_users == 0 &&
+                (region == NULL ||
+                 mapped_region[i].last_use < region->last_use)) {
+                region = &mapped_region[i];
+            }
+        }
+
+        if (region != NULL) {
+            evicted = region->mapping;
+            region->mapping = mapping;
+            region->region_x = region_x;
+            region->region_y = region_y;
+            region->last_use = mapped_use;
+            region->is_stale = false;
+            mapping.data = NULL;
+        }
+    }
+
+    if (region != NULL)
+        region->nb_users++;
+
+    SDL_AtomicUnlock (&mapped_lock);
+
+    /* The replaced mapping and an unused new mapping are released unlocked. */
+    eng_file_unmap_file (&evicted);
+    eng_file_unmap_file (&mapping);
+
+    return region;
+}
+
+/* Unpins a mapped region file, unmapping it if it became stale. */
+static void
+release_mapped_region (MappedRegion *region)
+{
+    EngFileMapping stale = {NULL, 0, NULL};
+
+    SDL_AtomicLock (&mapped_lock);
+    region->nb_users--;
+
+    if (region->nb_users == 0 && region->is_stale) {
+        stale = region->mapping;
+        region->mapping.data = NULL;
+        region->mapping.size = 0;
+        region->mapping.handle = NULL;
+        region->is_stale = false;
+    }
+
+    SDL_AtomicUnlock (&mapped_lock);
+
+    eng_file_unmap_file (&stale);
+}
+
+/* Searches the mappings for a region file that is still valid. */
+static MappedRegion *
+find_mapped_region (int region_x, int region_y)
+{
+    mapped_use++;
+
+    for (int i = 0; i < ENG_REGION_MAX_MAPPED; i++) {
+        if (mapped_region[i].mapping.data != NULL &&
+            !mapped_region[i].is_stale &&
+            mapped_region[i].region_x == region_x &&
+            mapped_region[i].region_y == region_y) {
+            mapped_region[i].last_use = mapped_use;
+            return &mapped_region[i];
+        }
+    }
+
+    return NULL;
+}
+
+/* Loads a chunk from the memory of a mapped region file. */
+static bool
+load_mapped_chunk (EngChunk *chunk, const EngFileMapping *mapping)
+{
+    RegionFileHeader header;
+    RegionEntry entry;
+    long entry_offset = sizeof(RegionFileHeader) +
+                        get_entry_index (chunk->chunk_x, chunk->chunk_y) *
+                        sizeof(RegionEntry);
+
+    if (mapping->size < entry_offset + (long) sizeof(RegionEntry))
+        return false;
+
+    memcpy (&header, mapping->data, sizeof(RegionFileHeader));
+    memcpy (&entry, mapping->data + entry_offset, sizeof(RegionEntry));
+
+    if (!is_header_valid (&header) || entry.length <= 0 ||
+        entry.offset < 0 || entry.offset > mapping->size - entry.length) {
+        return false;
+    }
+
+    return eng_chunk_binary_decode (chunk, mapping->data + entry.offset,
+                                    entry.length);
+}
+
+/*
+ * Loads a chunk from its region file with reads. The header, the table entry
+ * and the data of the chunk are each read at their position in the file.
+ */
+static bool
+read_chunk (EngChunk *chunk)
+{
+    bool result = false;
+    char *buffer = NULL;
+    RegionFileHeader header;
+    RegionEntry entry = {0, 0};
+    const char *file_name = eng_chunk_region_get_file_name (
+                            eng_chunk_region_get_region (chunk->chunk_x),
+                            eng_chunk_region_get_region (chunk->chunk_y));
+    FILE *file = eng_file_open (file_name, "rb");
+
+    if (file != NULL &&
+        eng_file_read_at (file, 0, &header, sizeof(RegionFileHeader)) &&
+        is_header_valid (&header) &&
+        eng_file_read_at (file, sizeof(RegionFileHeader) +
+                          get_entry_index (chunk->chunk_x, chunk->chunk_y) *
+                          sizeof(RegionEntry), &entry, sizeof(RegionEntry)) &&
+        entry.length > 0) {
+        buffer = (char*) malloc (entry.length);
+
+        if (buffer != NULL &&
+            eng_file_read_at (file, entry.offset, buffer, entry.length)) {
+            result = eng_chunk_binary_decode (chunk, buffer, entry.length);
+        }
+
+        free (buffer);
+    }
+
+    file = eng_file_close_file (file);
+    free ((char*) file_name);
+
+    return result;
+}
+
+/* Checks that a region file header was written for this build. */
+static bool
+is_header_valid (const RegionFileHeader *header)
+{
+    return memcmp (header->magic, "ENGR", 4) == 0 &&
+           header->version == ENG_REGION_VERSION &&
+           header->region_size == ENG_REGION_SIZE &&
+           header->tiles_x == TILESX && header->tiles_y == TILESY;
+}
@@ -0,0 +1,71 @@
+#ifndef CHUNK_REGION_H_INCLUDED
+#define CHUNK_REGION_H_INCLUDED
+
+#include <stdbool.h>
+#include "../Engine/globals.h"
+
+/** Number of chunks in x and in y packed in a region file. */
+#define ENG_REGION_SIZE 32
+
+/** Version of the region format written by eng_chunk_region_pack (). */
+#define ENG_REGION_VERSION 2
+
+/** Number of region files kept mapped in memory at the same time. */
+#define ENG_REGION_MAX_MAPPED 4
+
+/**
+ * @brief Loads tile and object data to a chunk from the region file that
+ *        contains it. The region file is kept mapped in memory, so the chunk
+ *        is decoded from the mapped pages without any read.
+ *
+ * @param chunk: Chunk to store data to (chunk_x and chunk_y select the
+ *               region and the entry), its objects must have been freed.
+ *
+ * @return True if the region file contained the chunk, false otherwise.
+ *
+ * @sa eng_chunk_region_pack ()
+ */
+bool eng_chunk_region_load (EngChunk *chunk);
+
+/**
+ * @brief Releases every region file kept mapped in memory. Must be called
+ *        before exiting and before a region file is replaced.
+ */
+void eng_chunk_region_unmap_all (void);
+
+/**
+ * @brief Packs the chunk files (binary or text) of the chunks of a region in
+ *        a single region file, made of a table of offsets and lengths
+ *        followed by the binary data of every chunk. Loose chunk files take
+ *        precedence over the region file, so they are only loaded from the
+ *        region once their loose files are removed.
+ *
+ * @param region_x:     The region in x to pack.
+ * @param region_y:     The region in y to pack.
+ * @param remove_loose: True to delete the chunk files that were packed once
+ *                      the region file is written.
+ *
+ * @return The number of chunks packed, 0 if no region file was written.
+ */
+int eng_chunk_region_pack (int region_x, int region_y, bool remove_loose);
+
+/**
+ * @brief Returns the region that contains a chunk, in x or in y.
+ *
+ * @param chunk: The chunk in x or in y.
+ *
+ * @return The region in x or in y.
+ */
+int eng_chunk_region_get_region (int chunk);
+
+/**
+ * @brief Returns a file name corresponding to the directory of a region file.
+ *
+ * @param region_x: The region in x which we are trying to get the file name of.
+ * @param region_y: The region in y which we are trying to get the file name of.
+ *
+ * @return A string containing the directory of the wanted region file.
+ */
+const char * eng_chunk_region_get_file_name (int region_x, int region_y);
+
+#endif /* CHUNK_REGION_H_INCLUDED */
@@ -0,0 +1,405 @@
+/*===========================================================================*/
+/* File: chunk_streamer.cpp                                                  */
+/* Author: YOAN BERNATCHEZ                                                   */
+/* Created On: 2026-10-16                                                    */
+/* Developed Using: SDL2                                                     */
+/* Function: Provides the user with a thread that reads and parses chunks in */
+/*           the background, so the main thread never waits for a file.     */
+/*===========================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <SDL.h>
+#include "chunk.h"
+#include "chunk_cache.h"
+#include "chunk_streamer.h"
+#include "objects.h"
+#include "tile.h"
+
+/** States of a chunk handled by the chunk streamer. */
+enum StreamState {STREAM_FREE, STREAM_REQUESTED, STREAM_LOADING,
+                  STREAM_LOADED};
+
+/* Local structures. */
+typedef struct _StreamSlot {
+    int chunk_x;
+    int chunk_y;
+    int state;
+    int order;
+    EngChunk *chunk;
+} StreamSlot;
+/**<
+ * Chunk requested to the chunk streamer. The order keeps requests first in,
+ * first out and the chunk is set once the thread has loaded it.
+ */
+
+/* Local variables, the slots and the statistics are guarded by the mutex. */
+static SDL_Thread *stream_thread = NULL;
+static SDL_mutex *stream_mutex = NULL;
+static SDL_cond *stream_cond = NULL;
+static bool is_stopping = false;
+static int nb_orders = 0;
+static StreamSlot slot[ENG_CHUNK_STREAMER_QUEUE_SIZE];
+static EngChunkStreamerStats stream_stats = {0, 0, 0, 0};
+
+/*---------------------------------------------------------------------------*/
+/* Local function prototypes                                                 */
+/*---------------------------------------------------------------------------*/
+
+/**
+ * @brief Main function of the chunk streamer thread. Loads the requested
+ *        chunks one at a time until the streamer is stopped.
+ *
+ * @param data: Unused.
+ *
+ * @return 0 when the thread ends.
+ */
+static int stream_chunks (void *data);
+
+/**
+ * @brief Returns the oldest requested chunk. The mutex must be locked.
+ *
+ * @return The index of the slot of the oldest request, -1 if there is none.
+ */
+static int get_next_request (void);
+
+/**
+ * @brief Searches a chunk in the slots of the streamer. The mutex must be
+ *        locked.
+ *
+ * @param chunk_x: The chunk in x to search.
+ * @param chunk_y: The chunk in y to search.
+ *
+ * @return The index of the slot of the chunk, -1 if it is not found.
+ */
+static int find_slot (int chunk_x, int chunk_y);
+
+/*---------------------------------------------------------------------------*/
+/* Chunk streamer function implementations                                   */
+/*---------------------------------------------------------------------------*/
+
+/* Starts the thread that loads chunks in the background. */
+bool
+eng_chunk_streamer_start (void)
+{
+    if (stream_thread != NULL)
+        return true;
+
+    for (int i = 0; i < ENG_CHUNK_STREAMER_QUEUE_SIZE; i++) {
+        slot[i].state = STREAM_FREE;
+        slot[i].chunk = NULL;
+    }
+
+    is_stopping = false;
+    stream_mutex = SDL_CreateMutex ();
+    stream_cond = SDL_CreateCond ();
+
+    if (stream_mutex != NULL && stream_cond != NULL) {
+        stream_thread = SDL_CreateThread (stream_chunks, "chunk_streamer",
+                                          NULL);
+    }
+
+    if (stream_thread == NULL) {
+        printf ("Error: could not start the chunk streamer thread\n");
+        SDL_DestroyCond (stream_cond);
+        SDL_DestroyMutex (stream_mutex);
+        stream_cond = NULL;
+        stream_mutex = NULL;
+    }
+
+    return stream_thread != NULL;
+}
+
+/*
+ * Stops the chunk streamer thread and frees the chunks it still holds. The
+ * thread finishes the chunk it is loading before it stops.
+ */
+void
+eng_chunk_streamer_stop (void)
+{
+    if (stream_thread == NULL)
+        return;
+
+    SDL_LockMutex (stream_mutex);
+    is_stopping = true;
+    SDL_CondSignal (stream_cond);
+    SDL_UnlockMutex (stream_mutex);
+
+    SDL_WaitThread (stream_thread, NULL);
+    stream_thread = NULL;
+
+    for (int i = 0; i < ENG_CHUNK_STREAMER_QUEUE_SIZE; i++) {
+        if (slot[i].chunk != NULL) {
+            eng_chunk_destroy (slot[i].chunk);
+            free (slot[i].chunk);
+            slot[i].chunk = NULL;
+        }
+
+        slot[i].state = STREAM_FREE;
+    }
+
+    SDL_DestroyCond (stream_cond);
+    SDL_DestroyMutex (stream_mutex);
+    stream_cond = NULL;
+    stream_mutex = NULL;
+}
+
+/* Returns true if the chunk streamer thread is running. */
+bool
+eng_chunk_streamer_is_running (void)
+{
+    return stream_thread != NULL;
+}
+
+/*
+ * Asks the chunk streamer thread to load a chunk. Chunks already requested,
+ * loading or loaded are not requested twice.
+ */
+bool
+eng_chunk_streamer_request (int chunk_x, int chunk_y)
+{
+    bool result = false;
+    int index = -1;
+
+    if (stream_thread == NULL)
+        return false;
+
+    SDL_LockMutex (stream_mutex);
+
+    if (find_slot (chunk_x, chunk_y) >= 0)
+        result = true;
+    else {
+        for (int i = 0; i < ENG_CHUNK_STREAMER_QUEUE_SIZE && index < 0; i++) {
+            if (slot[i].state == STREAM_FREE)
+                index = i;
+        }
+
+        if (index >= 0) {
+            slot[index].chunk_x = chunk_x;
+            slot[index].chunk_y = chunk_y;
+            slot[index].state = STREAM_REQUESTED;
+            slot[index].order = nb_orders++;
+            stream_stats.nb_requests++;
+            SDL_CondSignal (stream_cond);
+            result = true;
+        }
+    }
+
+    SDL_UnlockMutex (stream_mutex);
+
+    return result;
+}
+
+/* Checks if a chunk was requested to the chunk streamer and not collected. */
+bool
+eng_chunk_streamer_is_requested (int chunk_x, int chunk_y)
+{
+    bool result = false;
+
+    if (stream_thread != NULL) {
+        SDL_LockMutex (stream_mutex);
+        result = find_slot (chunk_x, chunk_y) >= 0;
+        SDL_UnlockMutex (stream_mutex);
+    }
+
+    return result;
+}
+
+/*
+ * Moves a chunk loaded by the chunk streamer thread into a chunk of the main
+ * thread. The objects are moved along with the tiles.
+ */
+bool
+eng_chunk_streamer_collect (EngChunk *chunk)
+{
+    bool result = false;
+    int index = -1;
+
+    if (stream_thread == NULL)
+        return false;
+
+    SDL_LockMutex (stream_mutex);
+    index = find_slot (chunk->chunk_x, chunk->chunk_y);
+
+    if (index >= 0 && slot[index].state == STREAM_LOADED) {
+        eng_tile_move_tiles (chunk, slot[index].chunk);
+
+        chunk->nb_objects = slot[index].chunk->nb_objects;
+        chunk->object = slot[index].chunk->object;
+
+        free (slot[index].chunk);
+        slot[index].chunk = NULL;
+        slot[index].state = STREAM_FREE;
+        stream_stats.nb_collected++;
+        result = true;
+    }
+
+    SDL_UnlockMutex (stream_mutex);
+
+    return result;
+}
+
+/*
+ * Moves every chunk loaded by the chunk streamer thread and not collected into
+ * the chunk cache, which frees the slots for new requests.
+ */
+void
+eng_chunk_streamer_store_loaded (void)
+{
+    if (stream_thread == NULL)
+        return;
+
+    SDL_LockMutex (stream_mutex);
+
+    for (int i = 0; i < ENG_CHUNK_STREAMER_QUEUE_SIZE; i++) {
+        if (slot[i].state == STREAM_LOADED) {
+            eng_chunk_cache_store (slot[i].chunk);
+            free (slot[i].chunk);
+            slot[i].chunk = NULL;
+            slot[i].state = STREAM_FREE;
+        }
+    }
+
+    SDL_UnlockMutex (stream_mutex);
+}
+
+/*
+ * Fills a chunk with placeholder tiles that have collision, so characters do
+ * not walk into a chunk that has not been loaded yet.
+ */
+void
+eng_chunk_streamer_set_placeholder (EngChunk *chunk)
+{
+    /* A chunk without tiles reads as ENG_CHUNK_PLACEHOLDER_ID (0). */
+    eng_tile_deallocate_tiles (chunk);
+
+    memset (chunk->tile_collision, 0xFF, sizeof(chunk->tile_collision));
+    eng_clearance_mark_chunk (chunk);
+
+    chunk->nb_objects = 0;
+    chunk->object = NULL;
+    chunk->is_placeholder = true;
+
+    if (stream_mutex != NULL)
+        SDL_LockMutex (stream_mutex);
+
+    stream_stats.nb_placeholders++;
+
+    if (stream_mutex != NULL)
+        SDL_UnlockMutex (stream_mutex);
+}
+
+/* Returns the counters of the chunk streamer since the last reset. */
+EngChunkStreamerStats
+eng_chunk_streamer_get_stats (void)
+{
+    EngChunkStreamerStats stats;
+
+    if (stream_mutex != NULL)
+        SDL_LockMutex (stream_mutex);
+
+    stats = stream_stats;
+
+    if (stream_mutex != NULL)
+        SDL_UnlockMutex (stream_mutex);
+
+    return stats;
+}
+
+/* Resets the counters of the chunk streamer to zero. */
+void
+eng_chunk_streamer_reset_stats (void)
+{
+    if (stream_mutex != NULL)
+        SDL_LockMutex (stream_mutex);
+
+    stream_stats.nb_requests = 0;
+    stream_stats.nb_loaded = 0;
+    stream_stats.nb_collected = 0;
+    stream_stats.nb_placeholders = 0;
+
+    if (stream_mutex != NULL)
+        SDL_UnlockMutex (stream_mutex);
+}
+
+/*
+ * Main function of the chunk streamer thread. The mutex is released while a
+ * chunk is read and parsed, so the main thread is never blocked by a file.
+ */
+static int
+stream_chunks (void *data)
+{
+    EngChunk *chunk = NULL;
+    int index = -1;
+
+    (void) data;
+
+    SDL_LockMutex (stream_mutex);
+
+    while (!is_stopping) {
+        index = get_next_request ();
+
+        if (index < 0) {
+            SDL_CondWait (stream_cond, stream_mutex);
+            continue;
+        }
+
+        slot[index].state = STREAM_LOADING;
+        SDL_UnlockMutex (stream_mutex);
+
+        chunk = (EngChunk*) malloc (sizeof(EngChunk));
+
+        if (chunk != NULL) {
+            *chunk = eng_chunk_create_chunk ();
+            chunk->chunk_x = slot[index].chunk_x;
+            chunk->chunk_y = slot[index].chunk_y;
+
+            eng_chunk_read_chunk (chunk, NULL);
+        }
+
+        SDL_LockMutex (stream_mutex);
+
+        if (chunk != NULL) {
+            slot[index].chunk = chunk;
+            slot[index].state = STREAM_LOADED;
+            stream_stats.nb_loaded++;
+        }
+        else
+            slot[index].state = STREAM_FREE;
+    }
+
+    SDL_UnlockMutex (stream_mutex);
+
+    return 0;
+}
+
+/* Returns the oldest requested chunk. */
+static int
+get_next_request (void)
+{
+    int index = -1;
+
+    for (int i = 0; i < ENG_CHUNK_STREAMER_QUEUE_SIZE; i++) {
+        if (slot[i].state == STREAM_REQUESTED &&
+            (index < 0 || slot[i].order < slot[index].order)) {
+            index = i;
+        }
+    }
+
+    return index;
+}
+
+/* Searches a chunk in the slots of the streamer. */
+static int
+find_slot (int chunk_x, int chunk_y)
+{
+    for (int i = 0; i < ENG_CHUNK_STREAMER_QUEUE_SIZE; i++) {
+        if (slot[i].state != STREAM_FREE && slot[i].chunk_x == chunk_x &&
+            slot[i].chunk_y == chunk_y) {
+            return i;
+        }
+    }
+
+    return -1;
+}
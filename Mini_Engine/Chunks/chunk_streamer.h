@@ -0,0 +1,109 @@
+#ifndef CHUNK_STREAMER_H_INCLUDED
+#define CHUNK_STREAMER_H_INCLUDED
+
+#include <stdbool.h>
+#include "../Engine/globals.h"
+
+/** Maximum number of chunks requested, loading or waiting to be collected. */
+#define ENG_CHUNK_STREAMER_QUEUE_SIZE 16
+
+/** Tile id given to the tiles of a chunk that is still being loaded. */
+#define ENG_CHUNK_PLACEHOLDER_ID 0
+
+typedef struct _EngChunkStreamerStats {
+    int nb_requests;
+    int nb_loaded;
+    int nb_collected;
+    int nb_placeholders;
+} EngChunkStreamerStats;
+/**<
+ * Structure containing the number of chunks requested to the chunk streamer,
+ * loaded by its thread, collected by the main thread and the number of
+ * placeholders shown while waiting.
+ */
+
+/**
+ * @brief Starts the thread that loads chunks in the background. Once started,
+ *        eng_chunk_load_chunk () no longer reads files on the calling thread.
+ *
+ * @return True if the thread is running, false otherwise.
+ *
+ * @sa eng_chunk_streamer_stop ()
+ */
+bool eng_chunk_streamer_start (void);
+
+/**
+ * @brief Stops the chunk streamer thread and frees the chunks it still holds.
+ *
+ * @sa eng_chunk_streamer_start ()
+ */
+void eng_chunk_streamer_stop (void);
+
+/**
+ * @return True if the chunk streamer thread is running, false otherwise.
+ */
+bool eng_chunk_streamer_is_running (void);
+
+/**
+ * @brief Asks the chunk streamer thread to load a chunk. Chunks already
+ *        requested, loading or loaded are not requested twice.
+ *
+ * @param chunk_x: The chunk in x to load.
+ * @param chunk_y: The chunk in y to load.
+ *
+ * @return True if the chunk is requested, loading or loaded, false if the
+ *         streamer is stopped or its queue is full.
+ */
+bool eng_chunk_streamer_request (int chunk_x, int chunk_y);
+
+/**
+ * @brief Checks if a chunk was requested to the chunk streamer and not
+ *        collected yet.
+ *
+ * @param chunk_x: The chunk in x to check.
+ * @param chunk_y: The chunk in y to check.
+ *
+ * @return True if the chunk is requested, loading or loaded.
+ */
+bool eng_chunk_streamer_is_requested (int chunk_x, int chunk_y);
+
+/**
+ * @brief Moves a chunk loaded by the chunk streamer thread into a chunk of
+ *        the main thread. Must be called from the main thread.
+ *
+ * @param chunk: Chunk to fill (chunk_x and chunk_y select the data), its
+ *               objects must have been freed.
+ *
+ * @return True if the chunk was loaded and moved, false if it is not ready.
+ */
+bool eng_chunk_streamer_collect (EngChunk *chunk);
+
+/**
+ * @brief Moves every chunk loaded by the chunk streamer thread and not
+ *        collected into the chunk cache. Must be called from the main thread.
+ *
+ * @sa eng_chunk_cache_store ()
+ */
+void eng_chunk_streamer_store_loaded (void);
+
+/**
+ * @brief Fills a chunk with placeholder tiles that have collision, shown
+ *        until the chunk streamer has loaded the chunk.
+ *
+ * @param chunk: Chunk to fill, its objects must have been freed.
+ */
+void eng_chunk_streamer_set_placeholder (EngChunk *chunk);
+
+/**
+ * @brief Returns the counters of the chunk streamer since the last reset.
+ *
+ * @return A structure containing the statistics of the chunk streamer.
+ */
+EngChunkStreamerStats eng_chunk_streamer_get_stats (void);
+
+/**
+ * @brief Resets the counters of the chunk streamer to zero.
+ */
+void eng_chunk_streamer_reset_stats (void);
+
+#endif /* CHUNK_STREAMER_H_INCLUDED */
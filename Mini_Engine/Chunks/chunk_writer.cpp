@@ -0,0 +1,301 @@
+/*===========================================================================*/
+/* File: chunk_writer.cpp                                                    */
+/* Author: YOAN BERNATCHEZ                                                   */
+/* Created On: 2026-10-16                                                    */
+/* Developed Using: SDL2                                                     */
+/* Function: Provides the user with in memory chunk edits, written back to   */
+/*           the chunk files in one write per chunk.                         */
+/*===========================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "chunk.h"
+#include "chunk_binary.h"
+#include "chunk_cache.h"
+#include "chunk_writer.h"
+#include "objects.h"
+#include "tile.h"
+#include "../File_Utilities/file_utilities.h"
+#include "../Time/time.h"
+
+/* Local structures. */
+typedef struct _WriterEntry {
+    EngChunk *chunk;
+    unsigned int last_edit;
+} WriterEntry;
+/**< Edited chunk waiting to be written to its file. */
+
+/** Edited chunks, an entry without a chunk is free. */
+static WriterEntry entry[ENG_CHUNK_WRITER_MAX_CHUNKS];
+
+/** Counter giving the order in which chunks were edited. */
+static unsigned int edit_count = 0;
+
+/** Time of the first edit not written yet. */
+static double flush_timer = 0;
+
+/*---------------------------------------------------------------------------*/
+/* Local function prototypes                                                 */
+/*---------------------------------------------------------------------------*/
+
+/**
+ * @brief Returns the entry holding an edited chunk.
+ *
+ * @param chunk_x: The chunk in x.
+ * @param chunk_y: The chunk in y.
+ *
+ * @return The entry or NULL if the chunk has no pending edit.
+ */
+static WriterEntry * find_entry (int chunk_x, int chunk_y);
+
+/**
+ * @brief Writes the chunk of an entry to its file and frees the entry. The
+ *        entry is kept when the chunk could not be written.
+ *
+ * @param writer_entry: The entry to write.
+ *
+ * @return True if the chunk was written, false otherwise.
+ */
+static bool flush_entry (WriterEntry *writer_entry);
+
+/**
+ * @brief Returns the number of entries holding an edited chunk.
+ *
+ * @return The number of edited chunks.
+ */
+static int count_entries (void);
+
+/*---------------------------------------------------------------------------*/
+/* Chunk writer function implementations                                     */
+/*---------------------------------------------------------------------------*/
+
+/*
+ * Returns the copy of a chunk to edit, reading it from its files the first
+ * time. The least recently edited chunk is written when no entry is free.
+ */
+EngChunk *
+eng_chunk_writer_edit (int chunk_x, int chunk_y)
+{
+    WriterEntry *writer_entry = find_entry (chunk_x, chunk_y);
+
+    if (writer_entry == NULL) {
+        writer_entry = &entry[0];
+
+        for (int i = 0; i < ENG_CHUNK_WRITER_MAX_CHUNKS; i++) {
+            if (entry[i].chunk == NULL) {
+                writer_entry = &entry[i];
+                break;
+            }
+
+            if (entry[i].last_edit < writer_entry->last_edit)
+                writer_entry = &entry[i];
+        }
+
+        /* Edits are never dropped, a chunk that cannot be written stays. */
+        if (writer_entry->chunk != NULL && !flush_entry (writer_entry)) {
+            printf ("Error: no room to edit chunk %d,%d\n", chunk_x,
+                    chunk_y);
+            return NULL;
+        }
+
+        writer_entry->chunk = (EngChunk*) malloc (sizeof(EngChunk));
+
+        if (writer_entry->chunk == NULL)
+            return NULL;
+
+        *writer_entry->chunk = eng_chunk_create_chunk ();
+        writer_entry->chunk->chunk_x = chunk_x;
+        writer_entry->chunk->chunk_y = chunk_y;
+
+        /* Edits only apply to chunks that exist. */
+        if (!eng_chunk_read_chunk (writer_entry->chunk, NULL)) {
+            eng_chunk_destroy (writer_entry->chunk);
+            free (writer_entry->chunk);
+            writer_entry->chunk = NULL;
+            return NULL;
+        }
+
+        if (count_entries () == 1)
+            flush_timer = eng_get_real_time ();
+    }
+
+    writer_entry->last_edit = ++edit_count;
+
+    /* The cached copy of the chunk is now outdated. */
+    eng_chunk_cache_invalidate (chunk_x, chunk_y);
+
+    return writer_entry->chunk;
+}
+
+/* Returns the edited copy of a chunk if it has pending edits. */
+const EngChunk *
+eng_chunk_writer_find (int chunk_x, int chunk_y)
+{
+    WriterEntry *writer_entry = find_entry (chunk_x, chunk_y);
+
+    return writer_entry != NULL ? writer_entry->chunk : NULL;
+}
+
+/* Copies the pending edits of a chunk to a chunk of the chunk window. */
+bool
+eng_chunk_writer_fetch (EngChunk *chunk)
+{
+    WriterEntry *writer_entry = find_entry (chunk->chunk_x, chunk->chunk_y);
+
+    if (writer_entry == NULL)
+        return false;
+
+    eng_tile_copy_tiles (chunk, writer_entry->chunk);
+
+    eng_object_allocate (chunk, writer_entry->chunk->nb_objects);
+
+    for (int i = 0; i < chunk->nb_objects; i++)
+        chunk->object[i] = writer_entry->chunk->object[i];
+
+    return true;
+}
+
+/* Writes an edited chunk to its text chunk file. */
+int
+eng_chunk_writer_flush_chunk (int chunk_x, int chunk_y)
+{
+    WriterEntry *writer_entry = find_entry (chunk_x, chunk_y);
+
+    if (writer_entry == NULL)
+        return ENG_FLUSH_NOTHING_PENDING;
+
+    return flush_entry (writer_entry) ? ENG_FLUSH_WRITTEN : ENG_FLUSH_FAILED;
+}
+
+/* Writes every edited chunk to its text chunk file. */
+int
+eng_chunk_writer_flush (void)
+{
+    int nb_written = 0;
+
+    for (int i = 0; i < ENG_CHUNK_WRITER_MAX_CHUNKS; i++) {
+        if (entry[i].chunk != NULL && flush_entry (&entry[i]))
+            nb_written++;
+    }
+
+    return nb_written;
+}
+
+/*
+ * Writes every edited chunk once ENG_CHUNK_WRITER_FLUSH_DELAY seconds have
+ * passed since the first pending edit, so a burst of edits costs one write
+ * per chunk.
+ */
+int
+eng_chunk_writer_update (void)
+{
+    if (count_entries () > 0 &&
+        eng_has_time_elapsed (&flush_timer, true, ENG_SECOND,
+                              ENG_CHUNK_WRITER_FLUSH_DELAY)) {
+        return eng_chunk_writer_flush ();
+    }
+
+    return 0;
+}
+
+/*
+ * Writes the tile and object data of a chunk to its text chunk file. The
+ * content is formatted in memory, then written with eng_file_write_file ().
+ */
+bool
+eng_chunk_writer_save_text (EngChunk *chunk)
+{
+    bool result = false;
+    int length = 0;
+    /* Every value takes at most 11 characters and a separator. */
+    int size = (TILESX * TILESY + chunk->nb_objects * 3) * 12 + 32;
+    char *buffer = (char*) malloc (size);
+    const char *file_name = NULL;
+
+    if (buffer == NULL)
+        return false;
+
+    length += snprintf (buffer + length, size - length, "tile{");
+
+    for (int y = 0; y < TILESY; y++) {
+        for (int x = 0; x < TILESX; x++) {
+            length += snprintf (buffer + length, size - length,
+                                x + y == 0 ? "%d" : ",%d",
+                                eng_tile_get_id (chunk, x, y));
+        }
+    }
+
+    length += snprintf (buffer + length, size - length, "}\n\nobjects{");
+
+    for (int i = 0; i < chunk->nb_objects; i++) {
+        length += snprintf (buffer + length, size - length,
+                            i == 0 ? "%d %d %d" : ",%d %d %d",
+                            chunk->object[i].id, chunk->object[i].x,
+                            chunk->object[i].y);
+    }
+
+    length += snprintf (buffer + length, size - length, "}");
+
+    file_name = eng_chunk_get_file_name (chunk->chunk_x, chunk->chunk_y);
+    result = eng_file_write_file (file_name, buffer, length);
+
+    if (!result)
+        printf ("Error: could not write file %s\n", file_name);
+
+    free ((char*) file_name);
+    free (buffer);
+
+    return result;
+}
+
+/* Returns the entry holding an edited chunk. */
+static WriterEntry *
+find_entry (int chunk_x, int chunk_y)
+{
+    for (int i = 0; i < ENG_CHUNK_WRITER_MAX_CHUNKS; i++) {
+        if (entry[i].chunk != NULL && entry[i].chunk->chunk_x == chunk_x &&
+            entry[i].chunk->chunk_y == chunk_y) {
+            return &entry[i];
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * Writes the chunk of an entry to its file and frees the entry. A chunk that
+ * could not be written keeps its entry, its edits are written by the next
+ * flush and are still the copy every load finds first.
+ */
+static bool
+flush_entry (WriterEntry *writer_entry)
+{
+    EngChunk *chunk = writer_entry->chunk;
+
+    if (!eng_chunk_writer_save_text (chunk))
+        return false;
+
+    /* The binary and cached copies of the chunk are now outdated. */
+    eng_chunk_binary_remove (chunk->chunk_x, chunk->chunk_y);
+    eng_chunk_cache_invalidate (chunk->chunk_x, chunk->chunk_y);
+
+    eng_chunk_destroy (chunk);
+    free (chunk);
+    writer_entry->chunk = NULL;
+
+    return true;
+}
+
+/* Returns the number of entries holding an edited chunk. */
+static int
+count_entries (void)
+{
+    int nb_entries = 0;
+
+    for (int i = 0; i < ENG_CHUNK_WRITER_MAX_CHUNKS; i++) {
+        if (entry[i].chunk != NULL)
+            nb_entries++;
+    }
+
+    return nb_entries;
+}
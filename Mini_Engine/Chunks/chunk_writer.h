@@ -0,0 +1,101 @@
+#ifndef CHUNK_WRITER_H_INCLUDED
+#define CHUNK_WRITER_H_INCLUDED
+
+#include <stdbool.h>
+#include "../Engine/globals.h"
+
+/** Maximum number of edited chunks waiting to be written to their files. */
+#define ENG_CHUNK_WRITER_MAX_CHUNKS 16
+
+/** Seconds after the first edit before edited chunks are written. */
+#define ENG_CHUNK_WRITER_FLUSH_DELAY 5
+
+/**
+ * Results of eng_chunk_writer_flush_chunk (). A chunk that could not be
+ * written keeps its edits, so its other copies must not be kept either.
+ */
+enum EngFlushResult {ENG_FLUSH_NOTHING_PENDING, ENG_FLUSH_WRITTEN,
+                     ENG_FLUSH_FAILED};
+
+/**
+ * @brief Returns the copy of a chunk to edit. The chunk is read from its files
+ *        the first time, then kept in memory with every following edit until
+ *        it is written by a flush. When all copies are in use, the least
+ *        recently edited chunk is written to make room.
+ *
+ * @param chunk_x: The chunk in x to edit.
+ * @param chunk_y: The chunk in y to edit.
+ *
+ * @return The chunk to edit, or NULL if the chunk has no file or if every
+ *         copy is in use and the least recently edited chunk could not be
+ *         written.
+ *
+ * @sa eng_chunk_writer_flush ()
+ */
+EngChunk * eng_chunk_writer_edit (int chunk_x, int chunk_y);
+
+/**
+ * @brief Returns the edited copy of a chunk if it has edits that were not
+ *        written yet.
+ *
+ * @param chunk_x: The chunk in x.
+ * @param chunk_y: The chunk in y.
+ *
+ * @return The edited chunk or NULL if the chunk has no pending edit.
+ */
+const EngChunk * eng_chunk_writer_find (int chunk_x, int chunk_y);
+
+/**
+ * @brief Copies the pending edits of a chunk to a chunk of the chunk window.
+ *        Pending edits are more recent than any chunk file or cached chunk.
+ *
+ * @param chunk: Chunk to store data to (chunk_x and chunk_y select the edited
+ *               chunk), its objects must have been freed.
+ *
+ * @return True if the chunk had pending edits, false otherwise.
+ */
+bool eng_chunk_writer_fetch (EngChunk *chunk);
+
+/**
+ * @brief Writes an edited chunk to its text chunk file with a single write,
+ *        and removes its outdated binary and cached copies.
+ *
+ * @param chunk_x: The chunk in x to write.
+ * @param chunk_y: The chunk in y to write.
+ *
+ * @return ENG_FLUSH_WRITTEN if the chunk was written, ENG_FLUSH_FAILED if
+ *         it has pending edits that could not be written, and
+ *         ENG_FLUSH_NOTHING_PENDING if it has no pending edit (see
+ *         EngFlushResult).
+ */
+int eng_chunk_writer_flush_chunk (int chunk_x, int chunk_y);
+
+/**
+ * @brief Writes every edited chunk to its text chunk file (explicit save).
+ *        Chunks that could not be written keep their edits until a later
+ *        flush succeeds.
+ *
+ * @return The number of chunks written.
+ */
+int eng_chunk_writer_flush (void);
+
+/**
+ * @brief Writes every edited chunk once ENG_CHUNK_WRITER_FLUSH_DELAY seconds
+ *        have passed since the first pending edit. Meant to be called once
+ *        per frame.
+ *
+ * @return The number of chunks written.
+ */
+int eng_chunk_writer_update (void);
+
+/**
+ * @brief Writes the tile and object data of a chunk to its text chunk file.
+ *        The file is replaced at once, a crash never leaves it half written.
+ *
+ * @param chunk: Chunk to save (chunk_x and chunk_y select the file).
+ *
+ * @return True on success, false otherwise.
+ */
+bool eng_chunk_writer_save_text (EngChunk *chunk);
+
+#endif /* CHUNK_WRITER_H_INCLUDED */
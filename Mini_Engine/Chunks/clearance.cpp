@@ -0,0 +1,366 @@
+/*===========================================================================*/
+/* File: clearance.cpp                                                       */
+/* Author: YOAN BERNATCHEZ                                                   */
+/* Created On: 2026-10-16                                                    */
+/* Developed Using: SDL2                                                     */
+/* Function: Provides the user with the clearance of the tiles, their       */
+/*           distance to the closest tile with collision, in every chunk     */
+/*           and across the chunk window.                                    */
+/*===========================================================================*/
+
+#include <stdlib.h>
+#include <string.h>
+#include "chunk.h"
+#include "clearance.h"
+#include "tile.h"
+
+/** Width of the chunk window, in tiles. */
+#define WINDOW_WIDTH (TILESX * CHUNKSX)
+/** Height of the chunk window, in tiles. */
+#define WINDOW_HEIGHT (TILESY * CHUNKSY)
+
+/* Local variables. */
+static uint8_t window_clearance[WINDOW_HEIGHT][WINDOW_WIDTH];
+/**< Clearance of the tiles of the chunk window, row by row. */
+static unsigned int window_version[CHUNKSY][CHUNKSX];
+/**< Version of the clearance of each chunk of the window, 0 if missing. */
+static int window_x = 0;            /**< Top-left chunk of the window in x. */
+static int window_y = 0;            /**< Top-left chunk of the window in y. */
+static bool is_window_valid = false;
+static unsigned int next_version = 1;
+static unsigned int window_version_count = 0;
+/**< Number of times the clearance of the chunk window changed. */
+static uint8_t work[WINDOW_WIDTH * WINDOW_HEIGHT];
+/**< Tiles of the area being computed, row by row. */
+
+/*---------------------------------------------------------------------------*/
+/* Local function prototypes                                                 */
+/*---------------------------------------------------------------------------*/
+
+/**
+ * @brief Grows a rectangle of tiles on every side, without going past a grid.
+ *
+ * @param rect:   The rectangle of tiles.
+ * @param margin: Number of tiles added on every side.
+ * @param width:  Width of the grid, in tiles.
+ * @param height: Height of the grid, in tiles.
+ *
+ * @return The rectangle grown.
+ */
+static SDL_Rect grow_rect (SDL_Rect rect, int margin, int width, int height);
+
+/**
+ * @brief Computes the distance of every tile of the work area to the closest
+ *        tile with collision, diagonals counting as one tile. The area starts
+ *        with 0 for tiles with collision and ENG_CLEARANCE_MAX for the others.
+ *
+ * @param width:  Width of the work area, in tiles.
+ * @param height: Height of the work area, in tiles.
+ */
+static void transform_work (int width, int height);
+
+/**
+ * @brief Computes the clearance of part of the chunk window again.
+ *
+ * @param window_chunk: Chunks of the window, NULL for missing chunks.
+ * @param region:       Tiles to compute, relative to the top-left chunk.
+ */
+static void update_window_region (EngChunk *window_chunk[][CHUNKSX],
+                                  SDL_Rect region);
+
+/*---------------------------------------------------------------------------*/
+/* Clearance function implementations                                        */
+/*---------------------------------------------------------------------------*/
+
+/* Records that the collision of a tile changed. */
+void
+eng_clearance_mark_tile (EngChunk *chunk, int x, int y)
+{
+    SDL_Rect *dirty = &chunk->clearance_dirty;
+
+    if (dirty->w == 0 || dirty->h == 0) {
+        dirty->x = x;
+        dirty->y = y;
+        dirty->w = 1;
+        dirty->h = 1;
+        return;
+    }
+
+    if (x < dirty->x) {
+        dirty->w += dirty->x - x;
+        dirty->x = x;
+    }
+    else if (x >= dirty->x + dirty->w)
+        dirty->w = x - dirty->x + 1;
+
+    if (y < dirty->y) {
+        dirty->h += dirty->y - y;
+        dirty->y = y;
+    }
+    else if (y >= dirty->y + dirty->h)
+        dirty->h = y - dirty->y + 1;
+}
+
+/* Records that the collision of every tile of a chunk changed. */
+void
+eng_clearance_mark_chunk (EngChunk *chunk)
+{
+    chunk->clearance_dirty.x = 0;
+    chunk->clearance_dirty.y = 0;
+    chunk->clearance_dirty.w = TILESX;
+    chunk->clearance_dirty.h = TILESY;
+}
+
+/*
+ * Computes the clearance of a chunk again around the tiles whose collision
+ * changed. A tile closer than ENG_CLEARANCE_MAX to a changed tile may change,
+ * and it depends on the tiles up to ENG_CLEARANCE_MAX - 1 around it, so the
+ * changed tiles are grown twice by that distance. The chunk gets a new version
+ * for the chunk window. The clearance is allocated the first time, then
+ * computed for the whole chunk.
+ */
+void
+eng_clearance_update_chunk (EngChunk *chunk)
+{
+    SDL_Rect region = chunk->clearance_dirty;
+    SDL_Rect area;
+
+    if (chunk->tile_clearance == NULL) {
+        chunk->tile_clearance = (uint8_t*) malloc (TILESX * TILESY);
+
+        if (chunk->tile_clearance == NULL)
+            return;
+
+        eng_clearance_mark_chunk (chunk);
+        region = chunk->clearance_dirty;
+    }
+
+    if (region.w == 0 || region.h == 0)
+        return;
+
+    region = grow_rect (region, ENG_CLEARANCE_MAX - 1, TILESX, TILESY);
+    area = grow_rect (region, ENG_CLEARANCE_MAX - 1, TILESX, TILESY);
+
+    for (int y = 0; y < area.h; y++) {
+        for (int x = 0; x < area.w; x++) {
+            work[y * area.w + x] =
+            eng_tile_has_collision (chunk, area.x + x, area.y + y) ?
+            0 : ENG_CLEARANCE_MAX;
+        }
+    }
+
+    transform_work (area.w, area.h);
+
+    for (int y = region.y; y < region.y + region.h; y++) {
+        memcpy (&chunk->tile_clearance[y * TILESX + region.x],
+                &work[(y - area.y) * area.w + region.x - area.x], region.w);
+    }
+
+    chunk->clearance_dirty.w = 0;
+    chunk->clearance_dirty.h = 0;
+    chunk->clearance_version = next_version++;
+}
+
+/* Returns the clearance of a tile of a chunk. */
+int
+eng_clearance_get_tile (EngChunk *chunk, int x, int y)
+{
+    eng_clearance_update_chunk (chunk);
+
+    if (chunk->tile_clearance == NULL)
+        return 0;
+
+    return chunk->tile_clearance[y * TILESX + x];
+}
+
+/*
+ * Computes the clearance of the chunk window again. The chunks are brought up
+ * to date first, then only the chunks whose version differs from the one
+ * used by the window are computed again, along with the tiles around them.
+ */
+void
+eng_clearance_update_window (EngChunk chunk[])
+{
+    EngChunk *window_chunk[CHUNKSY][CHUNKSX];
+    SDL_Rect region = {0, 0, WINDOW_WIDTH, WINDOW_HEIGHT};
+    unsigned int version = 0;
+    bool is_moved = false;
+    int origin_x = 0;
+    int origin_y = 0;
+
+    eng_chunk_get_window_origin (chunk, &origin_x, &origin_y);
+    is_moved = !is_window_valid || origin_x != window_x ||
+               origin_y != window_y;
+
+    for (int y = 0; y < CHUNKSY; y++) {
+        for (int x = 0; x < CHUNKSX; x++) {
+            window_chunk[y][x] = eng_chunk_get_chunk (chunk, origin_x + x,
+                                                      origin_y + y);
+
+            if (window_chunk[y][x] != NULL)
+                eng_clearance_update_chunk (window_chunk[y][x]);
+        }
+    }
+
+    window_x = origin_x;
+    window_y = origin_y;
+    is_window_valid = true;
+
+    if (is_moved)
+        update_window_region (window_chunk, region);
+
+    for (int y = 0; y < CHUNKSY; y++) {
+        for (int x = 0; x < CHUNKSX; x++) {
+            version = window_chunk[y][x] != NULL ?
+                      window_chunk[y][x]->clearance_version : 0;
+
+            if (!is_moved && version != window_version[y][x]) {
+                region.x = x * TILESX;
+                region.y = y * TILESY;
+                region.w = TILESX;
+                region.h = TILESY;
+                update_window_region (window_chunk, region);
+            }
+
+            window_version[y][x] = version;
+        }
+    }
+}
+
+/* Returns the clearance of a tile of the chunk window. */
+int
+eng_clearance_get_window_tile (int x, int y)
+{
+    if (!is_window_valid || x < 0 || x >= WINDOW_WIDTH || y < 0 ||
+        y >= WINDOW_HEIGHT) {
+        return 0;
+    }
+
+    return window_clearance[y][x];
+}
+
+/* Returns the version of the clearance of the chunk window. */
+unsigned int
+eng_clearance_get_window_version (void)
+{
+    return window_version_count;
+}
+
+/* Returns the clearance of a tile of the chunk window in world tiles. */
+int
+eng_clearance_get_world_tile (int tile_x, int tile_y)
+{
+    return eng_clearance_get_window_tile (tile_x - window_x * TILESX,
+                                          tile_y - window_y * TILESY);
+}
+
+/* Grows a rectangle of tiles on every side, without going past a grid. */
+static SDL_Rect
+grow_rect (SDL_Rect rect, int margin, int width, int height)
+{
+    int last_x = rect.x + rect.w - 1 + margin;
+    int last_y = rect.y + rect.h - 1 + margin;
+
+    rect.x = rect.x - margin > 0 ? rect.x - margin : 0;
+    rect.y = rect.y - margin > 0 ? rect.y - margin : 0;
+    rect.w = (last_x < width ? last_x : width - 1) - rect.x + 1;
+    rect.h = (last_y < height ? last_y : height - 1) - rect.y + 1;
+
+    return rect;
+}
+
+/*
+ * Computes the distance of every tile of the work area to the closest tile
+ * with collision. The first pass brings the distances from the tiles above
+ * and on the left, the second from the tiles below and on the right, which
+ * is exact when diagonals count as one tile.
+ */
+static void
+transform_work (int width, int height)
+{
+    uint8_t *tile = NULL;
+    int first_x = 0;
+    int last_x = 0;
+
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            tile = &work[y * width + x];
+            first_x = x > 0 ? x - 1 : x;
+            last_x = x < width - 1 ? x + 1 : x;
+
+            if (x > 0 && tile[-1] + 1 < *tile)
+                *tile = tile[-1] + 1;
+
+            for (int i = first_x; i <= last_x && y > 0; i++) {
+                if (work[(y - 1) * width + i] + 1 < *tile)
+                    *tile = work[(y - 1) * width + i] + 1;
+            }
+        }
+    }
+
+    for (int y = height - 1; y >= 0; y--) {
+        for (int x = width - 1; x >= 0; x--) {
+            tile = &work[y * width + x];
+            first_x = x > 0 ? x - 1 : x;
+            last_x = x < width - 1 ? x + 1 : x;
+
+            if (x < width - 1 && tile[1] + 1 < *tile)
+                *tile = tile[1] + 1;
+
+            for (int i = first_x; i <= last_x && y < height - 1; i++) {
+                if (work[(y + 1) * width + i] + 1 < *tile)
+                    *tile = work[(y + 1) * width + i] + 1;
+            }
+        }
+    }
+}
+
+/*
+ * Computes the clearance of part of the chunk window again, from the
+ * collision of its chunks. Missing chunks and the tiles outside of the window
+ * have collision, so a tile is never farther from collision than from the
+ * border of the window.
+ */
+static void
+update_window_region (EngChunk *window_chunk[][CHUNKSX], SDL_Rect region)
+{
+    SDL_Rect area;
+    EngChunk *curr_chunk = NULL;
+    int window_tile_x = 0;
+    int window_tile_y = 0;
+    int border = 0;
+    int value = 0;
+
+    region = grow_rect (region, ENG_CLEARANCE_MAX - 1, WINDOW_WIDTH,
+                        WINDOW_HEIGHT);
+    area = grow_rect (region, ENG_CLEARANCE_MAX - 1, WINDOW_WIDTH,
+                      WINDOW_HEIGHT);
+
+    for (int y = 0; y < area.h; y++) {
+        for (int x = 0; x < area.w; x++) {
+            window_tile_x = area.x + x;
+            window_tile_y = area.y + y;
+            curr_chunk = window_chunk[window_tile_y / TILESY]
+                                     [window_tile_x / TILESX];
+            work[y * area.w + x] =
+            curr_chunk == NULL ||
+            eng_tile_has_collision (curr_chunk, window_tile_x % TILESX,
+                                    window_tile_y % TILESY) ?
+            0 : ENG_CLEARANCE_MAX;
+        }
+    }
+
+    transform_work (area.w, area.h);
+    window_version_count++;
+
+    for (int y = region.y; y < region.y + region.h; y++) {
+        for (int x = region.x; x < region.x + region.w; x++) {
+            border = x + 1;
+            border = WINDOW_WIDTH - x < border ? WINDOW_WIDTH - x : border;
+            border = y + 1 < border ? y + 1 : border;
+            border = WINDOW_HEIGHT - y < border ? WINDOW_HEIGHT - y : border;
+            value = work[(y - area.y) * area.w + x - area.x];
+            window_clearance[y][x] = value < border ? value : border;
+        }
+    }
+}
@@ -0,0 +1,104 @@
+#ifndef CLEARANCE_H_INCLUDED
+#define CLEARANCE_H_INCLUDED
+
+#include "../Engine/globals.h"
+
+/**
+ * @brief Records that the collision of a tile changed, so the clearance
+ *        around it is computed again the next time it is needed. Called by
+ *        the tile accessors.
+ *
+ * @param chunk: Chunk containing the tile.
+ * @param x:     The tile in x (0 to TILESX - 1).
+ * @param y:     The tile in y (0 to TILESY - 1).
+ *
+ * @sa eng_clearance_mark_chunk ()
+ */
+void eng_clearance_mark_tile (EngChunk *chunk, int x, int y);
+
+/**
+ * @brief Records that the collision of every tile of a chunk changed.
+ *
+ * @param chunk: The chunk.
+ *
+ * @sa eng_clearance_mark_tile ()
+ */
+void eng_clearance_mark_chunk (EngChunk *chunk);
+
+/**
+ * @brief Computes the clearance of the tiles of a chunk again, around the
+ *        tiles whose collision changed since it was last computed. Tiles
+ *        outside of the chunk have no collision. The clearance of a chunk is
+ *        allocated by its first update and freed with its tile ids.
+ *
+ * @param chunk: The chunk.
+ */
+void eng_clearance_update_chunk (EngChunk *chunk);
+
+/**
+ * @brief Returns the clearance of a tile of a chunk: 0 for a tile with
+ *        collision, otherwise its distance in tiles to the closest tile of
+ *        the chunk with collision, diagonals counting as one tile, up to
+ *        ENG_CLEARANCE_MAX. A character covering the tiles up to r tiles
+ *        around a tile fits there when its clearance is larger than r.
+ *
+ * @param chunk: Chunk containing the tile.
+ * @param x:     The tile in x (0 to TILESX - 1).
+ * @param y:     The tile in y (0 to TILESY - 1).
+ *
+ * @return The clearance of the tile (0 to ENG_CLEARANCE_MAX), 0 if the
+ *         clearance could not be allocated.
+ */
+int eng_clearance_get_tile (EngChunk *chunk, int x, int y);
+
+/**
+ * @brief Computes the clearance of the tiles of the chunk window again, in
+ *        the chunks that changed since it was last computed. The clearance of
+ *        the window crosses chunk borders and tiles outside of the window
+ *        have collision. Moving the window computes it again entirely.
+ *
+ * @param chunk: Array of chunks of the chunk window.
+ *
+ * @sa eng_clearance_get_window_tile ()
+ */
+void eng_clearance_update_window (EngChunk chunk[]);
+
+/**
+ * @brief Returns the clearance of a tile of the chunk window, as it was when
+ *        the window was last updated (see eng_clearance_get_tile ()).
+ *
+ * @param x: Tile in x, relative to the top-left chunk of the chunk window
+ *           (0 to TILESX * CHUNKSX - 1).
+ * @param y: Tile in y, relative to the top-left chunk of the chunk window
+ *           (0 to TILESY * CHUNKSY - 1).
+ *
+ * @return The clearance of the tile, 0 outside of the window.
+ *
+ * @sa eng_clearance_update_window ()
+ */
+int eng_clearance_get_window_tile (int x, int y);
+
+/**
+ * @brief Returns the version of the clearance of the chunk window, which
+ *        changes every time eng_clearance_update_window () computes part of
+ *        the window again. Lets users keep data computed from the clearance
+ *        until it changes.
+ *
+ * @return The version of the clearance of the chunk window.
+ */
+unsigned int eng_clearance_get_window_version (void);
+
+/**
+ * @brief Returns the clearance of a tile of the chunk window from its world
+ *        tile coordinates, as it was when the window was last updated.
+ *
+ * @param tile_x: World tile in x.
+ * @param tile_y: World tile in y.
+ *
+ * @return The clearance of the tile, 0 outside of the window.
+ *
+ * @sa eng_clearance_update_window ()
+ */
+int eng_clearance_get_world_tile (int tile_x, int tile_y);
+
+#endif /* CLEARANCE_H_INCLUDED */
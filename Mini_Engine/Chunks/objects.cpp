@@ -9,8 +9,10 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "chunk.h"
 #include "objects.h"
+#include "chunk_writer.h"
 #include "../File_Utilities/file_utilities.h"
 
 /*---------------------------------------------------------------------------*/
@@ -18,205 +20,81 @@
 /*---------------------------------------------------------------------------*/
 
 /**
- * @brief Allocates memory for the object dynamic array in a chunk, size
- *        depends on the value of nb_objects.
+ * @brief Returns the footprint of an object in pixels of its chunk.
  *
- * @param chunk:       Array of chunks each containing objects.
- * @param chunk_index: Defines which chunk of data will be modified.
- * @param nb_objects:  The number of objects to allocate memory for (if 0, we
- *                     free the memory instead).
+ * @param object:    The object.
+ * @param footprint: Pointer receiving the footprint.
+ *
+ * @return True if the object has a footprint, false otherwise.
  */
-static void allocate_objects (EngChunk *chunk, int nb_objects);
+static bool get_chunk_footprint (const EngObject *object, SDL_Rect *footprint);
+
+/*---------------------------------------------------------------------------*/
+/* Object footprint registry                                                 */
+/*---------------------------------------------------------------------------*/
+
+static SDL_Rect *object_footprint = NULL;
+static int nb_object_footprints = 0;
 
 /*---------------------------------------------------------------------------*/
 /* Object function implementations                                           */
 /*---------------------------------------------------------------------------*/
 
-/* Modifies the object data stored in a chunk file with new values. */
+/*
+ * Modifies the object data of a chunk with new values. The edit is applied to
+ * the chunk in memory and written to its file later by the chunk writer.
+ */
 void
 eng_object_modify_file_object (int chunk_x, int chunk_y, int index, int id,
                                int x, int y)
 {
-    int cursor_index = 0;
-    int start_index = 0;
-    int end_index = 0;
-    int nb_objects = 0;
-    int comma = 0;
-    const char *file_name = eng_chunk_get_file_name (chunk_x, chunk_y);
-    char new_data[20];
-    char c = '!';
+    EngChunk *chunk = eng_chunk_writer_edit (chunk_x, chunk_y);
 
-    nb_objects = eng_object_get_nb_objects (chunk_x, chunk_y);
-    cursor_index = eng_file_get_index_after_string (file_name, "objects{");
-
-    FILE *file = fopen (file_name, "r");
-
-    if (file != NULL && cursor_index >= 0 && nb_objects > 0 &&
-        index < nb_objects) {
-        /* Advance file cursor to object data. */
-        fseek (file, cursor_index, SEEK_SET);
-
-        /* Find the starting position for modification. */
-        while (comma < index && c != '}' && !feof (file)) {
-            c = fgetc (file);
-
-            if (c == ',')
-                comma++;
-        }
-
-        start_index = ftell (file);
-
-        /* Advance so that the character is not a comma anymore. */
-        c = fgetc (file);
-
-        /*
-         * Find the ending position for modification by finding the next comma
-         * or }.
-         */
-        while (c != ',' && c != '}' && !feof (file))
-            c = fgetc (file);
-
-        end_index = ftell (file);
-
-        eng_file_close_file (file);
-
-        /* Modify data. */
-        snprintf (new_data, 20, "%d %d %d", id, x, y);
-        eng_file_replace_with_string (file_name, new_data, start_index,
-                                      end_index - 1);
+    if (chunk != NULL && index >= 0 && index < chunk->nb_objects) {
+        chunk->object[index] = eng_object_create_object (id, x, y);
+        chunk->object_grid_dirty = true;
     }
-
-    free ((char*) file_name);
-    file = eng_file_close_file (file);
 }
 
-/* Finds the nth object in a chunk file and deletes its data from the file. */
+/*
+ * Finds the nth object in a chunk and deletes it. The edit is applied to the
+ * chunk in memory and written to its file later by the chunk writer.
+ */
 void
 eng_object_remove_file_object (int chunk_x, int chunk_y, int index)
 {
-    int cursor_index = 0;
-    int start_index = 0;
-    int end_index = 0;
-    int nb_objects = 0;
-    int comma = 0;
-    const char *file_name = eng_chunk_get_file_name (chunk_x, chunk_y);
-    char c = '!';
-
-    nb_objects = eng_object_get_nb_objects (chunk_x, chunk_y);
-    cursor_index = eng_file_get_index_after_string (file_name, "objects{");
+    EngChunk *chunk = eng_chunk_writer_edit (chunk_x, chunk_y);
 
-    FILE *file = fopen (file_name, "r");
+    if (chunk != NULL && index >= 0 && index < chunk->nb_objects) {
+        /* Following objects keep their order. */
+        for (int i = index; i < chunk->nb_objects - 1; i++)
+            chunk->object[i] = chunk->object[i + 1];
 
-    if (file != NULL && cursor_index >= 0 && nb_objects > 0 &&
-        index < nb_objects) {
-        /* Advance file cursor to object data. */
-        fseek (file, cursor_index, SEEK_SET);
-
-        /* Find the starting position for the removal. */
-        while (comma < index && c != '}' && !feof (file)) {
-            c = fgetc (file);
-
-            if (c == ',')
-                comma++;
-        }
-
-        start_index = ftell (file);
-
-        /* Advance so that the character is not a comma anymore. */
-        c = fgetc (file);
-
-        /*
-         * Find the ending position for the removal by finding the next comma
-         * or }.
-         */
-        while (c != ',' && c != '}' && !feof (file))
-            c = fgetc(file);
-
-        end_index = ftell (file);
-
-        eng_file_close_file (file);
-
-        /*
-         * In the case where there is only one object, we remove 1 from
-         * endIndex so that the } does not get deleted.
-         */
-        if (index == 0 && nb_objects == 1) {
-            eng_file_replace_with_string (file_name, "", start_index,
-                                          end_index - 1);
-        }
-        /*
-         * If the removed object is the first object in the file, we remove the
-         * comma that comes after it.
-         */
-        else if (index == 0) {
-            eng_file_replace_with_string (file_name, "", start_index,
-                                          end_index);
-        }
-        /*
-         * If it isn't the first object, we remove the comma that comes before
-         * it.
-         */
-        else {
-            eng_file_replace_with_string (file_name, "", start_index - 1,
-                                          end_index - 1);
-        }
+        eng_object_allocate (chunk, chunk->nb_objects - 1);
     }
-
-    free ((char*) file_name);
-    file = eng_file_close_file (file);
 }
 
 /*
- * Adds the data for an object at the end of the object list in a
- * chunk file.
+ * Adds the data for an object at the end of the object list in a chunk. The
+ * edit is applied to the chunk in memory and written to its file later by the
+ * chunk writer.
  */
 void
 eng_object_add_file_object (int chunk_x, int chunk_y, int id, int x, int y)
 {
-    int cursor_index = 0;
-    int nb_objects = eng_object_get_nb_objects (chunk_x, chunk_y);
-    int buffer_size = 100;
-    const char *file_name = eng_chunk_get_file_name (chunk_x, chunk_y);
-    char new_object_data[buffer_size];
+    EngChunk *chunk = eng_chunk_writer_edit (chunk_x, chunk_y);
 
-    /* Seek the location of object data. */
-    cursor_index = eng_file_get_index_after_string (file_name, "objects{");
-
-    FILE *file = fopen (file_name, "r");
-
-    if (file != NULL && cursor_index >= 0) {
-        /* Position the file cursor to the end of "objects{". */
-        fseek (file, cursor_index, SEEK_SET);
-        cursor_index = ftell (file);
-
-        /* Ready up newObjectData as formatted text. */
-        if (nb_objects == 0)
-            snprintf (new_object_data, buffer_size, "%d %d %d", id, x, y);
-        else {
-            snprintf (new_object_data, buffer_size, ",%d %d %d", id, x, y);
-
-            /* Advance to the end of the object data (before the {). */
-            while (fgetc (file) != '}' && !feof(file)) {
-                /* Advance. */
-            }
-
-            cursor_index = ftell (file) - 1;
-        }
-
-        file = eng_file_close_file (file);
-
-        /* Paste in file. */
-        eng_file_replace_with_string (file_name, new_object_data,
-                                      cursor_index, cursor_index);
+    if (chunk != NULL) {
+        eng_object_allocate (chunk, chunk->nb_objects + 1);
+        chunk->object[chunk->nb_objects - 1] =
+        eng_object_create_object (id, x, y);
     }
-
-    free ((char*) file_name);
-    file = eng_file_close_file (file);
 }
 
 /*
  * Scans the chunk file and returns the number of objects present in the
- * file.
+ * file. A chunk with edits not written yet gives its number of objects in
+ * memory instead.
  */
 int
 eng_object_get_nb_objects (int chunk_x, int chunk_y)
@@ -225,12 +103,18 @@ eng_object_get_nb_objects (int chunk_x, int chunk_y)
     int nb_commas = 0;
     int cursor_index = 0;
     char c = '!';
-    const char *file_name = eng_chunk_get_file_name (chunk_x, chunk_y);
+    const char *file_name = NULL;
+    const EngChunk *edited_chunk = eng_chunk_writer_find (chunk_x, chunk_y);
+
+    if (edited_chunk != NULL)
+        return edited_chunk->nb_objects;
+
+    file_name = eng_chunk_get_file_name (chunk_x, chunk_y);
 
     /* Seek the location of object data. */
     cursor_index = eng_file_get_index_after_string (file_name, "objects{");
 
-    FILE *file = fopen (file_name, "r");
+    FILE *file = eng_file_open (file_name, "r");
 
     if (file != NULL && cursor_index >= 0) {
         /* Position the file cursor to the end of "objects{". */
@@ -262,9 +146,13 @@ eng_object_get_nb_objects (int chunk_x, int chunk_y)
  * Allocates memory for the object dynamic array in a chunk, size depends
  * on the value of nb_objects.
  */
-static void
-allocate_objects (EngChunk *chunk, int nb_objects)
+void
+eng_object_allocate (EngChunk *chunk, int nb_objects)
 {
+    /* The object grid no longer matches the objects. */
+    eng_object_free_grid (chunk);
+    chunk->object_grid_dirty = true;
+
     if (chunk->nb_objects == 0 && nb_objects == 0) {
 
     }
@@ -290,38 +178,30 @@ eng_object_load_objects (EngChunk *chunk)
     int cursor_index = 0;
     int nb_objects =
     eng_object_get_nb_objects (chunk->chunk_x, chunk->chunk_y);
-    SDL_Rect null_rect = {0, 0, 0, 0};
+    int id = 0;
+    int x = 0;
+    int y = 0;
 
     const char *file_name =
     eng_chunk_get_file_name (chunk->chunk_x, chunk->chunk_y);
 
     /* Seek the location of object data. */
     cursor_index = eng_file_get_index_after_string (file_name, "objects{");
-    FILE *file = fopen (file_name, "r");
+    FILE *file = eng_file_open (file_name, "r");
 
     if (file != NULL && cursor_index >= 0) {
         /* Position the file cursor to the end of "objects{". */
         fseek (file, cursor_index, SEEK_SET);
 
-        allocate_objects (chunk, nb_objects);
+        eng_object_allocate (chunk, nb_objects);
 
         /*
         * Scan all the objects in the file and assign them their respective
         * values.
         */
         for (int i = 0; i < nb_objects; i++) {
-            fscanf (file, "%d %d %d,", &chunk->object[i].id,
-                    &chunk->object[i].x,
-                    &chunk->object[i].y);
-
-            /* Initialize every element of object. */
-            chunk->object[i].center_y = 0;
-            chunk->object[i].frame = 0;
-            chunk->object[i].nb_frames = 0;
-            chunk->object[i].render_mode = 0;
-            chunk->object[i].texture_index = 0;
-            chunk->object[i].dst = null_rect;
-            chunk->object[i].src = null_rect;
+            fscanf (file, "%d %d %d,", &id, &x, &y);
+            chunk->object[i] = eng_object_create_object (id, x, y);
         }
 
         file = eng_file_close_file (file);
@@ -339,5 +219,218 @@ eng_object_deallocate (EngChunk *chunk)
     if (chunk->nb_objects != 0)
         free(chunk->object);
 
+    eng_object_free_grid (chunk);
+    chunk->object_grid_dirty = false;
     chunk->nb_objects = 0;
 }
+
+/* Creates and initializes an object, then returns it. */
+EngObject
+eng_object_create_object (int id, int x, int y)
+{
+    EngObject object;
+    SDL_Rect null_rect = {0, 0, 0, 0};
+
+    object.id = id;
+    object.x = x;
+    object.y = y;
+    object.center_y = 0;
+    object.frame = 0;
+    object.nb_frames = 0;
+    object.render_mode = 0;
+    object.texture_index = 0;
+    object.dst = null_rect;
+    object.src = null_rect;
+
+    return object;
+}
+
+/*
+ * Registers the collision footprint of an object id. The registry grows to the
+ * largest id registered, ids in between are given an empty footprint.
+ */
+bool
+eng_object_register_footprint (int id, SDL_Rect footprint)
+{
+    SDL_Rect *footprints = NULL;
+
+    if (id < 0)
+        return false;
+
+    if (id >= nb_object_footprints) {
+        footprints = (SDL_Rect*) realloc (object_footprint,
+                                          (id + 1) * sizeof(SDL_Rect));
+
+        if (footprints == NULL)
+            return false;
+
+        for (int i = nb_object_footprints; i <= id; i++)
+            footprints[i] = eng_object_get_footprint (-1);
+
+        object_footprint = footprints;
+        nb_object_footprints = id + 1;
+    }
+
+    object_footprint[id] = footprint;
+
+    return true;
+}
+
+/* Returns the collision footprint of an object id. */
+SDL_Rect
+eng_object_get_footprint (int id)
+{
+    SDL_Rect footprint = {0, 0, 0, 0};
+
+    if (id >= 0 && id < nb_object_footprints)
+        footprint = object_footprint[id];
+
+    return footprint;
+}
+
+/* Removes every registered object footprint. */
+void
+eng_object_clear_footprints (void)
+{
+    free (object_footprint);
+    object_footprint = NULL;
+    nb_object_footprints = 0;
+}
+
+/*
+ * Sorts the footprints of the objects of a chunk in its object grid. The
+ * footprints of every cell are counted to find where each cell starts, then
+ * copied in the order of the cells, a footprint overlapping many cells being
+ * copied in each of them. Chunks without any footprint get no grid.
+ */
+void
+eng_object_build_grid (EngChunk *chunk)
+{
+    EngObjectGrid *grid = NULL;
+    SDL_Rect bounds = {0, 0, 0, 0};
+    SDL_Rect footprint;
+    int cell_start[ENG_OBJECT_CELLSX * ENG_OBJECT_CELLSY + 1];
+    int cell_next[ENG_OBJECT_CELLSX * ENG_OBJECT_CELLSY];
+    int nb_footprints = 0;
+    int cell = 0;
+
+    eng_object_free_grid (chunk);
+    chunk->object_grid_dirty = false;
+    memset (cell_start, 0, sizeof(cell_start));
+
+    for (int pass = 0; pass < 2; pass++) {
+        for (int i = 0; i < chunk->nb_objects; i++) {
+            if (!get_chunk_footprint (&chunk->object[i], &footprint))
+                continue;
+
+            if (pass == 0 && nb_footprints++ == 0)
+                bounds = footprint;
+            else if (pass == 0)
+                SDL_UnionRect (&bounds, &footprint, &bounds);
+
+            for (int y = eng_object_get_cell (footprint.y, ENG_OBJECT_CELLSY);
+                 y <= eng_object_get_cell (footprint.y + footprint.h - 1,
+                                           ENG_OBJECT_CELLSY); y++) {
+                for (int x = eng_object_get_cell (footprint.x,
+                                                  ENG_OBJECT_CELLSX);
+                     x <= eng_object_get_cell (footprint.x + footprint.w - 1,
+                                               ENG_OBJECT_CELLSX); x++) {
+                    cell = y * ENG_OBJECT_CELLSX + x;
+
+                    if (pass == 0)
+                        cell_start[cell + 1]++;
+                    else
+                        grid->footprint[cell_next[cell]++] = footprint;
+                }
+            }
+        }
+
+        if (nb_footprints == 0)
+            return;
+
+        if (pass == 0) {
+            for (int j = 0; j < ENG_OBJECT_CELLSX * ENG_OBJECT_CELLSY; j++) {
+                cell_start[j + 1] += cell_start[j];
+                cell_next[j] = cell_start[j];
+            }
+
+            /* The footprints are stored right after the grid. */
+            grid = (EngObjectGrid*)
+                   malloc (sizeof(EngObjectGrid) +
+                           cell_start[ENG_OBJECT_CELLSX * ENG_OBJECT_CELLSY] *
+                           sizeof(SDL_Rect));
+
+            if (grid == NULL)
+                return;
+
+            grid->bounds = bounds;
+            grid->footprint = (SDL_Rect*) (grid + 1);
+            memcpy (grid->cell_start, cell_start, sizeof(cell_start));
+        }
+    }
+
+    chunk->object_grid = grid;
+}
+
+/*
+ * Returns the object grid of a chunk. The grid is built again first when the
+ * objects changed since it was built, so many changes cost a single build.
+ */
+const EngObjectGrid *
+eng_object_get_grid (EngChunk *chunk)
+{
+    if (chunk->object_grid_dirty)
+        eng_object_build_grid (chunk);
+
+    return chunk->object_grid;
+}
+
+/* Returns the number of bytes used by the object grid of a chunk. */
+long
+eng_object_get_grid_memory_size (const EngChunk *chunk)
+{
+    const EngObjectGrid *grid = chunk->object_grid;
+
+    if (grid == NULL)
+        return 0;
+
+    /* The footprints are stored right after the grid. */
+    return sizeof(EngObjectGrid) +
+           grid->cell_start[ENG_OBJECT_CELLSX * ENG_OBJECT_CELLSY] *
+           sizeof(SDL_Rect);
+}
+
+/* Frees the object grid of a chunk. */
+void
+eng_object_free_grid (EngChunk *chunk)
+{
+    free (chunk->object_grid);
+    chunk->object_grid = NULL;
+}
+
+/* Returns the footprint of an object in pixels of its chunk. */
+static bool
+get_chunk_footprint (const EngObject *object, SDL_Rect *footprint)
+{
+    *footprint = eng_object_get_footprint (object->id);
+    footprint->x += object->x;
+    footprint->y += object->y;
+
+    return footprint->w > 0 && footprint->h > 0;
+}
+
+/*
+ * Returns the cell of the object grid holding a position. Positions past the
+ * chunk are brought back to its border cells, which also hold the footprints
+ * going past the chunk.
+ */
+int
+eng_object_get_cell (int position, int nb_cells)
+{
+    int cell = position / ENG_OBJECT_CELL_SIZE;
+
+    if (position < 0)
+        return 0;
+
+    return cell < nb_cells ? cell : nb_cells - 1;
+}
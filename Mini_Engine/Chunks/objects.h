@@ -5,7 +5,7 @@
 
 /**
  * @brief Scans a chunk file and returns the number of objects present in
- *        the file.
+ *        the file, including edits not written yet.
  *
  * @param chunk_x: The chunk id of the file in x corresponding to the chunk to
  *                 scan.
@@ -18,7 +18,8 @@ int eng_object_get_nb_objects (int chunk_x, int chunk_y);
 
 /**
  * @brief Adds the data for an object at the end of the object list in a
- *        chunk file.
+ *        chunk file. The edit is applied in memory and the file is written by
+ *        the chunk writer.
  *
  * @param chunk_x: The chunk id of the file in x corresponding to the chunk to
  *                 modify.
@@ -29,13 +30,15 @@ int eng_object_get_nb_objects (int chunk_x, int chunk_y);
  * @param y:       Position in y of the object to add to file.
  *
  * @sa eng_object_remove_file_object () eng_object_modify_file_object ()
+ *     eng_chunk_writer_flush ()
  */
 void eng_object_add_file_object (int chunk_x, int chunk_y, int id,
                                  int x, int y);
 
 /**
  * @brief Finds the nth object in a chunk file and deletes its data from the
- *        file.
+ *        file. The edit is applied in memory and the file is written by the
+ *        chunk writer.
  *
  * @param chunk_x: The chunk id of the file in x corresponding to the chunk to
  *                 modify.
@@ -44,11 +47,14 @@ void eng_object_add_file_object (int chunk_x, int chunk_y, int id,
  * @param index:   Index corresponding to the object to remove in the file.
  *
  * @sa eng_object_add_file_object () eng_object_modify_file_object ()
+ *     eng_chunk_writer_flush ()
  */
 void eng_object_remove_file_object (int chunk_x, int chunk_y, int index);
 
 /**
  * @brief Modifies the object data stored in a chunk file with new values.
+ *        The edit is applied in memory and the file is written by the chunk
+ *        writer.
  *
  * @param chunk_x: The chunk id of the file in x corresponding to the chunk
  *                 to modify.
@@ -60,6 +66,7 @@ void eng_object_remove_file_object (int chunk_x, int chunk_y, int index);
  * @param y:       The new location in y of the object.
  *
  * @sa eng_object_add_file_object () eng_object_remove_file_object ()
+ *     eng_chunk_writer_flush ()
  */
 void eng_object_modify_file_object (int chunk_x, int chunk_y, int index,
                                     int id, int x, int y);
@@ -71,6 +78,18 @@ void eng_object_modify_file_object (int chunk_x, int chunk_y, int index,
  */
 void eng_object_load_objects (EngChunk *chunk);
 
+/**
+ * @brief Allocates memory for the object dynamic array in a chunk, size
+ *        depends on the value of nb_objects.
+ *
+ * @param chunk:      Chunk containing the objects to allocate memory for.
+ * @param nb_objects: The number of objects to allocate memory for (if 0, we
+ *                    free the memory instead).
+ *
+ * @sa eng_object_deallocate ()
+ */
+void eng_object_allocate (EngChunk *chunk, int nb_objects);
+
 /**
  * @brief Frees memory allocated to objects in a chunk.
  *
@@ -78,4 +97,97 @@ void eng_object_load_objects (EngChunk *chunk);
  */
 void eng_object_deallocate (EngChunk *chunk);
 
+/**
+ * @brief Creates and initializes an object, then returns it.
+ *
+ * @param id: Id of the object.
+ * @param x:  Position in x of the object in its chunk.
+ * @param y:  Position in y of the object in its chunk.
+ *
+ * @return A new initialized object.
+ */
+EngObject eng_object_create_object (int id, int x, int y);
+
+/**
+ * @brief Registers the collision footprint of every object of an id. Must be
+ *        called before the chunks are loaded, like the tile properties.
+ *
+ * @param id:        The object id (0 or more).
+ * @param footprint: Area of the object that characters cannot walk through,
+ *                   relative to the position of the object. An empty
+ *                   footprint (w or h of 0) removes the collision.
+ *
+ * @return True if the footprint was registered, false otherwise.
+ *
+ * @sa eng_object_build_grid ()
+ */
+bool eng_object_register_footprint (int id, SDL_Rect footprint);
+
+/**
+ * @brief Returns the collision footprint of an object id. Ids that were never
+ *        registered have an empty footprint.
+ *
+ * @param id: The object id.
+ *
+ * @return The footprint, relative to the position of the object.
+ */
+SDL_Rect eng_object_get_footprint (int id);
+
+/**
+ * @brief Removes every registered object footprint.
+ */
+void eng_object_clear_footprints (void);
+
+/**
+ * @brief Sorts the footprints of the objects of a chunk in its object grid,
+ *        so collision queries only test the objects near them. Called by the
+ *        chunk loader, the grid is freed when the objects change and built
+ *        again by eng_object_get_grid ().
+ *
+ * @param chunk: Chunk containing the objects.
+ *
+ * @sa eng_object_register_footprint ()
+ */
+void eng_object_build_grid (EngChunk *chunk);
+
+/**
+ * @brief Returns the cell of the object grid holding a position, positions
+ *        past the chunk being brought back to its border.
+ *
+ * @param position: Position in pixels of the chunk, in x or in y.
+ * @param nb_cells: Number of cells of the grid, in x or in y.
+ *
+ * @return The cell, between 0 and nb_cells - 1.
+ */
+int eng_object_get_cell (int position, int nb_cells);
+
+/**
+ * @brief Returns the object grid of a chunk, built again first if the
+ *        objects of the chunk changed since it was built.
+ *
+ * @param chunk: Chunk containing the objects.
+ *
+ * @return The object grid, or NULL if no object has a footprint.
+ *
+ * @sa eng_object_build_grid ()
+ */
+const EngObjectGrid * eng_object_get_grid (EngChunk *chunk);
+
+/**
+ * @brief Returns the number of bytes used by the object grid of a chunk,
+ *        footprints included.
+ *
+ * @param chunk: Chunk containing the object grid.
+ *
+ * @return The size of the grid, 0 if the chunk has no grid.
+ */
+long eng_object_get_grid_memory_size (const EngChunk *chunk);
+
+/**
+ * @brief Frees the object grid of a chunk.
+ *
+ * @param chunk: Chunk containing the object grid.
+ */
+void eng_object_free_grid (EngChunk *chunk);
+
 #endif /* OBJECTS_H_INCLUDED */
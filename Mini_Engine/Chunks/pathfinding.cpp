@@ -10,559 +10,1205 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include "chunk.h"
+#include "clearance.h"
 #include "pathfinding.h"
+#include "tile.h"
 
-/* Local structures. */
-typedef struct _EngNode {
-    int x;
-    int y;
-    int d;
-} EngNode;
-/**< Node structure used for pathfinding. */
+/* Local variables. */
+static EngPathContext shared_context;
+/**< Context used by the functions returning a new path. */
+static EngFlowField flow_field[ENG_FLOW_FIELD_CACHE_SIZE];
+/**< Flow fields kept by eng_pathfind_get_flow_field (), unused at version 0. */
+static unsigned int flow_field_use = 0;
+/**< Number of times a flow field was requested. */
 
 /*---------------------------------------------------------------------------*/
 /* Local function prototypes                                                 */
 /*---------------------------------------------------------------------------*/
 
 /**
- * @brief Adds a new node to the dynamic array new_tiles if the specified tile
- *        equals zero.
+ * @brief Returns true if starting and ending points are within the index range
+ *        of an array of size TILESX * CHUNKSX by TILESY * CHUNKSY.
  *
- * @param old_tiles:      Array of old tile nodes.
- * @param new_tiles:      Pointer to an array of new tile nodes.
- * @param tile:           Collision map.
- * @param old_tile_index: The index of the old tile to check for adjacent zero
- *                        tiles.
- * @param nb_new_tiles:   Number of new tile nodes.
- * @param offset_x:       -1 for left adjacent tile, 1 for right adjacent tile.
- * @param offset_y:       -1 for up adjacent tile, 1 for down adjacent tile.
+ * @param starting_point: Point to test (where the path starts).
+ * @param ending_point:   Point to test (where the path ends).
  *
- * @return 0 if there was an error in memory assignment, 1 if successful.
+ * @return True if it respects the limits of an array of size
+ *         TILESX * CHUNKSX by TILESY * CHUNKSY, false otherwise.
  */
-static int add_new_node (EngNode *old_tiles, EngNode **new_tiles,
-                          int tile[][TILESY*NBCHUNKS/2], int old_tile_index,
-                          int *nb_new_tiles, int offset_x, int offset_y);
+static bool respects_array_limits (EngPoint2d starting_point,
+                                   EngPoint2d ending_point);
 
 /**
- * @brief Adds a step and a direction to a path.
+ * @brief Gives every tile reachable from the ending point its distance to the
+ *        ending point, until the starting point is reached (breadth-first
+ *        search). The tiles are reached a whole wave at a time, from the bits
+ *        of the tiles reached by the previous wave, 64 tiles at a time.
+ *
+ * @param context:        Context in which the path is searched.
+ * @param starting_point: The tile where the path starts, NULL to reach every
+ *                        tile.
+ * @param ending_point:   The tile where the path ends.
  *
- * @param tile:           Collision map.
- * @param path:           The path we add a step and direction to.
- * @param dir_index:      The index of direction in which we put a value.
- * @param value:          The wave value of the tile currently observed.
- * @param starting_point: The tile to observe (+ the offset).
- * @param offset_x:       Offset in x to the tile to observe.
- * @param offset_y:       Offset in y to the tile to observe.
+ * @return True if the starting point was reached, false otherwise (always
+ *         false without starting point).
  */
-static void add_step (int tile[][TILESY*NBCHUNKS/2], EngPath *path,
-                      int dir_index, int *value, EngPoint2d starting_point,
-                      int offset_x, int offset_y);
+static bool spread_distance (EngPathContext *context,
+                             const EngPoint2d *starting_point,
+                             EngPoint2d ending_point);
 
 /**
- * @brief Returns true if starting and ending points are within the index range
- *        of an array of size TILESX * NBCHUNKS / 2 by TILESY * NBCHUNKS / 2.
+ * @brief Tells if a tile of the map was reached with a distance, never for
+ *        tiles outside of the map.
  *
- * @param starting_point: Point to test (where the path starts).
- * @param ending_point:   Point to test (where the path ends).
+ * @param context:  Context in which the path is searched.
+ * @param x:        The tile in x.
+ * @param y:        The tile in y.
+ * @param distance: Distance the tile must have.
  *
- * @return True if it respects the limits of an array of size
- *         TILESX * NBCHUNKS / 2 by TILESY * NBCHUNKS / 2, false otherwise.
+ * @return True if the tile was reached with this distance, false otherwise.
  */
-static bool respects_array_limits (EngPoint2d starting_point,
-                                   EngPoint2d ending_point);
+static bool has_distance (const EngPathContext *context, int x, int y,
+                          int distance);
+
+/**
+ * @brief Creates the path of a context by following the distances from the
+ *        starting point down to the ending point.
+ *
+ * @param context:        Context in which the path was searched.
+ * @param starting_point: The tile where the path starts.
+ */
+static void create_path (EngPathContext *context, EngPoint2d starting_point);
+
+/**
+ * @brief Gives every tile of a flow field the direction toward a tile one
+ *        step closer to the goal, from the distances of a context.
+ *
+ * @param context: Context in which every tile reachable from the goal was
+ *                 given its distance to the goal.
+ * @param field:   The flow field.
+ */
+static void create_flow_field (const EngPathContext *context,
+                               EngFlowField *field);
+
+/**
+ * @brief Tells if a path can be searched between two tiles: both must be in
+ *        the map and have enough clearance. Brings the clearance of the chunk
+ *        window and the free tiles of the context up to date.
+ *
+ * @param context:        Context in which the path is searched.
+ * @param chunk:          Array of chunks containing tile information.
+ * @param starting_point: The tile where the path starts.
+ * @param ending_point:   The tile where the path ends.
+ * @param clearance:      Smallest clearance of the tiles of the path.
+ *
+ * @return True if the path can be searched, false otherwise.
+ */
+static bool can_search (EngPathContext *context, EngChunk chunk[],
+                        EngPoint2d starting_point, EngPoint2d ending_point,
+                        int clearance);
+
+/**
+ * @brief Gives tiles their distance to the ending point with the A*
+ *        algorithm, searching from the ending point toward the starting point,
+ *        and the direction toward the ending point.
+ *
+ * @param context:        Context in which the path is searched.
+ * @param starting_point: The tile where the path starts.
+ * @param ending_point:   The tile where the path ends.
+ *
+ * @return True if the starting point was reached, false otherwise.
+ */
+static bool spread_astar (EngPathContext *context, EngPoint2d starting_point,
+                          EngPoint2d ending_point);
+
+/**
+ * @brief Opens a tile for the A* search, or gives it a shorter distance if it
+ *        is already open, if it is free and not closed.
+ *
+ * @param context:   Context in which the path is searched.
+ * @param x:         The tile in x.
+ * @param y:         The tile in y.
+ * @param distance:  Distance of the tile to the ending point.
+ * @param direction: Direction from the tile toward the ending point.
+ * @param goal:      The tile searched (the starting point).
+ * @param nb_open:   Pointer to the number of tiles in the heap.
+ */
+static void open_tile (EngPathContext *context, int x, int y, int distance,
+                       int direction, EngPoint2d goal, int *nb_open);
+
+/**
+ * @brief Tells if a tile comes before another in the heap: its estimated
+ *        length of path is shorter, or the same with a longer distance to the
+ *        ending point.
+ *
+ * @param context: Context in which the path is searched.
+ * @param tile:    Index of the first tile (y * ENG_PATH_MAP_WIDTH + x).
+ * @param other:   Index of the second tile.
+ * @param goal:    The tile searched (the starting point).
+ *
+ * @return True if the first tile comes first, false otherwise.
+ */
+static bool is_before (const EngPathContext *context, int tile, int other,
+                       EngPoint2d goal);
 
 /**
- * @brief Creates a path by assigning values to the direction int array and
- *        returning it.
+ * @brief Moves a tile of the heap up until its parent comes before it.
  *
- * @param starting_point: The tile we start creating a path from.
- * @param tile:           Array of tiles with wave values.
+ * @param context:  Context in which the path is searched.
+ * @param position: Position of the tile in the heap.
+ * @param goal:     The tile searched (the starting point).
+ */
+static void sift_up (EngPathContext *context, int position, EngPoint2d goal);
+
+/**
+ * @brief Removes the first tile of the heap.
+ *
+ * @param context: Context in which the path is searched.
+ * @param nb_open: Pointer to the number of tiles in the heap.
+ * @param goal:    The tile searched (the starting point).
+ *
+ * @return Index of the tile removed.
+ */
+static int pop_tile (EngPathContext *context, int *nb_open, EngPoint2d goal);
+
+/**
+ * @brief Creates the path of a context by following the direction of each
+ *        tile from the starting point to the ending point.
+ *
+ * @param context:        Context in which the path was searched.
+ * @param starting_point: The tile where the path starts.
+ */
+static void create_parent_path (EngPathContext *context,
+                                EngPoint2d starting_point);
+
+/**
+ * @brief Gives jump points their distance to the ending point with the A*
+ *        algorithm, searching from the ending point toward the starting point
+ *        (Jump Point Search).
+ *
+ * @param context:        Context in which the path is searched.
+ * @param starting_point: The tile where the path starts.
+ * @param ending_point:   The tile where the path ends.
+ *
+ * @return True if the starting point was reached, false otherwise.
+ */
+static bool spread_jump (EngPathContext *context, EngPoint2d starting_point,
+                         EngPoint2d ending_point);
+
+/**
+ * @brief Opens the jump points found from a closed jump point, in the
+ *        directions allowed by the direction it was reached from.
+ *
+ * @param context: Context in which the path is searched.
+ * @param x:       The jump point in x.
+ * @param y:       The jump point in y.
+ * @param goal:    The tile searched (the starting point).
+ * @param nb_open: Pointer to the number of tiles in the heap.
+ */
+static void open_jump_points (EngPathContext *context, int x, int y,
+                              EngPoint2d goal, int *nb_open);
+
+/**
+ * @brief Opens the jump point found by jumping in a direction, if any.
+ *
+ * @param context:  Context in which the path is searched.
+ * @param x:        The tile jumped from in x.
+ * @param y:        The tile jumped from in y.
+ * @param offset_x: -1 to jump left, 1 to jump right, 0 otherwise.
+ * @param offset_y: -1 to jump up, 1 to jump down, 0 otherwise.
+ * @param goal:     The tile searched (the starting point).
+ * @param nb_open:  Pointer to the number of tiles in the heap.
+ */
+static void open_jump (EngPathContext *context, int x, int y, int offset_x,
+                       int offset_y, EngPoint2d goal, int *nb_open);
+
+/**
+ * @brief Moves vertically from a tile until a jump point is found: the goal,
+ *        or a tile from which a horizontal jump finds a jump point.
+ *
+ * @param context:  Context in which the path is searched.
+ * @param x:        The tile jumped from in x.
+ * @param y:        The tile jumped from in y.
+ * @param offset_y: -1 to jump up, 1 to jump down.
+ * @param goal:     The tile searched (the starting point).
+ * @param point:    Pointer receiving the jump point.
+ *
+ * @return True if a jump point was found, false if a wall was reached.
+ */
+static bool jump_vertical (const EngPathContext *context, int x, int y,
+                           int offset_y, EngPoint2d goal, EngPoint2d *point);
+
+/**
+ * @brief Moves horizontally from a tile until a jump point is found: the
+ *        goal, or a tile with a forced neighbor above or below it.
  *
- * @return A path structure with directions and information regarding the
- *         existence of the path (NULL if path does not exist).
+ * @param context:  Context in which the path is searched.
+ * @param x:        The tile jumped from in x.
+ * @param y:        The tile jumped from in y.
+ * @param offset_x: -1 to jump left, 1 to jump right.
+ * @param goal:     The tile searched (the starting point).
+ * @param point:    Pointer receiving the jump point.
+ *
+ * @return True if a jump point was found, false if a wall was reached.
  */
-static EngPath * create_path (EngPoint2d starting_point,
-                              int tile[][TILESY*NBCHUNKS/2]);
+static bool jump_horizontal (const EngPathContext *context, int x, int y,
+                             int offset_x, EngPoint2d goal,
+                             EngPoint2d *point);
 
 /**
- * @brief Finds and removes all duplicate nodes.
+ * @brief Returns the tiles of a word of a row with a forced neighbor in
+ *        another row, when the row is walked in a direction: the tile of the
+ *        other row beside them is free and the one before it is not.
  *
- * @param new_tiles:    An array of nodes to be processed.
- * @param nb_new_tiles: The size of the array.
+ * @param context:  Context in which the path is searched.
+ * @param y:        The other row.
+ * @param word:     Index of the word in the rows.
+ * @param offset_x: -1 if the row is walked left, 1 if it is walked right.
  *
- * @return The new size of the array of nodes.
+ * @return A bit for each tile of the word with a forced neighbor.
  */
-static int remove_duplicates (EngNode *new_tiles, int nb_new_tiles);
+static uint64_t get_forced_tiles (const EngPathContext *context, int y,
+                                  int word, int offset_x);
 
 /**
- * @brief Gives the array of tiles a value for each individual tile,
- *        corresponding to a collision map, based on the array of chunks.
+ * @brief Tells if a path can go through a tile.
+ *
+ * @param context: Context in which the path is searched.
+ * @param x:       The tile in x.
+ * @param y:       The tile in y.
  *
- * @param chunk: Array of chunk data.
- * @param tile:  Array of tile data.
+ * @return True if the tile is in the map and free, false otherwise.
  */
-static void get_collision_map (EngChunk chunk[],
-                               int tile[][TILESY*NBCHUNKS/2]);
+static bool is_free (const EngPathContext *context, int x, int y);
 
 /**
- * @brief Sets a specific order to the chunks and saves the order in an array.
- *        Top-left: 0, top-right: 1, bottom-left: 2, bottom-right: 3.
+ * @brief Creates the path of a context by following the direction of each
+ *        jump point from the starting point to the ending point, one step per
+ *        tile.
  *
- * @param chunk: Array of chunk data.
- * @param order: Array of int that describes the order in which chunks need to
- *               be processed.
+ * @param context:        Context in which the path was searched.
+ * @param starting_point: The tile where the path starts.
  */
-static void chunk_get_order_of_chunks (EngChunk chunk[], int order[]);
+static void create_jump_path (EngPathContext *context,
+                              EngPoint2d starting_point);
 
 /*---------------------------------------------------------------------------*/
 /* Path finding functions implementation                                     */
 /*---------------------------------------------------------------------------*/
 
+/* Allocates a pathfinding context. */
+EngPathContext *
+eng_pathfind_create_context (void)
+{
+    EngPathContext *context = (EngPathContext*)
+                              malloc (sizeof(EngPathContext));
+
+    if (context == NULL)
+        printf ("Unable to allocate memory in %s %d\n.", __FILE__, __LINE__);
+    else
+        context->free_version = 0;
+
+    return context;
+}
+
+/* Frees memory allocated to a pathfinding context. */
+void
+eng_pathfind_destroy_context (EngPathContext **context)
+{
+    if (*context != NULL) {
+        free (*context);
+        *context = NULL;
+    }
+}
+
+/*
+ * Searches a path in the memory of a context. Tiles are reached in the
+ * order of their distance to the ending point, a wave of tiles at the same
+ * distance at a time, and the search stops as soon as the starting point is
+ * reached. Every tile closer to the ending point than the starting point has
+ * been reached by then, so the path follows the same distances as a search
+ * of the whole map.
+ */
+const EngPath *
+eng_pathfind_find_path (EngPathContext *context, EngChunk chunk[],
+                        int starting_tile_x, int starting_tile_y,
+                        int ending_tile_x, int ending_tile_y, int clearance)
+{
+    EngPoint2d starting_point = {starting_tile_x, starting_tile_y};
+    EngPoint2d ending_point = {ending_tile_x, ending_tile_y};
+
+    if (!can_search (context, chunk, starting_point, ending_point, clearance))
+        return NULL;
+
+    if (!spread_distance (context, &starting_point, ending_point))
+        return NULL;
+
+    if (context->distance[starting_tile_y][starting_tile_x] == 0)
+        return NULL;
+
+    create_path (context, starting_point);
+
+    return &context->path;
+}
+
+/*
+ * Searches a path in the memory of a context with the A* algorithm. The
+ * search goes from the ending point toward the starting point, so the path
+ * follows the direction of each tile from the starting point. Open tiles are
+ * kept in a binary heap ordered by their distance to the ending point plus
+ * their Manhattan distance to the starting point, which never overestimates
+ * the remaining distance, so the path found is as short as possible.
+ */
+const EngPath *
+eng_pathfind_find_path_astar (EngPathContext *context, EngChunk chunk[],
+                              int starting_tile_x, int starting_tile_y,
+                              int ending_tile_x, int ending_tile_y,
+                              int clearance)
+{
+    EngPoint2d starting_point = {starting_tile_x, starting_tile_y};
+    EngPoint2d ending_point = {ending_tile_x, ending_tile_y};
+
+    if (!can_search (context, chunk, starting_point, ending_point, clearance))
+        return NULL;
+
+    if (!spread_astar (context, starting_point, ending_point))
+        return NULL;
+
+    if (context->distance[starting_tile_y][starting_tile_x] == 0)
+        return NULL;
+
+    create_parent_path (context, starting_point);
+
+    return &context->path;
+}
+
+/*
+ * Searches a path in the memory of a context with Jump Point Search, an A*
+ * search which only opens the tiles where an optimal path may turn. Paths
+ * are searched vertically first: a vertical jump tries a horizontal jump at
+ * every tile, while a horizontal jump only stops at the goal or where a wall
+ * above or below the path ends (a forced neighbor), since every other tile
+ * beside it is reached as soon by a vertical jump.
+ */
+const EngPath *
+eng_pathfind_find_path_jump (EngPathContext *context, EngChunk chunk[],
+                             int starting_tile_x, int starting_tile_y,
+                             int ending_tile_x, int ending_tile_y,
+                             int clearance)
+{
+    EngPoint2d starting_point = {starting_tile_x, starting_tile_y};
+    EngPoint2d ending_point = {ending_tile_x, ending_tile_y};
+
+    if (!can_search (context, chunk, starting_point, ending_point, clearance))
+        return NULL;
+
+    if (!spread_jump (context, starting_point, ending_point))
+        return NULL;
+
+    if (context->distance[starting_tile_y][starting_tile_x] == 0)
+        return NULL;
+
+    create_jump_path (context, starting_point);
+
+    return &context->path;
+}
+
 /*
  * Returns a path from a starting point to an ending point that takes
- * in account tile collision (wave propagation method).
- *
- * The wave propagation method may be slow when dealing with large amount of
- * tiles. A solution would be to also offer Dijkstra's algorithm or A*, which
- * are more efficient.
+ * in account tile collision.
  *
  * A path will always be returned, but may not exist. When a path does not
  * exist, the pointer returned is NULL.
  *
- * eng_pathfind_detroy() must be called after usage of path.
- *
- * NOTE: This algorithm has been written with memory allocation checks, which
- *       makes the function look a little bit heavy, however, it allows the
- *       program to keep running even if the OS did not lend memory. If the OS
- *       did not allocate memory and the algorithm kept going without checks,
- *       it could have caused eventual crashes.
- *
- * TODO: This is a very long function and there are probably ways to decompose
- *       it even more.
+ * eng_pathfind_destroy_path() must be called after usage of path.
  */
 EngPath *
 eng_pathfind_get_path (EngChunk chunk[],
                        int starting_tile_x, int starting_tile_y,
                        int ending_tile_x, int ending_tile_y)
 {
+    return eng_pathfind_get_clear_path (chunk, starting_tile_x,
+                                        starting_tile_y, ending_tile_x,
+                                        ending_tile_y, 1);
+}
+
+/*
+ * Returns a path going only through tiles with enough clearance, so a
+ * character larger than a tile does not get stuck in narrow passages. The
+ * path is searched in the shared context, then only the path returned is
+ * allocated.
+ */
+EngPath *
+eng_pathfind_get_clear_path (EngChunk chunk[],
+                             int starting_tile_x, int starting_tile_y,
+                             int ending_tile_x, int ending_tile_y,
+                             int clearance)
+{
+    const EngPath *found = NULL;
     EngPath *path = NULL;
-    EngNode *old_tiles = NULL;
-    EngNode *new_tiles = NULL;
-    int tile[TILESX * NBCHUNKS / 2][TILESY * NBCHUNKS / 2];
-    int wave_value = 1;
-    bool is_mem_invalid = false;
 
-    int nb_old_tiles = 1;
-    int nb_new_tiles = 0;
+    found = eng_pathfind_find_path (&shared_context, chunk, starting_tile_x,
+                                    starting_tile_y, ending_tile_x,
+                                    ending_tile_y, clearance);
 
-    EngPoint2d starting_point = {starting_tile_x, starting_tile_y};
+    if (found == NULL)
+        return NULL;
+
+    path = (EngPath*) malloc (sizeof(EngPath));
+
+    if (path != NULL)
+        path->direction = (int*) malloc (found->nb_steps * sizeof(int));
+
+    if (path == NULL || path->direction == NULL) {
+        printf ("Unable to allocate memory in %s %d\n.", __FILE__, __LINE__);
+        free (path);
+        return NULL;
+    }
+
+    memcpy (path->direction, found->direction, found->nb_steps * sizeof(int));
+    path->nb_steps = found->nb_steps;
+    path->does_path_exist = true;
+
+    return path;
+}
+
+/*
+ * Returns the flow field of a goal. A field of the cache is returned as long
+ * as it was computed for the same goal and clearance from the current
+ * clearance of the chunk window, which changes when a tile of the window
+ * changes collision or the window moves. Otherwise the field replaces a field
+ * of an older version or, failing that, the field used the longest ago.
+ */
+const EngFlowField *
+eng_pathfind_get_flow_field (EngChunk chunk[], int ending_tile_x,
+                             int ending_tile_y, int clearance)
+{
     EngPoint2d ending_point = {ending_tile_x, ending_tile_y};
+    EngFlowField *field = NULL;
+    unsigned int version = 0;
 
-    /*
-     * Check if starting point and ending points are within array limits,
-     * otherwise we return a NULL path.
-     */
-    if (respects_array_limits (starting_point, ending_point)) {
+    if (!can_search (&shared_context, chunk, ending_point, ending_point,
+                     clearance)) {
+        return NULL;
+    }
 
-        get_collision_map (chunk, tile);
+    version = eng_clearance_get_window_version ();
+    flow_field_use++;
 
-        /*
-         * Make sure that the starting tile and ending tile do not have
-         * collision set on them (if one of them does, we return a NULL path).
-         */
-        if (tile[starting_point.x][starting_point.y] != -1 &&
-            tile[ending_point.x][ending_point.y] != -1) {
+    for (int i = 0; i < ENG_FLOW_FIELD_CACHE_SIZE; i++) {
+        if (flow_field[i].version == version &&
+            flow_field[i].clearance == clearance &&
+            flow_field[i].goal.x == ending_tile_x &&
+            flow_field[i].goal.y == ending_tile_y) {
+            flow_field[i].last_use = flow_field_use;
+            return &flow_field[i];
+        }
+    }
 
-            /* Initialization of our first old tile node. */
-            old_tiles = (EngNode*) malloc (nb_old_tiles * sizeof(EngNode));
+    for (int i = 0; i < ENG_FLOW_FIELD_CACHE_SIZE && field == NULL; i++) {
+        if (flow_field[i].version != version)
+            field = &flow_field[i];
+    }
 
-            /* Check if memory was allocated. */
-            if (old_tiles == NULL) {
-                is_mem_invalid = true;
-                goto MEM_ERROR;
-            }
+    if (field == NULL) {
+        field = &flow_field[0];
 
-            old_tiles[0].x = ending_point.x;
-            old_tiles[0].y = ending_point.y;
-            old_tiles[0].d = 0;
-
-            tile[ending_point.x][ending_point.y] = wave_value;
-
-            /*
-             * In this loop, we give a wave propagation value to all the tiles
-             * in the tile array.
-             */
-            while (nb_old_tiles != 0) {
-                /*
-                 * For every old tile, check if adjacent tiles have a value of
-                 * 0 if so, add them to the new_tiles node array. For every
-                 * adjacent tile, we also do a memory allocation check.
-                 */
-                for (int i = 0; i < nb_old_tiles; i++) {
-                    tile[old_tiles[i].x][old_tiles[i].y] = wave_value;
-
-                    /* Check for left adjacent tile. */
-                    if (add_new_node (old_tiles, &new_tiles, tile, i,
-                                      &nb_new_tiles, -1, 0) == 0) {
-                        is_mem_invalid = true;
-                        goto MEM_ERROR;
-                    }
-
-                    /* Check for right adjacent tile. */
-                    if (add_new_node (old_tiles, &new_tiles, tile, i,
-                                      &nb_new_tiles, 1, 0) == 0) {
-                        is_mem_invalid = true;
-                        goto MEM_ERROR;
-                    }
-
-                    /* Check for up adjacent tile. */
-                    if (add_new_node (old_tiles, &new_tiles, tile, i,
-                                      &nb_new_tiles, 0, -1) == 0) {
-                        is_mem_invalid = true;
-                        goto MEM_ERROR;
-                    }
-
-                    /* Check for down adjacent tile. */
-                    if (add_new_node (old_tiles, &new_tiles, tile, i,
-                                      &nb_new_tiles, 0, 1) == 0) {
-                        is_mem_invalid = true;
-                        goto MEM_ERROR;
-                    }
-                }
+        for (int i = 1; i < ENG_FLOW_FIELD_CACHE_SIZE; i++) {
+            if (flow_field[i].last_use < field->last_use)
+                field = &flow_field[i];
+        }
+    }
 
-                nb_new_tiles = remove_duplicates (new_tiles, nb_new_tiles);
+    spread_distance (&shared_context, NULL, ending_point);
+    create_flow_field (&shared_context, field);
+    field->goal = ending_point;
+    field->clearance = clearance;
+    field->version = version;
+    field->last_use = flow_field_use;
 
-                /* Transfer data from new_tiles nodes to old_tiles nodes. */
-                if (old_tiles != NULL) {
-                    free (old_tiles);
-                    old_tiles = NULL;
-                }
+    return field;
+}
 
-                nb_old_tiles = nb_new_tiles;
+/* Returns the direction to take from a tile to reach the goal of a field. */
+int
+eng_pathfind_get_flow_direction (const EngFlowField *field, int tile_x,
+                                 int tile_y)
+{
+    if (tile_x < 0 || tile_x >= ENG_PATH_MAP_WIDTH || tile_y < 0 ||
+        tile_y >= ENG_PATH_MAP_HEIGHT ||
+        field->direction[tile_y][tile_x] == ENG_FLOW_NONE) {
+        return -1;
+    }
 
-                if (nb_old_tiles != 0) {
-                    old_tiles = (EngNode*) malloc (nb_old_tiles *
-                                                   sizeof(EngNode));
-                    if (old_tiles == NULL) {
-                        is_mem_invalid = true;
-                        goto MEM_ERROR;
-                    }
-                }
+    return field->direction[tile_y][tile_x];
+}
 
-                for (int j = 0; j < nb_old_tiles; j++) {
-                    old_tiles[j].x = new_tiles[j].x;
-                    old_tiles[j].y = new_tiles[j].y;
-                    old_tiles[j].d = new_tiles[j].d;
-                }
+/*
+ * Gives every tile reachable from the ending point its distance to the ending
+ * point, a wave at a time. The wave holds a bit per tile at the distance
+ * reached last; a tile is reached by the next wave when the tile on its left,
+ * right, above or below it is in the wave, it is free and it was not reached
+ * yet, which takes a few shifts per word of the rows next to the wave. Only
+ * the distances of the tiles reached are written.
+ */
+static bool
+spread_distance (EngPathContext *context, const EngPoint2d *starting_point,
+                 EngPoint2d ending_point)
+{
+    uint64_t (*wave)[ENG_PATH_MAP_WORDS] = context->wave[0];
+    uint64_t (*next)[ENG_PATH_MAP_WORDS] = context->wave[1];
+    uint64_t (*swap)[ENG_PATH_MAP_WORDS] = NULL;
+    uint64_t reached = 0;
+    int first_y = ending_point.y;
+    int last_y = ending_point.y;
+    int next_first_y = 0;
+    int next_last_y = 0;
+    int distance = 0;
+    int x = 0;
+
+    memset (context->visited, 0, sizeof(context->visited));
+    memset (context->wave, 0, sizeof(context->wave));
+
+    context->visited[ending_point.y][ending_point.x / 64] |=
+    (uint64_t) 1 << (ending_point.x % 64);
+    wave[ending_point.y][ending_point.x / 64] =
+    context->visited[ending_point.y][ending_point.x / 64];
+    context->distance[ending_point.y][ending_point.x] = 0;
+    context->nb_expanded = 1;
+
+    while (first_y <= last_y) {
+        if (starting_point != NULL &&
+            has_distance (context, starting_point->x, starting_point->y,
+                          distance)) {
+            return true;
+        }
 
-                /* Get rid of our new_tiles nodes. */
-                if (new_tiles != NULL) {
-                    free (new_tiles);
-                    new_tiles = NULL;
-                }
+        next_first_y = ENG_PATH_MAP_HEIGHT;
+        next_last_y = -1;
+        distance++;
+
+        for (int y = first_y > 0 ? first_y - 1 : 0;
+             y <= last_y + 1 && y < ENG_PATH_MAP_HEIGHT; y++) {
+            for (int word = 0; word < ENG_PATH_MAP_WORDS; word++) {
+                reached = wave[y][word] << 1 | wave[y][word] >> 1;
+
+                if (word > 0)
+                    reached |= wave[y][word - 1] >> 63;
+
+                if (word < ENG_PATH_MAP_WORDS - 1)
+                    reached |= wave[y][word + 1] << 63;
+
+                if (y > 0)
+                    reached |= wave[y - 1][word];
 
-                nb_new_tiles = 0;
+                if (y < ENG_PATH_MAP_HEIGHT - 1)
+                    reached |= wave[y + 1][word];
 
-                wave_value++;
+                reached &= context->free[y][word] & ~context->visited[y][word];
+                next[y][word] = reached;
+
+                if (reached == 0)
+                    continue;
+
+                context->visited[y][word] |= reached;
+                next_first_y = y < next_first_y ? y : next_first_y;
+                next_last_y = y;
+
+                for (; reached != 0; reached &= reached - 1) {
+                    x = word * 64 + __builtin_ctzll (reached);
+                    context->distance[y][x] = distance;
+                    context->nb_expanded++;
+                }
             }
-            path = create_path (starting_point, tile);
         }
+
+        /* The rows of the old wave are cleared for the wave after next. */
+        for (int y = first_y; y <= last_y; y++)
+            memset (wave[y], 0, sizeof(wave[y]));
+
+        swap = wave;
+        wave = next;
+        next = swap;
+        first_y = next_first_y;
+        last_y = next_last_y;
     }
 
-     /*
-      * In case of an error in memory allocation, for example, if the OS did
-      * not lend memory as expected, we return a NULL path and an error
-      * message.
-      */
-MEM_ERROR:
-    if (is_mem_invalid)
-        printf ("Unable to allocate memory in %s %d\n.", __FILE__, __LINE__);
-    if (old_tiles != NULL)
-        free (old_tiles);
-    if (new_tiles != NULL)
-        free (new_tiles);
+    return false;
+}
 
-    return path;
+/* Tells if a tile of the map was given a distance. */
+static bool
+has_distance (const EngPathContext *context, int x, int y, int distance)
+{
+    if (x < 0 || x >= ENG_PATH_MAP_WIDTH || y < 0 || y >= ENG_PATH_MAP_HEIGHT)
+        return false;
+
+    return (context->visited[y][x / 64] >> (x % 64) & 1) != 0 &&
+           context->distance[y][x] == distance;
 }
 
 /*
- * Adds a new node to the dynamic array new_tiles if the specified tile
- * equals zero.
+ * Creates the path of a context. Each step goes to a tile one step closer to
+ * the ending point, trying the left, right, up and down tiles in that order.
  */
-static int
-add_new_node (EngNode *old_tiles, EngNode **new_tiles,
-              int tile[][TILESY*NBCHUNKS/2],
-              int old_tile_index, int *nb_new_tiles,
-              int offset_x, int offset_y)
+static void
+create_path (EngPathContext *context, EngPoint2d starting_point)
 {
-    if (old_tiles[old_tile_index].x + offset_x >= 0 &&
-        old_tiles[old_tile_index].x + offset_x < TILESX * 2 &&
-        old_tiles[old_tile_index].y + offset_y >= 0 &&
-        old_tiles[old_tile_index].y + offset_y < TILESY * 2 &&
-        tile[old_tiles[old_tile_index].x + offset_x]
-            [old_tiles[old_tile_index].y + offset_y] == 0) {
-
-        /* Allocate memory for the new tile node. */
-        if (*nb_new_tiles == 0) {
-            *new_tiles = (EngNode*) malloc (sizeof(EngNode));
-
-            /* Check if memory was allocated. */
-            if (*new_tiles == NULL)
-                return 0;
+    int x = starting_point.x;
+    int y = starting_point.y;
+    int distance = context->distance[y][x];
+
+    context->path.direction = context->direction;
+    context->path.nb_steps = distance;
+    context->path.does_path_exist = true;
+
+    for (int i = 0; i < context->path.nb_steps; i++) {
+        distance--;
+
+        if (has_distance (context, x - 1, y, distance)) {
+            context->direction[i] = ENG_LEFT;
+            x--;
+        }
+        else if (has_distance (context, x + 1, y, distance)) {
+            context->direction[i] = ENG_RIGHT;
+            x++;
+        }
+        else if (has_distance (context, x, y - 1, distance)) {
+            context->direction[i] = ENG_UP;
+            y--;
         }
-        /* Reallocate memory for the new tile nodes. */
         else {
-            *new_tiles = (EngNode*) realloc (*new_tiles, (*nb_new_tiles + 1) *
-                                             sizeof(EngNode));
-            /* Check if memory was allocated. */
-            if (*new_tiles == NULL)
-                return 0;
+            context->direction[i] = ENG_DOWN;
+            y++;
         }
+    }
+}
+
+/*
+ * Gives every tile of a flow field its direction toward the goal. The tiles
+ * one step closer to the goal are tried in the order of create_path (), so a
+ * character following the field takes the path eng_pathfind_find_path ()
+ * would give it.
+ */
+static void
+create_flow_field (const EngPathContext *context, EngFlowField *field)
+{
+    int distance = 0;
+
+    memset (field->direction, ENG_FLOW_NONE, sizeof(field->direction));
+
+    for (int y = 0; y < ENG_PATH_MAP_HEIGHT; y++) {
+        for (int x = 0; x < ENG_PATH_MAP_WIDTH; x++) {
+            if ((context->visited[y][x / 64] >> (x % 64) & 1) == 0)
+                continue;
 
-        *nb_new_tiles += 1;
-        EngNode *new_tiles_ptr = *new_tiles;
+            distance = context->distance[y][x] - 1;
 
-        /* Initializing the new tile node. */
-        if (*nb_new_tiles - 1 >= 0) {
-            new_tiles_ptr[*nb_new_tiles - 1].x = old_tiles[old_tile_index].x +
-                                                 offset_x;
-            new_tiles_ptr[*nb_new_tiles - 1].y = old_tiles[old_tile_index].y +
-                                                 offset_y;
-            new_tiles_ptr[*nb_new_tiles - 1].d = 0;
+            if (has_distance (context, x - 1, y, distance))
+                field->direction[y][x] = ENG_LEFT;
+            else if (has_distance (context, x + 1, y, distance))
+                field->direction[y][x] = ENG_RIGHT;
+            else if (has_distance (context, x, y - 1, distance))
+                field->direction[y][x] = ENG_UP;
+            else if (has_distance (context, x, y + 1, distance))
+                field->direction[y][x] = ENG_DOWN;
         }
-        else
-            printf ("Negative index for new_tiles in %s %d.\n" __FILE__,
-                    __LINE__);
     }
-
-    return 1;
 }
 
 /*
- * Creates a path by assigning values to the direction int array and
- * returning it.
- *
- * NOTE: This function also has memory allocation failure checks. If memory
- *       wasn't allocated by the OS, the function would return a NULL path.
+ * Tells if a path can be searched between two tiles. The free tiles of the
+ * context, a bit per tile with enough clearance, are only computed again when
+ * the clearance of the chunk window or the clearance requested changed since
+ * its last search.
  */
-static EngPath *
-create_path (EngPoint2d starting_point, int tile[][TILESY*NBCHUNKS/2])
+static bool
+can_search (EngPathContext *context, EngChunk chunk[],
+            EngPoint2d starting_point, EngPoint2d ending_point, int clearance)
 {
-    EngPath *path = NULL;
-    int value = tile[starting_point.x][starting_point.y];
-    int nb_steps = value - 1;
-    bool is_mem_invalid = false;
-
-    if (nb_steps > 0) {
-        /* Allocate memory for our path. */
-        path = (EngPath*) malloc (sizeof(EngPath));
-        if (path == NULL) {
-            is_mem_invalid = true;
-            goto MEM_ERROR;
-        }
+    unsigned int version = 0;
 
-        /* Allocate memory for our directions. */
-        path->direction = (int*) malloc (nb_steps * sizeof(int));
-        if (path->direction == NULL) {
-            is_mem_invalid = true;
-            goto MEM_ERROR;
-        }
+    if (!respects_array_limits (starting_point, ending_point))
+        return false;
+
+    eng_clearance_update_window (chunk);
+    version = eng_clearance_get_window_version ();
 
-        path->nb_steps = nb_steps;
-
-        for (int i = 0; i < nb_steps; i++) {
-            /* Try to add steps and directions. */
-            add_step (tile, path, i, &value, starting_point, -1, 0);
-            add_step (tile, path, i, &value, starting_point, 1, 0);
-            add_step (tile, path, i, &value, starting_point, 0, -1);
-            add_step (tile, path, i, &value, starting_point, 0, 1);
-
-            /* Adjust starting point. */
-            switch (path->direction[i]) {
-            case ENG_LEFT:
-                starting_point.x -= 1;
-                break;
-            case ENG_RIGHT:
-                starting_point.x += 1;
-                break;
-            case ENG_UP:
-                starting_point.y -= 1;
-                break;
-            case ENG_DOWN:
-                starting_point.y += 1;
-                break;
+    if (context->free_version != version ||
+        context->free_clearance != clearance) {
+        memset (context->free, 0, sizeof(context->free));
+
+        for (int y = 0; y < ENG_PATH_MAP_HEIGHT; y++) {
+            for (int x = 0; x < ENG_PATH_MAP_WIDTH; x++) {
+                if (eng_clearance_get_window_tile (x, y) >= clearance)
+                    context->free[y][x / 64] |= (uint64_t) 1 << (x % 64);
             }
         }
 
-        /*
-         * If the ending value is 1, then a path was found, otherwise path is
-         * non-existent and is NULL.
-         */
-        if (value == 1)
-            path->does_path_exist = true;
-        else {
-            free (path->direction);
-            free (path);
-            path = NULL;
-        }
+        context->free_version = version;
+        context->free_clearance = clearance;
     }
 
-    /* Memory allocation error handling. */
-MEM_ERROR:
-    if (is_mem_invalid)
-        printf ("Unable to allocate memory in %s %d\n.", __FILE__, __LINE__);
-    if (is_mem_invalid && path->direction != NULL)
-        free (path->direction);
-    if (is_mem_invalid && path != NULL)
-        free (path);
+    /*
+     * Make sure that the starting tile and ending tile have enough clearance
+     * (if one of them does not, we return a NULL path).
+     */
+    return is_free (context, starting_point.x, starting_point.y) &&
+           is_free (context, ending_point.x, ending_point.y);
+}
 
-    return path;
+/*
+ * Gives tiles their distance to the ending point with the A* algorithm. A
+ * tile is closed when it leaves the heap, its distance is final then since
+ * every step costs the same and the Manhattan distance never decreases by
+ * more than one per step.
+ */
+static bool
+spread_astar (EngPathContext *context, EngPoint2d starting_point,
+              EngPoint2d ending_point)
+{
+    int nb_open = 0;
+    int distance = 0;
+    int tile = 0;
+    int x = 0;
+    int y = 0;
+
+    memset (context->visited, 0, sizeof(context->visited));
+    memset (context->closed, 0, sizeof(context->closed));
+    context->nb_expanded = 0;
+
+    open_tile (context, ending_point.x, ending_point.y, 0, ENG_DOWN,
+               starting_point, &nb_open);
+
+    while (nb_open > 0) {
+        tile = pop_tile (context, &nb_open, starting_point);
+        x = tile % ENG_PATH_MAP_WIDTH;
+        y = tile / ENG_PATH_MAP_WIDTH;
+        context->closed[y][x / 64] |= (uint64_t) 1 << (x % 64);
+        context->nb_expanded++;
+
+        if (x == starting_point.x && y == starting_point.y)
+            return true;
+
+        distance = context->distance[y][x] + 1;
+        open_tile (context, x - 1, y, distance, ENG_RIGHT, starting_point,
+                   &nb_open);
+        open_tile (context, x + 1, y, distance, ENG_LEFT, starting_point,
+                   &nb_open);
+        open_tile (context, x, y - 1, distance, ENG_DOWN, starting_point,
+                   &nb_open);
+        open_tile (context, x, y + 1, distance, ENG_UP, starting_point,
+                   &nb_open);
+    }
+
+    return false;
 }
 
-/* Adds a step and direction to a path. */
+/* Opens a tile for the A* search. */
 static void
-add_step (int tile[][TILESY*NBCHUNKS/2], EngPath *path, int dir_index,
-          int *value, EngPoint2d starting_point, int offset_x, int offset_y)
+open_tile (EngPathContext *context, int x, int y, int distance,
+           int direction, EngPoint2d goal, int *nb_open)
 {
-    int index_x = starting_point.x + offset_x;
-    int index_y = starting_point.y + offset_y;
+    int tile = y * ENG_PATH_MAP_WIDTH + x;
+    uint64_t bit = 0;
 
-    /* Add a direction step / direction when condition is true. */
-    if (tile[index_x][index_y] < *value &&
-        tile[index_x][index_y] > -1) {
+    if (!is_free (context, x, y))
+        return;
 
-        /* Determine which direction to get. */
-        if (offset_x == -1)
-            path->direction[dir_index] = ENG_LEFT;
-        else if (offset_x == 1)
-            path->direction[dir_index] = ENG_RIGHT;
+    bit = (uint64_t) 1 << (x % 64);
 
-        if (offset_y == -1)
-            path->direction[dir_index] = ENG_UP;
-        else if (offset_y == 1)
-            path->direction[dir_index] = ENG_DOWN;
+    if ((context->closed[y][x / 64] & bit) != 0)
+        return;
 
-        *value = tile[index_x][index_y];
+    if ((context->visited[y][x / 64] & bit) != 0) {
+        if (distance < context->distance[y][x]) {
+            context->distance[y][x] = distance;
+            context->parent[y][x] = direction;
+            sift_up (context, context->heap_position[tile], goal);
+        }
+
+        return;
+    }
+
+    context->visited[y][x / 64] |= bit;
+    context->distance[y][x] = distance;
+    context->parent[y][x] = direction;
+    context->queue[*nb_open] = tile;
+    context->heap_position[tile] = *nb_open;
+    sift_up (context, (*nb_open)++, goal);
+}
+
+/* Tells if a tile comes before another in the heap. */
+static bool
+is_before (const EngPathContext *context, int tile, int other,
+           EngPoint2d goal)
+{
+    int x = tile % ENG_PATH_MAP_WIDTH;
+    int y = tile / ENG_PATH_MAP_WIDTH;
+    int other_x = other % ENG_PATH_MAP_WIDTH;
+    int other_y = other / ENG_PATH_MAP_WIDTH;
+    int distance = context->distance[y][x];
+    int other_distance = context->distance[other_y][other_x];
+    int length = distance + abs (x - goal.x) + abs (y - goal.y);
+    int other_length = other_distance + abs (other_x - goal.x) +
+                       abs (other_y - goal.y);
+
+    return length < other_length ||
+           (length == other_length && distance > other_distance);
+}
+
+/* Moves a tile of the heap up until its parent comes before it. */
+static void
+sift_up (EngPathContext *context, int position, EngPoint2d goal)
+{
+    int tile = context->queue[position];
+    int parent = 0;
+
+    while (position > 0) {
+        parent = (position - 1) / 2;
+
+        if (!is_before (context, tile, context->queue[parent], goal))
+            break;
+
+        context->queue[position] = context->queue[parent];
+        context->heap_position[context->queue[position]] = position;
+        position = parent;
     }
+
+    context->queue[position] = tile;
+    context->heap_position[tile] = position;
 }
 
-/* Finds and removes all duplicate nodes. */
+/*
+ * Removes the first tile of the heap. The last tile takes its place and moves
+ * down until both of its children come after it.
+ */
 static int
-remove_duplicates (EngNode *new_tiles, int nb_new_tiles)
+pop_tile (EngPathContext *context, int *nb_open, EngPoint2d goal)
 {
-    for (int i = 0; i < nb_new_tiles; i++) {
-        for (int j = i + 1; j < nb_new_tiles; j++) {
-
-            /* Find duplicate(s). */
-            if (new_tiles[i].x == new_tiles[j].x &&
-                new_tiles[i].y == new_tiles[j].y) {
-
-                /*
-                 * Once duplicate is found, write the data of the next index
-                 * over it, repeat process until there is no more data to
-                 * handle, then free one slot of memory.
-                 */
-                for (int k = j; k < nb_new_tiles - 1; k++) {
-                    new_tiles[k].x = new_tiles[k + 1].x;
-                    new_tiles[k].y = new_tiles[k + 1].y;
-                    new_tiles[k].d = new_tiles[k + 1].d;
-                }
+    int first = context->queue[0];
+    int tile = context->queue[--(*nb_open)];
+    int position = 0;
+    int child = 0;
+
+    while (2 * position + 1 < *nb_open) {
+        child = 2 * position + 1;
+
+        if (child + 1 < *nb_open &&
+            is_before (context, context->queue[child + 1],
+                       context->queue[child], goal)) {
+            child++;
+        }
 
-                /* Decrease size of array. */
-                nb_new_tiles -= 1;
+        if (!is_before (context, context->queue[child], tile, goal))
+            break;
 
-                /*
-                 * Decrementing j here makes it so we can identify multiple
-                 * duplicates in a single iteration of i.
-                 */
-                j--;
-            }
+        context->queue[position] = context->queue[child];
+        context->heap_position[context->queue[position]] = position;
+        position = child;
+    }
+
+    if (*nb_open > 0) {
+        context->queue[position] = tile;
+        context->heap_position[tile] = position;
+    }
+
+    return first;
+}
+
+/* Creates the path of a context by following the direction of each tile. */
+static void
+create_parent_path (EngPathContext *context, EngPoint2d starting_point)
+{
+    int x = starting_point.x;
+    int y = starting_point.y;
+
+    context->path.direction = context->direction;
+    context->path.nb_steps = context->distance[y][x];
+    context->path.does_path_exist = true;
+
+    for (int i = 0; i < context->path.nb_steps; i++) {
+        context->direction[i] = context->parent[y][x];
+
+        switch (context->direction[i]) {
+        case ENG_LEFT:
+            x--;
+            break;
+        case ENG_RIGHT:
+            x++;
+            break;
+        case ENG_UP:
+            y--;
+            break;
+        case ENG_DOWN:
+            y++;
+            break;
         }
     }
+}
+
+/*
+ * Gives jump points their distance to the ending point. Jump points are
+ * closed like the tiles of the A* search, the distance between two jump
+ * points being the number of tiles between them.
+ */
+static bool
+spread_jump (EngPathContext *context, EngPoint2d starting_point,
+             EngPoint2d ending_point)
+{
+    int nb_open = 0;
+    int tile = 0;
+    int x = 0;
+    int y = 0;
+
+    memset (context->visited, 0, sizeof(context->visited));
+    memset (context->closed, 0, sizeof(context->closed));
+    context->nb_expanded = 0;
+
+    open_tile (context, ending_point.x, ending_point.y, 0, ENG_DOWN,
+               starting_point, &nb_open);
+
+    while (nb_open > 0) {
+        tile = pop_tile (context, &nb_open, starting_point);
+        x = tile % ENG_PATH_MAP_WIDTH;
+        y = tile / ENG_PATH_MAP_WIDTH;
+        context->closed[y][x / 64] |= (uint64_t) 1 << (x % 64);
+        context->nb_expanded++;
+
+        if (x == starting_point.x && y == starting_point.y)
+            return true;
+
+        open_jump_points (context, x, y, starting_point, &nb_open);
+    }
 
-    return nb_new_tiles;
+    return false;
 }
 
 /*
- * Gives the array of tiles a value for each individual tile, corresponding
- * to a collision map, based on the array of chunks. Tiles will be assigned
- * -1 if the corresponding tile in the array of chunks has the collision set
- * to true, otherwise, tiles are assigned 0.
+ * Opens the jump points found from a closed jump point. The ending point
+ * jumps in every direction. A jump point reached vertically keeps going
+ * vertically and may turn left or right, a jump point reached horizontally
+ * keeps going horizontally and only turns toward its forced neighbors.
  */
 static void
-get_collision_map (EngChunk chunk[], int tile[][TILESY*NBCHUNKS/2])
+open_jump_points (EngPathContext *context, int x, int y, EngPoint2d goal,
+                  int *nb_open)
+{
+    int offset_x = 0;
+    int offset_y = 0;
+
+    if (context->distance[y][x] == 0) {
+        open_jump (context, x, y, -1, 0, goal, nb_open);
+        open_jump (context, x, y, 1, 0, goal, nb_open);
+        open_jump (context, x, y, 0, -1, goal, nb_open);
+        open_jump (context, x, y, 0, 1, goal, nb_open);
+        return;
+    }
+
+    /* The tile was reached going away from its parent. */
+    switch (context->parent[y][x]) {
+    case ENG_LEFT:
+        offset_x = 1;
+        break;
+    case ENG_RIGHT:
+        offset_x = -1;
+        break;
+    case ENG_UP:
+        offset_y = 1;
+        break;
+    case ENG_DOWN:
+        offset_y = -1;
+        break;
+    }
+
+    if (offset_y != 0) {
+        open_jump (context, x, y, 0, offset_y, goal, nb_open);
+        open_jump (context, x, y, -1, 0, goal, nb_open);
+        open_jump (context, x, y, 1, 0, goal, nb_open);
+        return;
+    }
+
+    open_jump (context, x, y, offset_x, 0, goal, nb_open);
+
+    if (is_free (context, x, y - 1) && !is_free (context, x - offset_x, y - 1))
+        open_jump (context, x, y, 0, -1, goal, nb_open);
+
+    if (is_free (context, x, y + 1) && !is_free (context, x - offset_x, y + 1))
+        open_jump (context, x, y, 0, 1, goal, nb_open);
+}
+
+/* Opens the jump point found by jumping in a direction, if any. */
+static void
+open_jump (EngPathContext *context, int x, int y, int offset_x, int offset_y,
+           EngPoint2d goal, int *nb_open)
 {
-    int order[NBCHUNKS];
-    int index = 0;
-    chunk_get_order_of_chunks (chunk, order);
-
-    /* We iterate for every tile in the four chunks combined map. */
-    for (int i = 0; i < TILESX * NBCHUNKS / 2; i++) {
-        for (int j = 0; j < TILESY * NBCHUNKS / 2; j++) {
-
-            /* Find the chunk index corresponding to the pair (i, j). */
-            index = 0;
-            if (i >= TILESX)
-                index += 1;
-            if (j >= TILESY)
-                index += 2;
-
-            /*
-             * Finally, set the value of each tile to -1 if there is
-             * collision on the original tile.
-             */
-            if (chunk[order[index]].tile[i % TILESX][j % TILESY].has_collision)
-                tile[i % (TILESX * 2)][j % (TILESY * 2)] = -1;
-            else
-                tile[i % (TILESX * 2)][j % (TILESY * 2)] = 0;
+    EngPoint2d point = {x, y};
+    int direction = 0;
+    bool is_found = false;
+
+    if (offset_x != 0) {
+        is_found = jump_horizontal (context, x, y, offset_x, goal, &point);
+        direction = offset_x < 0 ? ENG_RIGHT : ENG_LEFT;
+    }
+    else {
+        is_found = jump_vertical (context, x, y, offset_y, goal, &point);
+        direction = offset_y < 0 ? ENG_DOWN : ENG_UP;
+    }
+
+    if (is_found) {
+        open_tile (context, point.x, point.y, context->distance[y][x] +
+                   abs (point.x - x) + abs (point.y - y), direction, goal,
+                   nb_open);
+    }
+}
+
+/* Moves vertically from a tile until a jump point is found. */
+static bool
+jump_vertical (const EngPathContext *context, int x, int y, int offset_y,
+               EngPoint2d goal, EngPoint2d *point)
+{
+    for (y += offset_y; is_free (context, x, y); y += offset_y) {
+        if ((x == goal.x && y == goal.y) ||
+            jump_horizontal (context, x, y, -1, goal, point) ||
+            jump_horizontal (context, x, y, 1, goal, point)) {
+            point->x = x;
+            point->y = y;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+ * Moves horizontally from a tile until a jump point is found. The tiles of
+ * the row are scanned 64 at a time: each word gives the tiles where the jump
+ * stops (tiles without enough clearance, tiles with a forced neighbor and the
+ * goal) and the first of them in the direction of the jump is a jump point,
+ * unless the tile is not free.
+ */
+static bool
+jump_horizontal (const EngPathContext *context, int x, int y, int offset_x,
+                 EngPoint2d goal, EngPoint2d *point)
+{
+    uint64_t stop = 0;
+    int first = x + offset_x;
+
+    if (first < 0 || first >= ENG_PATH_MAP_WIDTH)
+        return false;
+
+    for (int word = first / 64; word >= 0 && word < ENG_PATH_MAP_WORDS;
+         word += offset_x) {
+        stop = ~context->free[y][word] |
+               get_forced_tiles (context, y - 1, word, offset_x) |
+               get_forced_tiles (context, y + 1, word, offset_x);
+
+        if (y == goal.y && goal.x / 64 == word)
+            stop |= (uint64_t) 1 << (goal.x % 64);
+
+        /* Ignore the tiles behind the first tile of the jump. */
+        if (word == first / 64 && offset_x > 0)
+            stop &= ~(uint64_t) 0 << (first % 64);
+        else if (word == first / 64)
+            stop &= ~(uint64_t) 0 >> (63 - first % 64);
+
+        if (stop != 0) {
+            x = word * 64 + (offset_x > 0 ? __builtin_ctzll (stop) :
+                                            63 - __builtin_clzll (stop));
+
+            if (!is_free (context, x, y))
+                return false;
+
+            point->x = x;
+            point->y = y;
+            return true;
         }
     }
+
+    return false;
 }
 
 /*
- * Returns the order of the chunks in this specific order: top-left: 0,
- * top-right: 1, bottom-left: 2, bottom-right: 3, where the numbers are
- * the index of the array.
+ * Returns the tiles of a word of a row with a forced neighbor in another row.
+ * The tile before each tile of the other row is found by shifting its word,
+ * carrying the bit of the word before it in the direction of the jump.
+ */
+static uint64_t
+get_forced_tiles (const EngPathContext *context, int y, int word,
+                  int offset_x)
+{
+    uint64_t free_tiles = 0;
+    uint64_t before = 0;
+
+    if (y < 0 || y >= ENG_PATH_MAP_HEIGHT)
+        return 0;
+
+    free_tiles = context->free[y][word];
+
+    if (offset_x > 0) {
+        before = free_tiles << 1;
+
+        if (word > 0)
+            before |= context->free[y][word - 1] >> 63;
+    }
+    else {
+        before = free_tiles >> 1;
+
+        if (word < ENG_PATH_MAP_WORDS - 1)
+            before |= context->free[y][word + 1] << 63;
+    }
+
+    return free_tiles & ~before;
+}
+
+/* Tells if a path can go through a tile. */
+static bool
+is_free (const EngPathContext *context, int x, int y)
+{
+    if (x < 0 || x >= ENG_PATH_MAP_WIDTH || y < 0 || y >= ENG_PATH_MAP_HEIGHT)
+        return false;
+
+    return (context->free[y][x / 64] >> (x % 64) & 1) != 0;
+}
+
+/*
+ * Creates the path of a context from its jump points. Each jump point is
+ * followed in its direction until a closed tile one step closer to the
+ * ending point per tile walked is found. That tile is its parent, or another
+ * tile as close to the ending point, which leads there just as fast.
  */
 static void
-chunk_get_order_of_chunks (EngChunk chunk[], int order[])
+create_jump_path (EngPathContext *context, EngPoint2d starting_point)
 {
-    /*
-     * Sort in 2D to get the order of chunks, following the logic
-     * of the eng_chunk_rotate_chunks functions.
-     */
-    if (NBCHUNKS > 3 && chunk[0].chunk_x < chunk[1].chunk_x &&
-        chunk[0].chunk_y < chunk[2].chunk_y) {
-        order[0] = 0;
-        order[1] = 1;
-        order[2] = 2;
-        order[3] = 3;
-    }
-    else if (NBCHUNKS > 3 && chunk[0].chunk_x > chunk[1].chunk_x &&
-             chunk[0].chunk_y < chunk[2].chunk_y) {
-        order[0] = 1;
-        order[1] = 0;
-        order[2] = 3;
-        order[3] = 2;
-    }
-    else if (NBCHUNKS > 3 && chunk[0].chunk_x < chunk[1].chunk_x &&
-             chunk[0].chunk_y > chunk[2].chunk_y) {
-        order[0] = 2;
-        order[1] = 3;
-        order[2] = 0;
-        order[3] = 1;
-    }
-    else if (NBCHUNKS > 3) {
-        order[0] = 3;
-        order[1] = 2;
-        order[2] = 1;
-        order[3] = 0;
+    int x = starting_point.x;
+    int y = starting_point.y;
+    int distance = context->distance[y][x];
+    int direction = 0;
+    int nb_steps = 0;
+
+    context->path.direction = context->direction;
+    context->path.nb_steps = distance;
+    context->path.does_path_exist = true;
+
+    while (distance > 0) {
+        direction = context->parent[y][x];
+
+        do {
+            x += direction == ENG_RIGHT ? 1 : direction == ENG_LEFT ? -1 : 0;
+            y += direction == ENG_DOWN ? 1 : direction == ENG_UP ? -1 : 0;
+            context->direction[nb_steps++] = direction;
+            distance--;
+        } while (distance > 0 &&
+                 ((context->closed[y][x / 64] >> (x % 64) & 1) == 0 ||
+                  context->distance[y][x] != distance));
     }
 }
 
 /*
  * Returns true if starting and ending points are within the index range
- * of an array of size TILESX * NBCHUNKS / 2 by TILESY * NBCHUNKS / 2.
+ * of an array of size TILESX * CHUNKSX by TILESY * CHUNKSY.
  */
 static bool
 respects_array_limits (EngPoint2d starting_point, EngPoint2d ending_point)
@@ -573,10 +1219,10 @@ respects_array_limits (EngPoint2d starting_point, EngPoint2d ending_point)
         ending_point.x < 0 || ending_point.y < 0) {
         result = false;
     }
-    else if (starting_point.x >= TILESX * NBCHUNKS / 2 ||
-             starting_point.y >= TILESY * NBCHUNKS / 2 ||
-             ending_point.x >= TILESX * NBCHUNKS / 2 ||
-             ending_point.y >= TILESY * NBCHUNKS / 2) {
+    else if (starting_point.x >= TILESX * CHUNKSX ||
+             starting_point.y >= TILESY * CHUNKSY ||
+             ending_point.x >= TILESX * CHUNKSX ||
+             ending_point.y >= TILESY * CHUNKSY) {
         result = false;
     }
 
@@ -3,6 +3,19 @@
 
 #include "../Engine/globals.h"
 
+/** Width in tiles of the map searched by the pathfinding (the chunk window). */
+#define ENG_PATH_MAP_WIDTH (TILESX * CHUNKSX)
+/** Height in tiles of the map searched by the pathfinding. */
+#define ENG_PATH_MAP_HEIGHT (TILESY * CHUNKSY)
+/** Number of tiles of the map searched by the pathfinding. */
+#define ENG_PATH_MAP_SIZE (ENG_PATH_MAP_WIDTH * ENG_PATH_MAP_HEIGHT)
+/** Number of 64 bit words holding a bit per tile of a row of the map. */
+#define ENG_PATH_MAP_WORDS ((ENG_PATH_MAP_WIDTH + 63) / 64)
+/** Number of flow fields kept by eng_pathfind_get_flow_field (). */
+#define ENG_FLOW_FIELD_CACHE_SIZE 4
+/** Direction of the tiles of a flow field without direction. */
+#define ENG_FLOW_NONE 0xFF
+
 typedef struct _EngPath
 {
     int *direction;
@@ -13,9 +26,167 @@ typedef struct _EngPath
  * Structure containing a path for an NPC to follow.
  */
 
+typedef struct _EngPathContext
+{
+    uint64_t free[ENG_PATH_MAP_HEIGHT][ENG_PATH_MAP_WORDS];
+    unsigned int free_version;
+    int free_clearance;
+    uint64_t visited[ENG_PATH_MAP_HEIGHT][ENG_PATH_MAP_WORDS];
+    uint64_t closed[ENG_PATH_MAP_HEIGHT][ENG_PATH_MAP_WORDS];
+    uint64_t wave[2][ENG_PATH_MAP_HEIGHT][ENG_PATH_MAP_WORDS];
+    int distance[ENG_PATH_MAP_HEIGHT][ENG_PATH_MAP_WIDTH];
+    uint8_t parent[ENG_PATH_MAP_HEIGHT][ENG_PATH_MAP_WIDTH];
+    int queue[ENG_PATH_MAP_SIZE];
+    int heap_position[ENG_PATH_MAP_SIZE];
+    int direction[ENG_PATH_MAP_SIZE];
+    int nb_expanded;
+    EngPath path;
+} EngPathContext;
+/**<
+ * Structure containing the memory used to search paths, allocated once and
+ * reused by every search: a bit per tile of the map telling if the tile has
+ * enough clearance, kept while the clearance of the chunk window (see
+ * eng_clearance_get_window_version ()) and the clearance searched do not
+ * change, a bit per tile telling if the tile was reached, the distance of the
+ * reached tiles to the end of the path, the last two waves of tiles reached by
+ * the breadth-first search and the directions of the last path found. The A*
+ * search keeps its open tiles in queue as a binary heap (heap_position gives
+ * the position of a tile in the heap), marks the tiles done in closed and
+ * stores the direction of each tile toward the end in parent, which Jump
+ * Point Search also uses for its jump points. nb_expanded counts the tiles
+ * reached by the last search.
+ */
+
+typedef struct _EngFlowField
+{
+    EngPoint2d goal;
+    int clearance;
+    unsigned int version;
+    unsigned int last_use;
+    uint8_t direction[ENG_PATH_MAP_HEIGHT][ENG_PATH_MAP_WIDTH];
+} EngFlowField;
+/**<
+ * Structure containing the direction to take from every tile of the map to
+ * reach a goal by a shortest path going only through tiles with enough
+ * clearance. The goal and the tiles which cannot reach it have ENG_FLOW_NONE.
+ * The field was computed from the clearance of the chunk window of version
+ * (see eng_clearance_get_window_version ()), last_use orders the fields of
+ * the cache.
+ */
+
+/**
+ * @brief Allocates a pathfinding context, used to search paths without
+ *        allocating memory.
+ *
+ * @return The context, NULL if it could not be allocated.
+ *
+ * @sa eng_pathfind_find_path (), eng_pathfind_destroy_context ()
+ */
+EngPathContext * eng_pathfind_create_context (void);
+
+/**
+ * @brief Frees memory allocated to a pathfinding context.
+ *
+ * @param context: Pointer to the context to destroy.
+ *
+ * @sa eng_pathfind_create_context ()
+ */
+void eng_pathfind_destroy_context (EngPathContext **context);
+
+/**
+ * @brief Searches a path going only through tiles with enough clearance (see
+ *        eng_clearance_get_tile ()) without allocating memory. A clearance of
+ *        1 allows every tile without collision, a clearance of r + 1 keeps r
+ *        free tiles around the path. Tile coordinates are relative to the
+ *        top-left chunk of the chunk window and range from 0 to
+ *        ENG_PATH_MAP_WIDTH - 1 and ENG_PATH_MAP_HEIGHT - 1.
+ *
+ * @param context:         Context in which the path is searched.
+ * @param chunk:           Array of chunks containing tile and object
+ *                         information.
+ * @param starting_tile_x: Tile in x where the path starts.
+ * @param starting_tile_y: Tile in y where the path starts.
+ * @param ending_tile_x:   Tile in x where the path ends.
+ * @param ending_tile_y:   Tile in y where the path ends.
+ * @param clearance:       Smallest clearance of the tiles of the path (1 to
+ *                         ENG_CLEARANCE_MAX).
+ *
+ * @return The path found, stored in the context until its next search, or
+ *         NULL if there is no path (or the path has no step).
+ *
+ * @sa eng_pathfind_get_clear_path ()
+ */
+const EngPath * eng_pathfind_find_path (EngPathContext *context,
+                                        EngChunk chunk[],
+                                        int starting_tile_x,
+                                        int starting_tile_y,
+                                        int ending_tile_x, int ending_tile_y,
+                                        int clearance);
+
+/**
+ * @brief Searches a path like eng_pathfind_find_path () with the A*
+ *        algorithm, which visits the tiles closest to a straight line between
+ *        the starting and ending points first (Manhattan distance). The path
+ *        has the same number of steps as the one of eng_pathfind_find_path (),
+ *        but its directions may differ.
+ *
+ * @param context:         Context in which the path is searched.
+ * @param chunk:           Array of chunks containing tile and object
+ *                         information.
+ * @param starting_tile_x: Tile in x where the path starts.
+ * @param starting_tile_y: Tile in y where the path starts.
+ * @param ending_tile_x:   Tile in x where the path ends.
+ * @param ending_tile_y:   Tile in y where the path ends.
+ * @param clearance:       Smallest clearance of the tiles of the path (1 to
+ *                         ENG_CLEARANCE_MAX).
+ *
+ * @return The path found, stored in the context until its next search, or
+ *         NULL if there is no path (or the path has no step).
+ *
+ * @sa eng_pathfind_find_path ()
+ */
+const EngPath * eng_pathfind_find_path_astar (EngPathContext *context,
+                                              EngChunk chunk[],
+                                              int starting_tile_x,
+                                              int starting_tile_y,
+                                              int ending_tile_x,
+                                              int ending_tile_y,
+                                              int clearance);
+
+/**
+ * @brief Searches a path like eng_pathfind_find_path_astar () with Jump Point
+ *        Search, which only expands the tiles where a path may have to turn
+ *        (jump points) instead of every tile along a straight line. The path
+ *        found has a direction for each step, like the other methods.
+ *
+ * @param context:         Context in which the path is searched.
+ * @param chunk:           Array of chunks containing tile and object
+ *                         information.
+ * @param starting_tile_x: Tile in x where the path starts.
+ * @param starting_tile_y: Tile in y where the path starts.
+ * @param ending_tile_x:   Tile in x where the path ends.
+ * @param ending_tile_y:   Tile in y where the path ends.
+ * @param clearance:       Smallest clearance of the tiles of the path (1 to
+ *                         ENG_CLEARANCE_MAX).
+ *
+ * @return The path found, stored in the context until its next search, or
+ *         NULL if there is no path (or the path has no step).
+ *
+ * @sa eng_pathfind_find_path_astar ()
+ */
+const EngPath * eng_pathfind_find_path_jump (EngPathContext *context,
+                                             EngChunk chunk[],
+                                             int starting_tile_x,
+                                             int starting_tile_y,
+                                             int ending_tile_x,
+                                             int ending_tile_y,
+                                             int clearance);
+
 /**
  * @brief Returns a path from a starting point to an ending point that takes
- *        in account collision (wave propagation method).
+ *        in account collision (breadth-first search). Tile coordinates
+ *        are relative to the top-left chunk of the chunk window and range
+ *        from 0 to TILESX * CHUNKSX - 1 and TILESY * CHUNKSY - 1.
  *
  * @param chunk:           Array of chunks containing tile and object
  *                         information.
@@ -33,6 +204,77 @@ EngPath * eng_pathfind_get_path (EngChunk chunk[],
                                  int starting_tile_x, int starting_tile_y,
                                  int ending_tile_x, int ending_tile_y);
 
+/**
+ * @brief Returns a path from a starting point to an ending point going only
+ *        through tiles with enough clearance (see eng_pathfind_find_path ()).
+ *        The path is searched in a context shared by every call and copied
+ *        to a new path.
+ *
+ * @param chunk:           Array of chunks containing tile and object
+ *                         information.
+ * @param starting_tile_x: Tile in x where the path starts.
+ * @param starting_tile_y: Tile in y where the path starts.
+ * @param ending_tile_x:   Tile in x where the path ends.
+ * @param ending_tile_y:   Tile in y where the path ends.
+ * @param clearance:       Smallest clearance of the tiles of the path (1 to
+ *                         ENG_CLEARANCE_MAX).
+ *
+ * @return A path structure containing directions and information regarding the
+ *         existence of the path.
+ *
+ * @sa eng_pathfind_get_path (), eng_pathfind_destroy_path ()
+ */
+EngPath * eng_pathfind_get_clear_path (EngChunk chunk[],
+                                       int starting_tile_x,
+                                       int starting_tile_y,
+                                       int ending_tile_x, int ending_tile_y,
+                                       int clearance);
+
+/**
+ * @brief Returns the flow field of a goal: the direction to take from every
+ *        tile of the map toward the goal, following the same paths as
+ *        eng_pathfind_find_path (). The field is computed once per goal,
+ *        clearance and version of the clearance of the chunk window, and kept
+ *        in a cache of ENG_FLOW_FIELD_CACHE_SIZE fields, so any number of
+ *        characters heading to the same goal share it.
+ *
+ * @param chunk:         Array of chunks containing tile and object
+ *                       information.
+ * @param ending_tile_x: Tile in x of the goal, relative to the top-left chunk
+ *                       of the chunk window.
+ * @param ending_tile_y: Tile in y of the goal.
+ * @param clearance:     Smallest clearance of the tiles of the paths (1 to
+ *                       ENG_CLEARANCE_MAX).
+ *
+ * @return The flow field, valid until the cache computes
+ *         ENG_FLOW_FIELD_CACHE_SIZE other fields or the collision of the
+ *         chunk window changes. NULL if the goal is outside of the map or
+ *         does not have enough clearance.
+ *
+ * @sa eng_pathfind_get_flow_direction ()
+ */
+const EngFlowField * eng_pathfind_get_flow_field (EngChunk chunk[],
+                                                  int ending_tile_x,
+                                                  int ending_tile_y,
+                                                  int clearance);
+
+/**
+ * @brief Returns the direction to take from a tile to reach the goal of a
+ *        flow field.
+ *
+ * @param field:  The flow field.
+ * @param tile_x: Tile in x, relative to the top-left chunk of the chunk
+ *                window.
+ * @param tile_y: Tile in y.
+ *
+ * @return The direction (see EngDirectionType), -1 at the goal, for tiles
+ *         which cannot reach it and outside of the map.
+ *
+ * @sa eng_pathfind_get_flow_field ()
+ */
+int eng_pathfind_get_flow_direction (const EngFlowField *field, int tile_x,
+                                     int tile_y);
+
 /**
  * @brief Frees memory allocated to a path.
  *
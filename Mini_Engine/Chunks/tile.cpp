@@ -3,13 +3,17 @@
 /* Author: YOAN BERNATCHEZ                                                   */
 /* Created On: 2020-07-18                                                    */
 /* Developed Using: SDL2                                                     */
-/* Function: Provides the user with a way to create tiles and modify them.   */
+/* Function: Provides the user with a way to access tiles and modify them.   */
 /*===========================================================================*/
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
 #include "chunk.h"
+#include "chunk_streamer.h"
+#include "chunk_writer.h"
+#include "tile.h"
 #include "../File_Utilities/file_utilities.h"
 
 /*---------------------------------------------------------------------------*/
@@ -25,77 +29,83 @@
  */
 static int get_id_from_file (FILE *file);
 
-/*---------------------------------------------------------------------------*/
-/* Tile function implementations                                             */
-/*---------------------------------------------------------------------------*/
-
-/* Modifies the value of a tile in a chunk text file. */
-void
-eng_tile_modify_file_id (int chunk_x, int chunk_y, int tile_x, int tile_y,
-                         int new_id)
-{
-    FILE *file;
-    char buffer[20];
-    char c = '!';
-    const char *file_name = eng_chunk_get_file_name (chunk_x, chunk_y);
-    int cursor_index = 0;
-    int start_index = 0;
-    int end_index = 0;
-    int comma = 0;
-
-    /* Seek the location of tile data. */
-    cursor_index = eng_file_get_index_after_string (file_name, "tile{");
-
-    file = fopen (file_name, "r");
+/**
+ * @brief Returns the index of an id in the palette of a chunk, the id is added
+ *        to the palette if it is missing.
+ *
+ * @param chunk: Chunk using the palette.
+ * @param id:    The id to search.
+ *
+ * @return The index of the id or -1 if the palette is full.
+ */
+static int get_palette_index (EngChunk *chunk, int id);
 
-    if (file != NULL && cursor_index >= 0 && tile_x >= 0 && tile_y >= 0 &&
-        new_id >= 0) {
-        /* Advance file cursor to tile data. */
-        fseek (file, cursor_index, SEEK_SET);
+/**
+ * @brief Stores the tile ids of a chunk with more bits per tile, used when
+ *        the palette of the chunk overflows.
+ *
+ * @param chunk: Chunk to modify.
+ * @param bits:  The new number of bits per tile (4, 8 or 16).
+ *
+ * @return True if the tiles were stored again, false on allocation failure.
+ */
+static bool widen_tiles (EngChunk *chunk, int bits);
 
-        /*
-         * In file, advance to the position of the desired tile data. Here,
-         * since data is delimited by commas, we simply advance the the nth
-         * comma which associated with the tile we are looking for.
-         */
-        while (comma < tile_x + TILESX * tile_y && c != '}' && !feof (file)) {
-            c = fgetc (file);
+/**
+ * @brief Returns the number of bytes used by the tile ids of a chunk.
+ *
+ * @param bits: The number of bits per tile.
+ *
+ * @return The number of bytes for TILESX by TILESY tiles.
+ */
+static long get_data_size (int bits);
 
-            if (c == ',')
-                comma++;
-        }
+/**
+ * @brief Returns an id that tiles can store, ids that do not fit on 16 bits
+ *        are replaced by -1 like the ids that could not be read.
+ *
+ * @param id: The id read from a chunk file.
+ *
+ * @return The id or -1.
+ */
+static int get_storable_id (int id);
 
-        if (c != '}') {
-            start_index = ftell (file);
+/*---------------------------------------------------------------------------*/
+/* Tile property registry                                                    */
+/*---------------------------------------------------------------------------*/
 
-            c = fgetc (file);
+static EngTileProperties *tile_properties = NULL;
+static int nb_tile_properties = 0;
 
-            /*
-             * In file, advance to the position after the comma of the desired
-             * tile.
-             */
-            while (c != ',' && c != '}' && !feof (file))
-                c = fgetc (file);
+/* Time of the animation clock in milliseconds. */
+static double animation_clock = 0;
 
-            /*
-             * We remove 1 from the endIndex because we do not want the ,
-             * to be included.
-             */
-            end_index = ftell (file) - 1;
+/*---------------------------------------------------------------------------*/
+/* Tile function implementations                                             */
+/*---------------------------------------------------------------------------*/
 
-            eng_file_close_file (file);
+/*
+ * Modifies the value of a tile in a chunk. The edit is applied to the chunk in
+ * memory and written to its text chunk file later by the chunk writer, so
+ * many edits to a chunk cost a single write.
+ */
+void
+eng_tile_modify_file_id (int chunk_x, int chunk_y, int tile_x, int tile_y,
+                         int new_id)
+{
+    EngChunk *chunk = NULL;
 
-            eng_file_replace_with_string (file_name, itoa (new_id, buffer, 10),
-                                          start_index, end_index);
-        }
-        else {
-            printf ("Error: tile requested is out of bounds in file %s\n",
-                    file_name);
-        }
+    if (tile_x < 0 || tile_x >= TILESX || tile_y < 0 || tile_y >= TILESY ||
+        new_id < 0) {
+        printf ("Error: tile requested is out of bounds in chunk %d,%d\n",
+                chunk_x, chunk_y);
     }
+    else {
+        chunk = eng_chunk_writer_edit (chunk_x, chunk_y);
 
-    free ((char*) file_name);
-    file = eng_file_close_file (file);
+        if (chunk != NULL)
+            eng_tile_stamp_id (chunk, tile_x, tile_y, new_id);
+    }
 }
 
 /*
@@ -115,7 +125,7 @@ eng_tile_load_tiles (EngChunk *chunk)
     /* Seek the location of tile data. */
     cursor_index = eng_file_get_index_after_string (file_name, "tile{");
 
-    file = fopen (file_name, "r");
+    file = eng_file_open (file_name, "r");
 
     if (file != NULL && cursor_index >= 0) {
         /* Advance file cursor to tile data. */
@@ -124,9 +134,9 @@ eng_tile_load_tiles (EngChunk *chunk)
         /* Retrieve and store tile ids. */
         for (int y = 0; y < TILESY; y++) {
             for (int x = 0; x < TILESX; x++) {
-                chunk->tile[x][y].id = get_id_from_file (file);
+                eng_tile_stamp_id (chunk, x, y, get_id_from_file (file));
 
-                if (chunk->tile[x][y].id == -1)
+                if (eng_tile_get_id (chunk, x, y) == -1)
                     error++;
             }
         }
@@ -144,6 +154,246 @@ eng_tile_load_tiles (EngChunk *chunk)
     file = eng_file_close_file (file);
 }
 
+/*
+ * Registers the properties of a tile id. The registry grows to the largest id
+ * registered, ids in between are given the default properties. The streamer
+ * thread reads the registry while it decodes chunks, so it cannot change
+ * while the streamer runs.
+ */
+bool
+eng_tile_register_properties (int id, unsigned int flags, int movement_cost)
+{
+    EngTileProperties *properties = NULL;
+
+    if (id < 0 || eng_chunk_streamer_is_running ())
+        return false;
+
+    if (id >= nb_tile_properties) {
+        properties = (EngTileProperties*)
+                     realloc (tile_properties,
+                              (id + 1) * sizeof(EngTileProperties));
+
+        if (properties == NULL)
+            return false;
+
+        for (int i = nb_tile_properties; i <= id; i++)
+            properties[i] = eng_tile_get_properties (-1);
+
+        tile_properties = properties;
+        nb_tile_properties = id + 1;
+    }
+
+    tile_properties[id].flags = flags;
+    tile_properties[id].movement_cost = movement_cost;
+
+    return true;
+}
+
+/*
+ * Animates every tile of an id. The animation is stored with the properties
+ * of the id, registering the properties again keeps it and the
+ * ENG_TILE_ANIMATED flag turns it on and off.
+ */
+bool
+eng_tile_register_animation (int id, int nb_frames, int frame_duration)
+{
+    EngTileProperties properties = eng_tile_get_properties (id);
+
+    if (nb_frames < 1 || frame_duration < 1)
+        return false;
+
+    if (!eng_tile_register_properties (id, properties.flags |
+                                       ENG_TILE_ANIMATED,
+                                       properties.movement_cost)) {
+        return false;
+    }
+
+    tile_properties[id].nb_frames = nb_frames;
+    tile_properties[id].frame_duration = frame_duration;
+
+    return true;
+}
+
+/* Sets the time of the animation clock shared by every animated tile. */
+void
+eng_tile_set_animation_clock (double time)
+{
+    animation_clock = time * 1000;
+}
+
+/*
+ * Returns the id of the tile sheet to draw for a tile id. The frame is found
+ * from the animation clock when the tile is drawn, so animated tiles are never
+ * updated one by one.
+ */
+int
+eng_tile_get_frame_id (int id)
+{
+    const EngTileProperties *properties = NULL;
+
+    if (id < 0 || id >= nb_tile_properties)
+        return id;
+
+    properties = &tile_properties[id];
+
+    if (!(properties->flags & ENG_TILE_ANIMATED) ||
+        properties->nb_frames <= 1) {
+        return id;
+    }
+
+    return id + (long) (animation_clock / properties->frame_duration) %
+                properties->nb_frames;
+}
+
+/* Returns the properties of a tile id. */
+EngTileProperties
+eng_tile_get_properties (int id)
+{
+    EngTileProperties properties = {0, 1, 1, 0};
+
+    if (id >= 0 && id < nb_tile_properties)
+        properties = tile_properties[id];
+
+    return properties;
+}
+
+/* Removes every registered tile property, unless the streamer reads them. */
+void
+eng_tile_clear_properties (void)
+{
+    if (eng_chunk_streamer_is_running ())
+        return;
+
+    free (tile_properties);
+    tile_properties = NULL;
+    nb_tile_properties = 0;
+}
+
+/*
+ * Changes the id of a tile and gives it the collision registered for its new
+ * id, so loading a chunk does not need a second pass over its tiles.
+ */
+void
+eng_tile_stamp_id (EngChunk *chunk, int x, int y, int id)
+{
+    bool is_solid = id >= 0 && id < nb_tile_properties &&
+                    (tile_properties[id].flags & ENG_TILE_SOLID);
+
+    if (id < ENG_TILE_MIN_ID || id > ENG_TILE_MAX_ID)
+        return;
+
+    eng_tile_set_id (chunk, x, y, id);
+    eng_tile_set_has_collision (chunk, x, y, is_solid);
+}
+
+/*
+ * Gives their ids to every tile of a chunk at once. The palette is built in a
+ * first pass, then the indices and the collision bits are written in a second
+ * pass without searching the palette or the registry again.
+ */
+void
+eng_tile_load_ids (EngChunk *chunk, const int32_t id[])
+{
+    static const int nb_tiles = TILESX * TILESY;
+    int16_t palette[256];
+    bool is_solid[256];
+    uint8_t index[TILESX * TILESY];
+    int16_t last_index[256];
+    int nb_palette_ids = 0;
+    int palette_index = 0;
+    int tile_id = 0;
+    int bits = 0;
+    bool has_solid_ids = false;
+
+    eng_tile_deallocate_tiles (chunk);
+    eng_tile_reset_collision (chunk);
+
+    memset (last_index, -1, sizeof(last_index));
+
+    /*
+     * The last index found for the low bits of an id is tried before
+     * searching the palette, so the palette is rarely searched. The ids are
+     * given row by row and the indices are stored in the tile layout.
+     */
+    for (int i = 0; i < nb_tiles && nb_palette_ids <= 256; i++) {
+        tile_id = get_storable_id (id[i]);
+        palette_index = last_index[tile_id & 0xFF];
+
+        if (palette_index < 0 || palette[palette_index] != tile_id) {
+            palette_index = 0;
+
+            while (palette_index < nb_palette_ids &&
+                   palette[palette_index] != tile_id) {
+                palette_index++;
+            }
+
+            if (palette_index == nb_palette_ids && nb_palette_ids++ < 256)
+                palette[palette_index] = tile_id;
+
+            last_index[tile_id & 0xFF] = palette_index;
+        }
+
+        index[eng_tile_get_index (i % TILESX, i / TILESX)] = palette_index;
+    }
+
+    /* More than 256 ids are stored directly. */
+    if (nb_palette_ids > 256) {
+        for (int i = 0; i < nb_tiles; i++) {
+            eng_tile_stamp_id (chunk, i % TILESX, i / TILESX,
+                               get_storable_id (id[i]));
+        }
+
+        return;
+    }
+
+    bits = nb_palette_ids <= 16 ? 4 : 8;
+    chunk->tile_data = (uint8_t*) malloc (get_data_size (bits));
+    chunk->tile_palette = (int16_t*) malloc ((1 << bits) * sizeof(int16_t));
+
+    if (chunk->tile_data == NULL || chunk->tile_palette == NULL) {
+        eng_tile_deallocate_tiles (chunk);
+        return;
+    }
+
+    for (int i = 0; i < nb_palette_ids; i++) {
+        chunk->tile_palette[i] = palette[i];
+        is_solid[i] = palette[i] >= 0 && palette[i] < nb_tile_properties &&
+                      (tile_properties[palette[i]].flags & ENG_TILE_SOLID);
+        has_solid_ids = has_solid_ids || is_solid[i];
+    }
+
+    chunk->tile_bits = bits;
+    chunk->nb_palette_ids = nb_palette_ids;
+
+    if (bits == 4) {
+        for (int i = 0; i < nb_tiles; i += 2) {
+            chunk->tile_data[i / 2] = index[i];
+
+            if (i + 1 < nb_tiles)
+                chunk->tile_data[i / 2] |= index[i + 1] << 4;
+        }
+    }
+    else
+        memcpy (chunk->tile_data, index, nb_tiles);
+
+    for (int y = 0; y < TILESY && has_solid_ids; y++) {
+        for (int x = 0; x < TILESX; x++) {
+            if (is_solid[index[eng_tile_get_index (x, y)]])
+                chunk->tile_collision[y][x / 64] |= (uint64_t) 1 << (x % 64);
+        }
+    }
+}
+
+/* Gives the same id to every tile of a chunk. */
+void
+eng_tile_fill (EngChunk *chunk, int id)
+{
+    for (int y = 0; y < TILESY; y++) {
+        for (int x = 0; x < TILESX; x++)
+            eng_tile_stamp_id (chunk, x, y, id);
+    }
+}
+
 /* Takes in a tile id from a formatted file and returns the id. */
 static int
 get_id_from_file (FILE *file)
@@ -160,10 +410,10 @@ void
 eng_tile_set_collision (EngChunk chunk[], int id, bool has_collision)
 {
     for (int i = 0; i < NBCHUNKS; i++) {
-        for (int x = 0; x < TILESX; x++) {
-            for (int y = 0; y < TILESY; y++) {
-                if (chunk[i].tile[x][y].id == id)
-                    chunk[i].tile[x][y].has_collision = has_collision;
+        for (int y = 0; y < TILESY; y++) {
+            for (int x = 0; x < TILESX; x++) {
+                if (eng_tile_get_id (&chunk[i], x, y) == id)
+                    eng_tile_set_has_collision (&chunk[i], x, y, has_collision);
             }
         }
     }
@@ -173,21 +423,248 @@ eng_tile_set_collision (EngChunk chunk[], int id, bool has_collision)
 void
 eng_tile_reset_collision(EngChunk *chunk)
 {
-    for (int x = 0; x < TILESX; x++) {
-        for (int y = 0; y < TILESY; y++)
-            chunk->tile[x][y].has_collision = false;
+    memset (chunk->tile_collision, 0, sizeof(chunk->tile_collision));
+    eng_clearance_mark_chunk (chunk);
+}
+
+/*
+ * Changes the id of a tile in memory. Chunks start without tile data (every
+ * tile is of id 0), then store 4 bit palette indices, 8 bit palette indices
+ * and finally 16 bit ids as the number of different ids grows. Ids that do
+ * not fit on 16 bits are rejected.
+ */
+void
+eng_tile_set_id (EngChunk *chunk, int x, int y, int id)
+{
+    int index = eng_tile_get_index (x, y);
+    int palette_index = 0;
+
+    if (id < ENG_TILE_MIN_ID || id > ENG_TILE_MAX_ID) {
+        printf ("Error: tile id %d is out of range\n", id);
+        return;
+    }
+
+    if (chunk->tile_bits == 0) {
+        if (id == 0 || !widen_tiles (chunk, 4))
+            return;
+    }
+
+    if (chunk->tile_bits < 16) {
+        palette_index = get_palette_index (chunk, id);
+
+        if (palette_index < 0) {
+            if (widen_tiles (chunk, chunk->tile_bits == 4 ? 8 : 16))
+                eng_tile_set_id (chunk, x, y, id);
+
+            return;
+        }
+    }
+
+    switch (chunk->tile_bits) {
+    case 4:
+        chunk->tile_data[index / 2] &= ~(0xF << (index % 2 * 4));
+        chunk->tile_data[index / 2] |= palette_index << (index % 2 * 4);
+        break;
+    case 8:
+        chunk->tile_data[index] = palette_index;
+        break;
+    case 16:
+        ((int16_t*) chunk->tile_data)[index] = id;
+        break;
     }
 }
 
-/* Creates an initializes a tile, then returns it. */
-EngTile
-eng_tile_create_tile (void)
+/* Copies the tile ids and the collision of a chunk to another chunk. */
+void
+eng_tile_copy_tiles (EngChunk *destination, const EngChunk *source)
 {
-    EngTile tile;
+    int nb_palette_ids = source->tile_bits < 16 ? 1 << source->tile_bits : 0;
+
+    eng_tile_deallocate_tiles (destination);
+
+    memcpy (destination->tile_collision, source->tile_collision,
+            sizeof(source->tile_collision));
+    destination->clearance_dirty = source->clearance_dirty;
+    destination->clearance_version = source->clearance_version;
+
+    /* Without a copy of the clearance, it is computed again when needed. */
+    if (source->tile_clearance != NULL) {
+        destination->tile_clearance = (uint8_t*) malloc (TILESX * TILESY);
+
+        if (destination->tile_clearance != NULL) {
+            memcpy (destination->tile_clearance, source->tile_clearance,
+                    TILESX * TILESY);
+        }
+    }
+
+    if (source->tile_bits == 0)
+        return;
 
-    tile.id = 0;
-    tile.frame = 0;
-    tile.has_collision = false;
+    destination->tile_data = (uint8_t*)
+                             malloc (get_data_size (source->tile_bits));
 
-    return tile;
+    if (nb_palette_ids > 0) {
+        destination->tile_palette = (int16_t*)
+                                    malloc (nb_palette_ids * sizeof(int16_t));
+    }
+
+    if (destination->tile_data == NULL ||
+        (nb_palette_ids > 0 && destination->tile_palette == NULL)) {
+        eng_tile_deallocate_tiles (destination);
+        return;
+    }
+
+    memcpy (destination->tile_data, source->tile_data,
+            get_data_size (source->tile_bits));
+
+    if (nb_palette_ids > 0) {
+        memcpy (destination->tile_palette, source->tile_palette,
+                source->nb_palette_ids * sizeof(int16_t));
+    }
+    destination->tile_bits = source->tile_bits;
+    destination->nb_palette_ids = source->nb_palette_ids;
+}
+
+/* Gives the tiles of a chunk to another chunk without copying them. */
+void
+eng_tile_move_tiles (EngChunk *destination, EngChunk *source)
+{
+    eng_tile_deallocate_tiles (destination);
+
+    memcpy (destination->tile_collision, source->tile_collision,
+            sizeof(source->tile_collision));
+    destination->clearance_dirty = source->clearance_dirty;
+    destination->clearance_version = source->clearance_version;
+    destination->tile_bits = source->tile_bits;
+    destination->nb_palette_ids = source->nb_palette_ids;
+    destination->tile_palette = source->tile_palette;
+    destination->tile_data = source->tile_data;
+    destination->tile_clearance = source->tile_clearance;
+
+    source->tile_bits = 0;
+    source->nb_palette_ids = 0;
+    source->tile_palette = NULL;
+    source->tile_data = NULL;
+    source->tile_clearance = NULL;
+}
+
+/* Frees the tile ids and the clearance of a chunk. */
+void
+eng_tile_deallocate_tiles (EngChunk *chunk)
+{
+    free (chunk->tile_data);
+    free (chunk->tile_palette);
+    free (chunk->tile_clearance);
+    chunk->tile_data = NULL;
+    chunk->tile_palette = NULL;
+    chunk->tile_clearance = NULL;
+    chunk->tile_bits = 0;
+    chunk->nb_palette_ids = 0;
+}
+
+/* Returns the number of bytes allocated for the tiles of a chunk. */
+long
+eng_tile_get_memory_size (const EngChunk *chunk)
+{
+    long size = 0;
+
+    if (chunk->tile_bits > 0)
+        size += get_data_size (chunk->tile_bits);
+
+    if (chunk->tile_bits > 0 && chunk->tile_bits < 16)
+        size += (1 << chunk->tile_bits) * sizeof(int16_t);
+
+    if (chunk->tile_clearance != NULL)
+        size += TILESX * TILESY;
+
+    return size;
+}
+
+/* Returns the index of an id in the palette of a chunk. */
+static int
+get_palette_index (EngChunk *chunk, int id)
+{
+    for (int i = 0; i < chunk->nb_palette_ids; i++) {
+        if (chunk->tile_palette[i] == id)
+            return i;
+    }
+
+    if (chunk->nb_palette_ids == 1 << chunk->tile_bits)
+        return -1;
+
+    chunk->tile_palette[chunk->nb_palette_ids] = id;
+
+    return chunk->nb_palette_ids++;
+}
+
+/*
+ * Stores the tile ids of a chunk with more bits per tile. Palette indices keep
+ * their value when going from 4 to 8 bits, so only the palette grows.
+ */
+static bool
+widen_tiles (EngChunk *chunk, int bits)
+{
+    uint8_t *data = (uint8_t*) calloc (get_data_size (bits), 1);
+    int16_t *palette = chunk->tile_palette;
+    int palette_index = 0;
+
+    if (data == NULL)
+        return false;
+
+    if (bits < 16) {
+        palette = (int16_t*) realloc (chunk->tile_palette,
+                                      (1 << bits) * sizeof(int16_t));
+
+        if (palette == NULL) {
+            free (data);
+            return false;
+        }
+
+        /* Chunks without tile data only have tiles of id 0. */
+        if (chunk->nb_palette_ids == 0) {
+            palette[0] = 0;
+            chunk->nb_palette_ids = 1;
+        }
+
+        chunk->tile_palette = palette;
+    }
+
+    /* Tiles keep their position, only the size of their entries changes. */
+    for (int i = 0; i < TILESX * TILESY && chunk->tile_bits > 0; i++) {
+        if (chunk->tile_bits == 4)
+            palette_index = (chunk->tile_data[i / 2] >> (i % 2 * 4)) & 0xF;
+        else
+            palette_index = chunk->tile_data[i];
+
+        if (bits == 8)
+            data[i] = palette_index;
+        else
+            ((int16_t*) data)[i] = chunk->tile_palette[palette_index];
+    }
+
+    free (chunk->tile_data);
+    chunk->tile_data = data;
+    chunk->tile_bits = bits;
+
+    if (bits == 16) {
+        free (chunk->tile_palette);
+        chunk->tile_palette = NULL;
+        chunk->nb_palette_ids = 0;
+    }
+
+    return true;
+}
+
+/* Returns the number of bytes used by the tile ids of a chunk. */
+static long
+get_data_size (int bits)
+{
+    return ((long) TILESX * TILESY * bits + 7) / 8;
+}
+
+/* Returns an id that tiles can store, or -1. */
+static int
+get_storable_id (int id)
+{
+    return id >= ENG_TILE_MIN_ID && id <= ENG_TILE_MAX_ID ? id : -1;
 }
@@ -2,6 +2,13 @@
 #define TILE_H_INCLUDED
 
 #include "../Engine/globals.h"
+#include "clearance.h"
+
+/** Smallest tile id, tiles store their ids on 16 bits at most. */
+#define ENG_TILE_MIN_ID INT16_MIN
+
+/** Largest tile id, tiles store their ids on 16 bits at most. */
+#define ENG_TILE_MAX_ID INT16_MAX
 
 /**
  * @brief Stores tile data coming from a chunk file to a chunk.
@@ -10,6 +17,116 @@
  */
 void eng_tile_load_tiles (EngChunk *chunk);
 
+/**
+ * @brief Registers the properties of a tile id. Tiles are given the collision
+ *        of their id when they are loaded, so the properties must be
+ *        registered before the chunks are loaded and while the chunk
+ *        streamer is stopped.
+ *
+ * @param id:            The tile id (0 or more).
+ * @param flags:         Flags of the tile id (see EngTileFlag).
+ * @param movement_cost: Cost of walking on a tile of this id.
+ *
+ * @return True if the properties were registered, false otherwise (also
+ *         while the chunk streamer is running).
+ *
+ * @sa eng_tile_get_properties ()
+ */
+bool eng_tile_register_properties (int id, unsigned int flags,
+                                   int movement_cost);
+
+/**
+ * @brief Returns the properties of a tile id. Ids that were never registered
+ *        have no flags and a movement cost of 1.
+ *
+ * @param id: The tile id.
+ *
+ * @return The properties of the tile id.
+ */
+EngTileProperties eng_tile_get_properties (int id);
+
+/**
+ * @brief Removes every registered tile property. Must be called while the
+ *        chunk streamer is stopped.
+ */
+void eng_tile_clear_properties (void);
+
+/**
+ * @brief Animates every tile of an id. The frames of the animation are the
+ *        ids following it in the tile sheet, the tile id being the first
+ *        frame. The animation plays while the id has the ENG_TILE_ANIMATED
+ *        flag.
+ *
+ * @param id:             The tile id (0 or more).
+ * @param nb_frames:      Number of frames of the animation (1 or more).
+ * @param frame_duration: Time each frame is shown, in milliseconds.
+ *
+ * @return True if the animation was registered, false otherwise (also while
+ *         the chunk streamer is running).
+ *
+ * @sa eng_tile_get_frame_id ()
+ */
+bool eng_tile_register_animation (int id, int nb_frames, int frame_duration);
+
+/**
+ * @brief Sets the time of the animation clock shared by every animated tile.
+ *        Called once per frame, before the tiles are rendered.
+ *
+ * @param time: The time of the clock in seconds.
+ *
+ * @sa eng_tile_get_frame_id ()
+ */
+void eng_tile_set_animation_clock (double time);
+
+/**
+ * @brief Returns the id of the tile sheet to draw for a tile id, which is the
+ *        current frame of its animation according to the animation clock.
+ *
+ * @param id: The tile id.
+ *
+ * @return The id of the current frame, the id itself if it does not have
+ *         the ENG_TILE_ANIMATED flag or a registered animation.
+ *
+ * @sa eng_tile_register_animation ()
+ */
+int eng_tile_get_frame_id (int id);
+
+/**
+ * @brief Changes the id of a tile and gives it the collision registered for
+ *        its new id. Used by the chunk loaders while tiles are read.
+ *
+ * @param chunk: Chunk containing the tile.
+ * @param x:     The tile in x (0 to TILESX - 1).
+ * @param y:     The tile in y (0 to TILESY - 1).
+ * @param id:    The new id of the tile (ENG_TILE_MIN_ID to ENG_TILE_MAX_ID,
+ *               other ids leave the tile unchanged).
+ *
+ * @sa eng_tile_register_properties ()
+ */
+void eng_tile_stamp_id (EngChunk *chunk, int x, int y, int id);
+
+/**
+ * @brief Gives their ids to every tile of a chunk at once, along with the
+ *        collision registered for them. Used by the chunk loaders, it picks
+ *        the smallest palette that fits the ids.
+ *
+ * @param chunk: Chunk to fill.
+ * @param id:    TILESX * TILESY tile ids, row by row. Ids outside of
+ *               ENG_TILE_MIN_ID to ENG_TILE_MAX_ID are stored as -1.
+ *
+ * @sa eng_tile_stamp_id ()
+ */
+void eng_tile_load_ids (EngChunk *chunk, const int32_t id[]);
+
+/**
+ * @brief Gives the same id to every tile of a chunk, along with the collision
+ *        registered for it.
+ *
+ * @param chunk: Chunk to fill.
+ * @param id:    The id given to every tile.
+ */
+void eng_tile_fill (EngChunk *chunk, int id);
+
 /**
  * @brief Sets the collision of all tiles with a certain id to true or false.
  *
@@ -31,22 +148,189 @@ void eng_tile_set_collision (EngChunk chunk[], int id, bool has_collision);
 void eng_tile_reset_collision (EngChunk *chunk);
 
 /**
- * @brief Modifies the value of a tile in a chunk text file.
+ * @brief Modifies the value of a tile in a chunk text file. The edit is
+ *        applied in memory and the file is written by the chunk writer.
  *
  * @param chunk_x: The chunk id in x for the file to modify.
  * @param chunk_y: The chunk id in y for the file to modify.
  * @param tile_x:  The tile in x to be modify in the chunk file.
  * @param tile_y:  The tile in y to be modify in the chunk file.
  * @param new_id:  New tile id to replace the old tile id.
+ *
+ * @sa eng_chunk_writer_flush ()
  */
 void eng_tile_modify_file_id (int chunk_x, int chunk_y, int tile_x, int tile_y,
                               int new_id);
 
 /**
- * @brief Creates an initializes a tile, then returns it.
+ * @brief Changes the id of a tile in memory. The palette of the chunk grows
+ *        to 8 bit indices, then to 16 bit ids, when it overflows.
+ *
+ * @param chunk: Chunk containing the tile.
+ * @param x:     The tile in x (0 to TILESX - 1).
+ * @param y:     The tile in y (0 to TILESY - 1).
+ * @param id:    The new id of the tile (ENG_TILE_MIN_ID to ENG_TILE_MAX_ID,
+ *               other ids are rejected and leave the tile unchanged).
  *
- * @return A new initialized tile.
+ * @sa eng_tile_stamp_id ()
  */
-EngTile eng_tile_create_tile (void);
+void eng_tile_set_id (EngChunk *chunk, int x, int y, int id);
+
+/**
+ * @brief Copies the tile ids, the collision and the clearance of a chunk to
+ *        another chunk.
+ *
+ * @param destination: Chunk receiving the tiles.
+ * @param source:      Chunk to copy the tiles of.
+ *
+ * @sa eng_tile_move_tiles ()
+ */
+void eng_tile_copy_tiles (EngChunk *destination, const EngChunk *source);
+
+/**
+ * @brief Gives the tile ids and the collision of a chunk to another chunk
+ *        without copying them. The source chunk is left with tiles of id 0.
+ *
+ * @param destination: Chunk receiving the tiles.
+ * @param source:      Chunk giving its tiles.
+ */
+void eng_tile_move_tiles (EngChunk *destination, EngChunk *source);
+
+/**
+ * @brief Frees the tile ids and the clearance of a chunk, all of its tiles
+ *        are then of id 0.
+ *
+ * @param chunk: Chunk to free the tile ids of.
+ */
+void eng_tile_deallocate_tiles (EngChunk *chunk);
+
+/**
+ * @brief Returns the number of bytes allocated for the tiles of a chunk (ids,
+ *        palette and clearance).
+ *
+ * @param chunk: Chunk to measure.
+ *
+ * @return The number of bytes allocated for the tiles.
+ */
+long eng_tile_get_memory_size (const EngChunk *chunk);
+
+/*---------------------------------------------------------------------------*/
+/* Tile accessors                                                            */
+/*---------------------------------------------------------------------------*/
+
+/*
+ * The accessors below are used by the render, collision and pathfinding
+ * loops, they are defined here so they can be inlined.
+ */
+
+/**
+ * @brief Returns the position of a point along a Z curve (Morton order), by
+ *        interleaving the bits of x and y.
+ *
+ * @param x: Position in x (0 to 65535).
+ * @param y: Position in y (0 to 65535).
+ *
+ * @return The position along the Z curve, x taking the even bits.
+ */
+inline int
+eng_tile_get_morton_index (int x, int y)
+{
+    unsigned int morton_x = x;
+    unsigned int morton_y = y;
+
+    morton_x = (morton_x | morton_x << 8) & 0x00FF00FF;
+    morton_x = (morton_x | morton_x << 4) & 0x0F0F0F0F;
+    morton_x = (morton_x | morton_x << 2) & 0x33333333;
+    morton_x = (morton_x | morton_x << 1) & 0x55555555;
+    morton_y = (morton_y | morton_y << 8) & 0x00FF00FF;
+    morton_y = (morton_y | morton_y << 4) & 0x0F0F0F0F;
+    morton_y = (morton_y | morton_y << 2) & 0x33333333;
+    morton_y = (morton_y | morton_y << 1) & 0x55555555;
+
+    return morton_x | morton_y << 1;
+}
+
+/**
+ * @brief Returns the position of a tile in the tile ids of a chunk, which
+ *        depends on ENG_TILE_LAYOUT.
+ *
+ * @param x: The tile in x (0 to TILESX - 1).
+ * @param y: The tile in y (0 to TILESY - 1).
+ *
+ * @return The position of the tile (0 to TILESX * TILESY - 1).
+ */
+inline int
+eng_tile_get_index (int x, int y)
+{
+#if ENG_TILE_LAYOUT == ENG_TILE_LAYOUT_MORTON
+    return eng_tile_get_morton_index (x, y);
+#else
+    return y * TILESX + x;
+#endif
+}
+
+/**
+ * @brief Returns the id of a tile.
+ *
+ * @param chunk: Chunk containing the tile.
+ * @param x:     The tile in x (0 to TILESX - 1).
+ * @param y:     The tile in y (0 to TILESY - 1).
+ *
+ * @return The id of the tile.
+ */
+inline int
+eng_tile_get_id (const EngChunk *chunk, int x, int y)
+{
+    int index = eng_tile_get_index (x, y);
+
+    switch (chunk->tile_bits) {
+    case 4:
+        return chunk->tile_palette[(chunk->tile_data[index / 2] >>
+                                    (index % 2 * 4)) & 0xF];
+    case 8:
+        return chunk->tile_palette[chunk->tile_data[index]];
+    case 16:
+        return ((const int16_t*) chunk->tile_data)[index];
+    default:
+        return 0;
+    }
+}
+
+/**
+ * @brief Tells if a tile has collision.
+ *
+ * @param chunk: Chunk containing the tile.
+ * @param x:     The tile in x (0 to TILESX - 1).
+ * @param y:     The tile in y (0 to TILESY - 1).
+ *
+ * @return True if the tile has collision, false otherwise.
+ */
+inline bool
+eng_tile_has_collision (const EngChunk *chunk, int x, int y)
+{
+    return (chunk->tile_collision[y][x / 64] >> (x % 64)) & 1;
+}
+
+/**
+ * @brief Gives or removes the collision of a single tile.
+ *
+ * @param chunk:         Chunk containing the tile.
+ * @param x:             The tile in x (0 to TILESX - 1).
+ * @param y:             The tile in y (0 to TILESY - 1).
+ * @param has_collision: True to give collision, false to remove it.
+ *
+ * @sa eng_tile_set_collision (), eng_clearance_mark_tile ()
+ */
+inline void
+eng_tile_set_has_collision (EngChunk *chunk, int x, int y, bool has_collision)
+{
+    if (has_collision != eng_tile_has_collision (chunk, x, y))
+        eng_clearance_mark_tile (chunk, x, y);
+
+    if (has_collision)
+        chunk->tile_collision[y][x / 64] |= (uint64_t) 1 << (x % 64);
+    else
+        chunk->tile_collision[y][x / 64] &= ~((uint64_t) 1 << (x % 64));
+}
 
 #endif /* TILE_H_INCLUDED */
@@ -4,144 +4,601 @@
 /* Created On: 2020-08-05                                                    */
 /* Developed Using: SDL2                                                     */
 /* Function: Provides the user with a function that retrieves collision data */
-/*           between a character and tiles.                                  */
+/*           between a character and tiles or object footprints.             */
 /*===========================================================================*/
 
 #include <stdbool.h>
-#include "../Characters/character.h"
+#include "../Chunks/chunk.h"
+#include "../Chunks/objects.h"
+#include "../Chunks/tile.h"
 #include "collision_handler.h"
 
+/** Number of hit boxes whose coordinates are converted to tiles at once. */
+#define COLLISION_BLOCK 256
+
+typedef struct _CollisionWindow {
+    EngChunk *chunk[CHUNKSY][CHUNKSX];
+    int chunk_x;
+    int chunk_y;
+    bool has_objects;
+} CollisionWindow;
+/**< Chunks of the chunk window, found once for many collision queries. */
+
 /*---------------------------------------------------------------------------*/
 /* Local function prototypes                                                 */
 /*---------------------------------------------------------------------------*/
 
 /**
- * @brief Checks if a specified point ends up on a tile with the collision tag.
+ * @brief Finds the chunks of the chunk window from their coordinates.
+ *
+ * @param chunk:  Array of chunks of the chunk window.
+ * @param window: Window receiving the chunks.
+ */
+static void get_window (EngChunk chunk[], CollisionWindow *window);
+
+/**
+ * @brief Returns a chunk of the chunk window from its world chunk
+ *        coordinates.
+ *
+ * @param window:  Chunks of the chunk window.
+ * @param chunk_x: The chunk in x.
+ * @param chunk_y: The chunk in y.
+ *
+ * @return The chunk, or NULL if it is not in the chunk window.
+ */
+static EngChunk * get_window_chunk (const CollisionWindow *window,
+                                    int chunk_x, int chunk_y);
+
+/**
+ * @brief Divides two integers, rounding towards negative infinity.
  *
- * @param chunk:    Array of chunks in which to check collision.
- * @param point:    A hit box point.
- * @param offset_X: Offset to apply to the x value of the hit box point.
- * @param offset_Y: Offset to apply to the y value of the hit box point.
+ * @param dividend: The number divided.
+ * @param divisor:  The number dividing (larger than zero).
  *
- * @return False if the point is in a tile without collision, true if it is
- *         in a tile with collision.
+ * @return The quotient rounded down.
  */
-static bool check_collision_on_tile (EngChunk chunk[], EngPoint2d point,
-                                     int offset_x, int offset_y);
+static int floor_divide (int dividend, int divisor);
+
+/**
+ * @brief Moves up to COLLISION_BLOCK hit boxes along x, then along y, and
+ *        returns how far each can go. The coordinates of every hit box are
+ *        converted to tiles before any of them is moved.
+ *
+ * @param window:      Chunks of the chunk window.
+ * @param hitbox:      Hit boxes to move.
+ * @param move:        Movement wanted for each hit box, in pixels.
+ * @param movement:    Array receiving the movement allowed for each hit box.
+ * @param nb_hitboxes: Number of hit boxes (0 to COLLISION_BLOCK).
+ */
+static void sweep_block (const CollisionWindow *window, const SDL_Rect hitbox[],
+                         const EngPoint2d move[], EngPoint2d movement[],
+                         int nb_hitboxes);
+
+/**
+ * @brief Moves a hit box along x and returns how far it can go.
+ *
+ * @param window:    Chunks of the chunk window.
+ * @param first_row: First tile row covered by the hit box.
+ * @param last_row:  Last tile row covered by the hit box.
+ * @param first:     First tile column entered by the hit box.
+ * @param last:      Last tile column entered by the hit box.
+ * @param edge:      Leading edge of the hit box, in pixels.
+ * @param move_x:    Movement wanted in x, in pixels.
+ *
+ * @return The movement allowed in x.
+ */
+static int sweep_x (const CollisionWindow *window, int first_row, int last_row,
+                    int first, int last, int edge, int move_x);
+
 /**
- * @brief Scans an array of chunks and returns the index of the chunk with
- *        the requested x and y chunk values.
+ * @brief Moves a hit box along y and returns how far it can go.
  *
- * @param chunk:   Array of chunks to scan.
- * @param chunk_x: Value of the chunk in x to find in the array of chunks.
- * @param chunk_y: Value of the chunk in y to find in the array of chunks.
+ * @param window:   Chunks of the chunk window.
+ * @param row:      First tile row entered by the hit box.
+ * @param last_row: Last tile row entered by the hit box.
+ * @param first:    First tile column covered by the hit box.
+ * @param last:     Last tile column covered by the hit box.
+ * @param edge:     Leading edge of the hit box, in pixels.
+ * @param move_y:   Movement wanted in y, in pixels.
  *
- * @return The index of the chunk with the corresponding chunk_x and chunk_y
- *         values from the array of chunks sent in parameters
- *         (-1 if not found).
+ * @return The movement allowed in y.
  */
-static int get_chunk_index (EngChunk chunk[], int chunk_x, int chunk_y);
+static int sweep_y (const CollisionWindow *window, int row, int last_row,
+                    int first, int last, int edge, int move_y);
+
+/**
+ * @brief Shortens a movement so that the hit box stops before the object
+ *        footprints it would enter. Only the object grid cells of the area
+ *        swept are searched. Footprints the hit box already overlaps do not
+ *        stop it.
+ *
+ * @param window: Chunks of the chunk window.
+ * @param area:   Area swept by the hit box, in world pixels.
+ * @param is_x:   True for a movement in x, false for a movement in y.
+ * @param edge:   Leading edge of the hit box, in pixels.
+ * @param move:   Movement allowed by the tiles, in pixels.
+ *
+ * @return The movement allowed by the objects.
+ */
+static int sweep_objects (const CollisionWindow *window, SDL_Rect area,
+                          bool is_x, int edge, int move);
+
+/**
+ * @brief Searches a range of tiles of a world row for a tile with collision.
+ *        The range may cross chunks, tiles outside of the chunk window have
+ *        collision.
+ *
+ * @param window:     Chunks of the chunk window.
+ * @param row:        The world tile row.
+ * @param first:      First world tile column of the range.
+ * @param last:       Last world tile column of the range.
+ * @param is_forward: True to find the first tile of the range with collision,
+ *                    false to find the last one.
+ * @param column:     Pointer receiving the world column of the tile found.
+ *
+ * @return True if a tile with collision was found, false otherwise.
+ */
+static bool find_collision_in_row (const CollisionWindow *window, int row,
+                                   int first, int last, bool is_forward,
+                                   int *column);
+
+/**
+ * @brief Searches a range of bits of a collision row for a set bit, 64 tiles
+ *        at a time.
+ *
+ * @param bits:       Collision row of a chunk.
+ * @param first:      First tile of the range in the chunk.
+ * @param last:       Last tile of the range in the chunk.
+ * @param is_forward: True to find the first set bit, false to find the last.
+ * @param column:     Pointer receiving the tile found in the chunk.
+ *
+ * @return True if a set bit was found, false otherwise.
+ */
+static bool find_bit_in_range (const uint64_t bits[], int first, int last,
+                               bool is_forward, int *column);
 
 /*---------------------------------------------------------------------------*/
 /* Collision handling function implementations                               */
 /*---------------------------------------------------------------------------*/
 
-/* Returns collision data for a character in the form of booleans. */
+/*
+ * Returns collision data for a character in the form of booleans. Each
+ * pressed direction is swept by the speed of the character, so tiles between
+ * the corners of wide hit boxes are not missed.
+ */
 EngCollision
 eng_get_char_collision (EngChunk chunk[], EngCharacter character,
                         EngEvent event)
 {
     EngCollision collision = {false, false, false, false};
+    CollisionWindow window;
+    SDL_Rect hitbox[4];
+    EngPoint2d move[4];
+    EngPoint2d movement[4];
+    int speed = character.speed;
+
+    get_window (chunk, &window);
+
+    for (int i = 0; i < 4; i++) {
+        hitbox[i] = character.hitbox;
+        move[i].x = 0;
+        move[i].y = 0;
+    }
 
-    /* Points of the character's hit box. */
-    EngPoint2d top_left = {character.hitbox.x, character.hitbox.y};
-    EngPoint2d top_right = {character.hitbox.x + character.hitbox.w,
-                            character.hitbox.y};
-    EngPoint2d bottom_left = {character.hitbox.x, character.hitbox.y +
-                              character.hitbox.h};
-    EngPoint2d bottom_right = {character.hitbox.x + character.hitbox.w,
-                               character.hitbox.y + character.hitbox.h};
-
-        /* Check for collision when going left. */
-        if (event.left_pressed) {
-            collision.left = check_collision_on_tile (chunk, top_left,
-                                                      -character.speed, 0);
-            if (!collision.left)
-                collision.left = check_collision_on_tile (chunk, bottom_left,
-                                                          -character.speed, 0);
+    /* Directions that are not pressed are not moved, so never collide. */
+    move[0].x = event.left_pressed ? -speed : 0;
+    move[1].x = event.right_pressed ? speed : 0;
+    move[2].y = event.up_pressed ? -speed : 0;
+    move[3].y = event.down_pressed ? speed : 0;
+
+    sweep_block (&window, hitbox, move, movement, 4);
+
+    collision.left = movement[0].x != move[0].x;
+    collision.right = movement[1].x != move[1].x;
+    collision.up = movement[2].y != move[2].y;
+    collision.down = movement[3].y != move[3].y;
+
+    return collision;
+}
+
+/*
+ * Returns collision data for many characters, each moving by its own amount.
+ * The chunk window is searched once for the whole array.
+ */
+void
+eng_get_chars_collision (EngChunk chunk[], const EngCharacter character[],
+                         const EngPoint2d move[], EngCollision collision[],
+                         int nb_characters)
+{
+    CollisionWindow window;
+    SDL_Rect hitbox[COLLISION_BLOCK];
+    EngPoint2d movement[COLLISION_BLOCK];
+    int nb_hitboxes = 0;
+
+    get_window (chunk, &window);
+
+    for (int i = 0; i < nb_characters; i += COLLISION_BLOCK) {
+        nb_hitboxes = nb_characters - i < COLLISION_BLOCK ?
+                      nb_characters - i : COLLISION_BLOCK;
+
+        for (int j = 0; j < nb_hitboxes; j++)
+            hitbox[j] = character[i + j].hitbox;
+
+        sweep_block (&window, hitbox, &move[i], movement, nb_hitboxes);
+
+        for (int j = 0; j < nb_hitboxes; j++) {
+            collision[i + j].left = movement[j].x > move[i + j].x;
+            collision[i + j].right = movement[j].x < move[i + j].x;
+            collision[i + j].up = movement[j].y > move[i + j].y;
+            collision[i + j].down = movement[j].y < move[i + j].y;
         }
-        /* Check for collision when going right. */
-        if (event.right_pressed) {
-            collision.right = check_collision_on_tile (chunk, top_right,
-                                                       character.speed, 0);
-            if (!collision.right)
-                collision.right = check_collision_on_tile (chunk, bottom_right,
-                                                           character.speed, 0);
+    }
+}
+
+/*
+ * Moves a hit box along x, then along y from where it stopped, and returns
+ * how far it can go on each axis.
+ */
+EngPoint2d
+eng_get_swept_movement (EngChunk chunk[], SDL_Rect hitbox, int move_x,
+                        int move_y)
+{
+    CollisionWindow window;
+    EngPoint2d move = {move_x, move_y};
+    EngPoint2d movement = {0, 0};
+
+    get_window (chunk, &window);
+    sweep_block (&window, &hitbox, &move, &movement, 1);
+
+    return movement;
+}
+
+/*
+ * Moves many hit boxes, each by its own amount. The chunk window is searched
+ * once for the whole array.
+ */
+void
+eng_get_swept_movements (EngChunk chunk[], const SDL_Rect hitbox[],
+                         const EngPoint2d move[], EngPoint2d movement[],
+                         int nb_hitboxes)
+{
+    CollisionWindow window;
+
+    get_window (chunk, &window);
+
+    for (int i = 0; i < nb_hitboxes; i += COLLISION_BLOCK) {
+        sweep_block (&window, &hitbox[i], &move[i], &movement[i],
+                     nb_hitboxes - i < COLLISION_BLOCK ?
+                     nb_hitboxes - i : COLLISION_BLOCK);
+    }
+}
+
+/* Finds the chunks of the chunk window from their coordinates. */
+static void
+get_window (EngChunk chunk[], CollisionWindow *window)
+{
+    eng_chunk_get_window_origin (chunk, &window->chunk_x, &window->chunk_y);
+    window->has_objects = false;
+
+    for (int y = 0; y < CHUNKSY; y++) {
+        for (int x = 0; x < CHUNKSX; x++) {
+            window->chunk[y][x] = eng_chunk_get_chunk (chunk,
+                                                       window->chunk_x + x,
+                                                       window->chunk_y + y);
+
+            /* Grids of objects that changed are built again here. */
+            if (window->chunk[y][x] != NULL &&
+                eng_object_get_grid (window->chunk[y][x]) != NULL) {
+                window->has_objects = true;
+            }
         }
-        /* Check for collision when going up. */
-        if (event.up_pressed) {
-            collision.up = check_collision_on_tile (chunk, top_left, 0,
-                                                    -character.speed);
-            if (!collision.up)
-                collision.up = check_collision_on_tile (chunk, top_right, 0,
-                                                        -character.speed);
+    }
+}
+
+/* Returns a chunk of the chunk window from its world chunk coordinates. */
+static EngChunk *
+get_window_chunk (const CollisionWindow *window, int chunk_x, int chunk_y)
+{
+    chunk_x -= window->chunk_x;
+    chunk_y -= window->chunk_y;
+
+    if (chunk_x < 0 || chunk_x >= CHUNKSX || chunk_y < 0 ||
+        chunk_y >= CHUNKSY) {
+        return NULL;
+    }
+
+    return window->chunk[chunk_y][chunk_x];
+}
+
+/*
+ * Divides two integers, rounding towards negative infinity. There is no
+ * branch, so the loops converting many coordinates can be vectorized.
+ */
+static int
+floor_divide (int dividend, int divisor)
+{
+    return (dividend - (dividend < 0 ? divisor - 1 : 0)) / divisor;
+}
+
+/*
+ * Moves hit boxes along x, then along y. Each axis is done in two loops: the
+ * first converts the coordinates of every hit box to tiles and has no
+ * branch, so it can be vectorized, the second searches the collision bits.
+ * The object footprints are searched last, only when a chunk has some.
+ */
+static void
+sweep_block (const CollisionWindow *window, const SDL_Rect hitbox[],
+             const EngPoint2d move[], EngPoint2d movement[], int nb_hitboxes)
+{
+    int edge[COLLISION_BLOCK];
+    int first[COLLISION_BLOCK];
+    int last[COLLISION_BLOCK];
+    int first_row[COLLISION_BLOCK];
+    int last_row[COLLISION_BLOCK];
+    SDL_Rect area;
+    int x = 0;
+
+    /* Columns entered and rows covered by the hit boxes moving in x. */
+    for (int i = 0; i < nb_hitboxes; i++) {
+        edge[i] = move[i].x > 0 ? hitbox[i].x + hitbox[i].w : hitbox[i].x;
+        first_row[i] = floor_divide (hitbox[i].y, TILESIZE);
+        last_row[i] = floor_divide (hitbox[i].y + hitbox[i].h, TILESIZE);
+        first[i] = move[i].x > 0 ?
+                   floor_divide (edge[i], TILESIZE) + 1 :
+                   floor_divide (edge[i] + move[i].x, TILESIZE);
+        last[i] = move[i].x > 0 ?
+                  floor_divide (edge[i] + move[i].x, TILESIZE) :
+                  floor_divide (edge[i], TILESIZE) - 1;
+    }
+
+    for (int i = 0; i < nb_hitboxes; i++) {
+        movement[i].x = sweep_x (window, first_row[i], last_row[i], first[i],
+                                 last[i], edge[i], move[i].x);
+    }
+
+    for (int i = 0; i < nb_hitboxes && window->has_objects; i++) {
+        if (movement[i].x != 0) {
+            area.x = movement[i].x > 0 ? edge[i] + 1 : edge[i] + movement[i].x;
+            area.y = hitbox[i].y;
+            area.w = movement[i].x > 0 ? movement[i].x : -movement[i].x;
+            area.h = hitbox[i].h + 1;
+            movement[i].x = sweep_objects (window, area, true, edge[i],
+                                           movement[i].x);
         }
-        /* Check for collision when going down. */
-        if (event.down_pressed) {
-            collision.down = check_collision_on_tile (chunk, bottom_left, 0,
-                                                      character.speed);
-            if (!collision.down)
-                collision.down = check_collision_on_tile (chunk, bottom_right,
-                                                          0, character.speed);
+    }
+
+    /* Rows entered and columns covered by the hit boxes moving in y. */
+    for (int i = 0; i < nb_hitboxes; i++) {
+        x = hitbox[i].x + movement[i].x;
+        edge[i] = move[i].y > 0 ? hitbox[i].y + hitbox[i].h : hitbox[i].y;
+        first[i] = floor_divide (x, TILESIZE);
+        last[i] = floor_divide (x + hitbox[i].w, TILESIZE);
+        first_row[i] = floor_divide (edge[i], TILESIZE) +
+                       (move[i].y > 0 ? 1 : -1);
+        last_row[i] = floor_divide (edge[i] + move[i].y, TILESIZE);
+    }
+
+    for (int i = 0; i < nb_hitboxes; i++) {
+        movement[i].y = sweep_y (window, first_row[i], last_row[i], first[i],
+                                 last[i], edge[i], move[i].y);
+    }
+
+    for (int i = 0; i < nb_hitboxes && window->has_objects; i++) {
+        if (movement[i].y != 0) {
+            area.x = hitbox[i].x + movement[i].x;
+            area.y = movement[i].y > 0 ? edge[i] + 1 : edge[i] + movement[i].y;
+            area.w = hitbox[i].w + 1;
+            area.h = movement[i].y > 0 ? movement[i].y : -movement[i].y;
+            movement[i].y = sweep_objects (window, area, false, edge[i],
+                                           movement[i].y);
         }
+    }
+}
 
-    return collision;
+/*
+ * Moves a hit box along x. Only the columns entered by the leading edge are
+ * tested, each row of the hit box being searched as a range of bits. The
+ * range shrinks every time a closer tile is found.
+ */
+static int
+sweep_x (const CollisionWindow *window, int first_row, int last_row,
+         int first, int last, int edge, int move_x)
+{
+    int column = 0;
+
+    for (int row = first_row; row <= last_row && first <= last; row++) {
+        if (find_collision_in_row (window, row, first, last, move_x > 0,
+                                   &column)) {
+            if (move_x > 0) {
+                last = column - 1;
+                move_x = column * TILESIZE - 1 - edge;
+            }
+            else {
+                first = column + 1;
+                move_x = (column + 1) * TILESIZE - edge;
+            }
+        }
+    }
+
+    return move_x;
 }
 
-/* Checks if a specified point ends up on a tile with the collision tag. */
-static bool
-check_collision_on_tile (EngChunk chunk[], EngPoint2d point,
-                         int offset_x, int offset_y)
+/*
+ * Moves a hit box along y. The rows entered by the leading edge are tested
+ * from the closest one, each against the columns of the hit box, and the
+ * first row with collision stops the hit box.
+ */
+static int
+sweep_y (const CollisionWindow *window, int row, int last_row, int first,
+         int last, int edge, int move_y)
 {
-    bool collision = false;
-    int chunk_index = 0;
-    EngPoint2d tile = {-1, -1};
-
-    /*
-     * Find the tile that the selected point from the character's hit box
-     * would end up on if it was affected by an offset.
-     */
-    tile.x = eng_char_get_tile_x (point.x + offset_x);
-    tile.y = eng_char_get_tile_y (point.y + offset_y);
-
-    /*
-     * Same thing here but this time we are finding the chunk that the point
-     * ends up in depending on the offset.
-     */
-    chunk_index = get_chunk_index (chunk,
-                                   eng_char_get_chunk_x (point.x + offset_x),
-                                   eng_char_get_chunk_y (point.y + offset_y));
-
-    if (chunk[chunk_index].tile[tile.x][tile.y].has_collision)
-        collision = true;
+    int step = move_y > 0 ? 1 : -1;
+    int column = 0;
 
-    return collision;
+    if (move_y == 0)
+        return 0;
+
+    for (/* Empty. */; row != last_row + step; row += step) {
+        if (find_collision_in_row (window, row, first, last, true, &column)) {
+            if (move_y > 0)
+                return row * TILESIZE - 1 - edge;
+            else
+                return (row + 1) * TILESIZE - edge;
+        }
+    }
+
+    return move_y;
 }
 
 /*
- * Scans an array of chunks and returns the index of the chunk with the
- * requested x and y values.
+ * Shortens a movement so that the hit box stops before the object footprints
+ * it would enter. Chunks whose footprints are all away from the area swept
+ * are skipped, the others are searched in the cells of the object grid the
+ * area covers. A footprint may be found in many cells, which gives the same
+ * result.
  */
 static int
-get_chunk_index (EngChunk chunk[], int chunk_x, int chunk_y)
+sweep_objects (const CollisionWindow *window, SDL_Rect area, bool is_x,
+               int edge, int move)
 {
-    int index = -1;
+    const EngObjectGrid *grid = NULL;
+    const SDL_Rect *footprint = NULL;
+    SDL_Rect local;
+    int first_x = 0;
+    int first_y = 0;
+    int last_x = 0;
+    int last_y = 0;
+    int cell = 0;
+    int front = 0;
+    int back = 0;
 
     for (int i = 0; i < NBCHUNKS; i++) {
-        index = i;
-        if (chunk[i].chunk_x == chunk_x && chunk[i].chunk_y == chunk_y)
-            break;
+        if (window->chunk[i / CHUNKSX][i % CHUNKSX] == NULL ||
+            window->chunk[i / CHUNKSX][i % CHUNKSX]->object_grid == NULL) {
+            continue;
+        }
+
+        /* The area in pixels of the chunk. */
+        grid = window->chunk[i / CHUNKSX][i % CHUNKSX]->object_grid;
+        local = area;
+        local.x -= (window->chunk_x + i % CHUNKSX) * TILESX * TILESIZE;
+        local.y -= (window->chunk_y + i / CHUNKSX) * TILESY * TILESIZE;
+
+        if (!SDL_HasIntersection (&local, &grid->bounds))
+            continue;
+
+        first_x = eng_object_get_cell (local.x, ENG_OBJECT_CELLSX);
+        first_y = eng_object_get_cell (local.y, ENG_OBJECT_CELLSY);
+        last_x = eng_object_get_cell (local.x + local.w - 1, ENG_OBJECT_CELLSX);
+        last_y = eng_object_get_cell (local.y + local.h - 1, ENG_OBJECT_CELLSY);
+
+        for (int y = first_y; y <= last_y; y++) {
+            for (int x = first_x; x <= last_x; x++) {
+                cell = y * ENG_OBJECT_CELLSX + x;
+
+                for (int j = grid->cell_start[cell];
+                     j < grid->cell_start[cell + 1]; j++) {
+                    footprint = &grid->footprint[j];
+
+                    if (!SDL_HasIntersection (&local, footprint))
+                        continue;
+
+                    front = is_x ? footprint->x - local.x + area.x :
+                                   footprint->y - local.y + area.y;
+                    back = is_x ? front + footprint->w - 1 :
+                                  front + footprint->h - 1;
+
+                    if (move > 0 && front > edge && front - 1 - edge < move)
+                        move = front - 1 - edge;
+                    else if (move < 0 && back < edge &&
+                             back + 1 - edge > move) {
+                        move = back + 1 - edge;
+                    }
+                }
+            }
+        }
+    }
+
+    return move;
+}
+
+/*
+ * Searches a range of tiles of a world row for a tile with collision, one
+ * chunk at a time in the direction of the search.
+ */
+static bool
+find_collision_in_row (const CollisionWindow *window, int row, int first,
+                       int last, bool is_forward, int *column)
+{
+    EngChunk *curr_chunk = NULL;
+    int chunk_x = 0;
+    int chunk_y = floor_divide (row, TILESY);
+    int tile_y = row - chunk_y * TILESY;
+    int start = 0;
+    int range_first = 0;
+    int range_last = 0;
+
+    while (first <= last) {
+        chunk_x = floor_divide (is_forward ? first : last, TILESX);
+        start = chunk_x * TILESX;
+        range_first = first > start ? first : start;
+        range_last = last < start + TILESX - 1 ? last : start + TILESX - 1;
+        curr_chunk = get_window_chunk (window, chunk_x, chunk_y);
+
+        /* Chunks outside of the chunk window cannot be walked on. */
+        if (curr_chunk == NULL) {
+            *column = is_forward ? range_first : range_last;
+            return true;
+        }
+
+        if (find_bit_in_range (curr_chunk->tile_collision[tile_y],
+                               range_first - start, range_last - start,
+                               is_forward, column)) {
+            *column += start;
+            return true;
+        }
+
+        if (is_forward)
+            first = range_last + 1;
+        else
+            last = range_first - 1;
+    }
+
+    return false;
+}
+
+/*
+ * Searches a range of bits of a collision row for a set bit. The words at the
+ * ends of the range are masked, so a whole word is tested at once.
+ */
+static bool
+find_bit_in_range (const uint64_t bits[], int first, int last,
+                   bool is_forward, int *column)
+{
+    int first_word = first / 64;
+    int last_word = last / 64;
+    int word = 0;
+    uint64_t word_bits = 0;
+
+    for (int i = 0; i <= last_word - first_word; i++) {
+        word = is_forward ? first_word + i : last_word - i;
+        word_bits = bits[word];
+
+        if (word == first_word)
+            word_bits &= ~(uint64_t) 0 << (first % 64);
+
+        if (word == last_word)
+            word_bits &= ~(uint64_t) 0 >> (63 - last % 64);
+
+        if (word_bits != 0) {
+            if (is_forward)
+                *column = word * 64 + __builtin_ctzll (word_bits);
+            else
+                *column = word * 64 + 63 - __builtin_clzll (word_bits);
+
+            return true;
+        }
     }
 
-    return index;
+    return false;
 }
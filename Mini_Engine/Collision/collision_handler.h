@@ -5,6 +5,8 @@
 
 /**
  * @brief Returns a collision data for a character in the form of booleans.
+ *        A direction has collision when the character cannot move by its
+ *        full speed in it.
  *
  * @param chunk:     Array of chunks containing a collision map.
  * @param character: Character to test collision for.
@@ -16,4 +18,58 @@
 EngCollision eng_get_char_collision (EngChunk chunk[], EngCharacter character,
                                      EngEvent event);
 
+/**
+ * @brief Returns collision data for many characters at once, each moving by
+ *        its own amount. A direction has collision when the character cannot
+ *        move by the full amount in it. Cheaper than calling
+ *        eng_get_char_collision () for every character.
+ *
+ * @param chunk:         Array of chunks containing a collision map.
+ * @param character:     Characters to test collision for.
+ * @param move:          Movement wanted for each character, in pixels.
+ * @param collision:     Array receiving the collision of each character.
+ * @param nb_characters: Number of characters.
+ *
+ * @sa eng_get_swept_movements ()
+ */
+void eng_get_chars_collision (EngChunk chunk[], const EngCharacter character[],
+                              const EngPoint2d move[], EngCollision collision[],
+                              int nb_characters);
+
+/**
+ * @brief Moves a hit box along x, then along y, and returns how far it can go
+ *        on each axis before touching a tile with collision or an object
+ *        footprint. Every tile crossed is tested, whatever the speed or the
+ *        size of the hit box. Tiles outside of the chunk window have
+ *        collision.
+ *
+ * @param chunk:  Array of chunks containing a collision map.
+ * @param hitbox: Hit box to move, it covers the pixels from hitbox.x to
+ *                hitbox.x + hitbox.w and from hitbox.y to hitbox.y + hitbox.h.
+ * @param move_x: Movement wanted in x, in pixels.
+ * @param move_y: Movement wanted in y, in pixels.
+ *
+ * @return The movement allowed on each axis, between 0 and the movement
+ *         wanted.
+ *
+ * @sa eng_get_char_collision ()
+ */
+EngPoint2d eng_get_swept_movement (EngChunk chunk[], SDL_Rect hitbox,
+                                   int move_x, int move_y);
+
+/**
+ * @brief Moves many hit boxes at once, each by its own amount, and returns how
+ *        far each can go on each axis (see eng_get_swept_movement ()). The
+ *        chunk window is searched once for the whole array.
+ *
+ * @param chunk:       Array of chunks containing a collision map.
+ * @param hitbox:      Hit boxes to move.
+ * @param move:        Movement wanted for each hit box, in pixels.
+ * @param movement:    Array receiving the movement allowed for each hit box.
+ * @param nb_hitboxes: Number of hit boxes.
+ */
+void eng_get_swept_movements (EngChunk chunk[], const SDL_Rect hitbox[],
+                              const EngPoint2d move[], EngPoint2d movement[],
+                              int nb_hitboxes);
+
 #endif /* COLLISION_HANDLER_H_INCLUDED */
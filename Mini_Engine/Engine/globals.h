@@ -1,23 +1,60 @@
 #ifndef GLOBALS_H_INCLUDED
 #define GLOBALS_H_INCLUDED
 
+#define CHUNKSX 2      /**< The number of chunks loaded horizontally.  */
+#define CHUNKSY 2      /**< The number of chunks loaded vertically.    */
 /**
- * Number of chunks to be loaded at the same time.
- * DO NOT CHANGE. The number of chunks cannot be
- * anything other than 4 for now.
+ * Number of chunks to be loaded at the same time. The chunks form a window of
+ * CHUNKSX by CHUNKSY chunks around the main character, stored in a ring
+ * buffer indexed by world chunk coordinates (see eng_chunk_get_index ()), so
+ * a chunk keeps its slot for as long as it stays in the window.
  */
-#define NBCHUNKS 4
+#define NBCHUNKS (CHUNKSX * CHUNKSY)
 #define TILESIZE 64    /**< The size of a tile in pixels (x and y).    */
 #define TILESX 64      /**< The number of horizontal tiles in a chunk. */
 #define TILESY 64      /**< The number of vertical tiles in a chunk.   */
 /*
- * Change TILESIZE, TILESX AND TILESY to your needs, as long as TILESX
- * and TILESY are larger than zero and TILESIZE larger than 10.
+ * Change CHUNKSX, CHUNKSY, TILESIZE, TILESX AND TILESY to your needs, as long
+ * as CHUNKSX and CHUNKSY are larger than one, TILESX and TILESY are larger
+ * than zero and TILESIZE larger than 10.
  */
 
+#define ENG_TILE_LAYOUT_ROW 0    /**< Tiles are stored row by row.        */
+#define ENG_TILE_LAYOUT_MORTON 1 /**< Tiles are stored along a Z curve.    */
+/**
+ * Order of the tiles of a chunk in memory. The Morton layout keeps the tiles
+ * around a tile close in memory, it requires TILESX and TILESY to be the same
+ * power of two.
+ */
+#define ENG_TILE_LAYOUT ENG_TILE_LAYOUT_ROW
+
+#if ENG_TILE_LAYOUT == ENG_TILE_LAYOUT_MORTON && \
+    (TILESX != TILESY || (TILESX & (TILESX - 1)) != 0)
+#error "ENG_TILE_LAYOUT_MORTON needs TILESX == TILESY, a power of two."
+#endif
+
 
 #include <SDL.h>
 #include <stdbool.h>
+#include <stdint.h>
+
+/** Number of 64 bit words holding the collision of one row of tiles. */
+#define ENG_COLLISION_WORDS ((TILESX + 63) / 64)
+
+/**
+ * Largest clearance stored for a tile, in tiles. Tiles farther than this from
+ * every tile with collision are given this clearance.
+ */
+#define ENG_CLEARANCE_MAX 15
+
+/** Size in pixels of the cells of the object grid of a chunk (x and y). */
+#define ENG_OBJECT_CELL_SIZE (4 * TILESIZE)
+/** Number of horizontal cells of the object grid of a chunk. */
+#define ENG_OBJECT_CELLSX \
+        ((TILESX * TILESIZE + ENG_OBJECT_CELL_SIZE - 1) / ENG_OBJECT_CELL_SIZE)
+/** Number of vertical cells of the object grid of a chunk. */
+#define ENG_OBJECT_CELLSY \
+        ((TILESY * TILESIZE + ENG_OBJECT_CELL_SIZE - 1) / ENG_OBJECT_CELL_SIZE)
 
 /** Enumeration of directions a character or object can be facing. */
 enum EngDirectionType {ENG_DOWN, ENG_UP, ENG_RIGHT, ENG_LEFT};
@@ -26,6 +63,10 @@ enum EngDirectionType {ENG_DOWN, ENG_UP, ENG_RIGHT, ENG_LEFT};
 enum EngRenderMode {ENG_RENDER_BACKGROUND, ENG_RENDER_HYBRID,
                     ENG_RENDER_FOREGROUND};
 
+/** Enumeration of flags describing the properties of a tile id. */
+enum EngTileFlag {ENG_TILE_SOLID = 1, ENG_TILE_ANIMATED = 2,
+                  ENG_TILE_WATER = 4};
+
 /*---------------------------------------------------------------------------*/
 /* Global types                                                              */
 /*---------------------------------------------------------------------------*/
@@ -79,12 +120,17 @@ typedef struct _EngPoint2d {
 } EngPoint2d;
 /**< Base structure containing two variables. */
 
-typedef struct _EngTile {
-    int id;
-    int frame;
-    bool has_collision;
-} EngTile;
-/**< Structure containing tile information (used in chunks). */
+typedef struct _EngTileProperties {
+    unsigned int flags;
+    int movement_cost;
+    int nb_frames;
+    int frame_duration;
+} EngTileProperties;
+/**<
+ * Structure containing the properties shared by every tile of an id. Animated
+ * ids show nb_frames consecutive ids of the tile sheet, each for
+ * frame_duration milliseconds.
+ */
 
 typedef struct _EngObject {
     int id;
@@ -101,6 +147,18 @@ typedef struct _EngObject {
 } EngObject;
 /**< Structure containing object information (used in chunks). */
 
+typedef struct _EngObjectGrid {
+    SDL_Rect bounds;
+    int cell_start[ENG_OBJECT_CELLSX * ENG_OBJECT_CELLSY + 1];
+    SDL_Rect *footprint;
+} EngObjectGrid;
+/**<
+ * Structure containing the footprints of the objects of a chunk sorted in a
+ * uniform grid, in pixels of the chunk. The footprints overlapping cell i
+ * (row by row) are footprint[cell_start[i]] to footprint[cell_start[i + 1] -
+ * 1]. Bounds contains every footprint, even those going past the chunk.
+ */
+
 typedef struct _EngChunk {
     int old_chunk_x;
     int old_chunk_y;
@@ -108,13 +166,35 @@ typedef struct _EngChunk {
     int chunk_y;
     int nb_objects;
     bool updated;
-
-    EngTile tile[TILESX][TILESY];
+    bool is_placeholder;
+
+    int tile_bits;
+    int nb_palette_ids;
+    int16_t *tile_palette;
+    uint8_t *tile_data;
+    uint64_t tile_collision[TILESY][ENG_COLLISION_WORDS];
+    uint8_t *tile_clearance;
+    SDL_Rect clearance_dirty;
+    unsigned int clearance_version;
     EngObject *object;
+    EngObjectGrid *object_grid;
+    bool object_grid_dirty;
 } EngChunk;
 /**<
  * Structure containing chunk information, such as
- * tiles and objects.
+ * tiles and objects. Tiles are stored row by row as separate arrays, so each
+ * use of the tiles only touches the data it needs: ids and a collision bit per
+ * tile. Tiles hold no animation state, their frame comes from their id and the
+ * animation clock. Tile ids are stored as 4 or 8 bit indices in a palette of
+ * the ids used by the chunk, or directly as 16 bit ids when the chunk uses more
+ * than 256 ids (tile_bits). A chunk without tile data has only tiles of id 0.
+ * Tiles must be accessed through the tile accessors (see tile.h). The
+ * clearance of the tiles (see clearance.h) is allocated the first time it is
+ * needed, row by row, and computed again around the tiles whose collision
+ * changed (clearance_dirty). Objects with a footprint are
+ * found through the object grid, built when the chunk is loaded (NULL if no
+ * object has a footprint) and built again when the objects changed
+ * (object_grid_dirty).
  */
 
 #endif /* GLOBALS_H_INCLUDED */
@@ -10,6 +10,23 @@
 #include <string.h>
 #include "file_utilities.h"
 
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+/*
+ * Statistics of the file operations made through the file utilities. Each
+ * thread counts its own operations, so the chunk streamer never races with
+ * the main thread on them.
+ */
+static thread_local EngFileStats file_stats = {0, 0, 0, 0, 0};
+
 /*
  * Tries to find a word in a file and if successful, returns the position of
  * the cursor after the word.
@@ -21,7 +38,7 @@ eng_file_get_index_after_string (const char *file_name, const char *word)
     int index = 0;
     int word_length = strlen (word);
 
-    FILE *file = fopen (file_name, "r");
+    FILE *file = eng_file_open (file_name, "r");
 
     if (file != NULL) {
         /*
@@ -72,7 +89,7 @@ eng_file_replace_with_string (const char *file_name, const char *text,
     char c = '!';
 
     /* Open files. */
-    FILE *file = fopen (file_name, "r");
+    FILE *file = eng_file_open (file_name, "r");
     FILE *temp_file = fopen (temp_file_name, "w");
 
     /* Cut and replace the file characters. */
@@ -110,6 +127,235 @@ eng_file_replace_with_string (const char *file_name, const char *text,
     return result;
 }
 
+/* Opens a file and counts the attempt in the file statistics. */
+FILE *
+eng_file_open (const char *file_name, const char *mode)
+{
+    file_stats.nb_opens++;
+
+    return fopen (file_name, mode);
+}
+
+/*
+ * Reads the whole content of a file with a single read. The size of the file
+ * is found by seeking its end, then the content is read in one call.
+ */
+char *
+eng_file_read_file (const char *file_name, long *size)
+{
+    char *buffer = NULL;
+    FILE *file = eng_file_open (file_name, "rb");
+
+    *size = 0;
+
+    if (file != NULL) {
+        fseek (file, 0, SEEK_END);
+        *size = ftell (file);
+        rewind (file);
+
+        /* One more byte is allocated for the null character. */
+        if (*size >= 0)
+            buffer = (char*) malloc (*size + 1);
+
+        if (buffer != NULL) {
+            file_stats.nb_reads++;
+
+            if (fread (buffer, 1, *size, file) == (size_t) *size) {
+                file_stats.nb_bytes_read += *size;
+                buffer[*size] = '\0';
+            }
+            else {
+                free (buffer);
+                buffer = NULL;
+            }
+        }
+
+        file = eng_file_close_file (file);
+    }
+
+    return buffer;
+}
+
+/*
+ * Reads a block of bytes at a position of an open file with a single read,
+ * used to load one entry of a file that contains many.
+ */
+bool
+eng_file_read_at (FILE *file, long offset, void *buffer, long size)
+{
+    bool result = false;
+
+    if (file != NULL && offset >= 0 && size >= 0 &&
+        fseek (file, offset, SEEK_SET) == 0) {
+        file_stats.nb_reads++;
+        result = fread (buffer, 1, size, file) == (size_t) size;
+
+        if (result)
+            file_stats.nb_bytes_read += size;
+    }
+
+    return result;
+}
+
+/*
+ * Replaces the content of a file with a single write. The content goes to a
+ * temporary file next to the file, is flushed to the disk, then the temporary
+ * file is renamed over the file, which the system does atomically.
+ */
+bool
+eng_file_write_file (const char *file_name, const char *buffer, long size)
+{
+    bool result = false;
+    int length = strlen (file_name);
+    char *temp_file_name = (char*) malloc (length + 5);
+    FILE *file = NULL;
+
+    if (temp_file_name == NULL)
+        return false;
+
+    snprintf (temp_file_name, length + 5, "%s.tmp", file_name);
+    file = fopen (temp_file_name, "wb");
+
+    if (file != NULL) {
+        file_stats.nb_writes++;
+        result = fwrite (buffer, 1, size, file) == (size_t) size &&
+                 fflush (file) == 0;
+
+#ifdef _WIN32
+        result = result && _commit (_fileno (file)) == 0;
+#else
+        result = result && fsync (fileno (file)) == 0;
+#endif
+
+        file = eng_file_close_file (file);
+
+#ifdef _WIN32
+        result = result &&
+                 MoveFileExA (temp_file_name, file_name,
+                              MOVEFILE_REPLACE_EXISTING |
+                              MOVEFILE_WRITE_THROUGH);
+#else
+        result = result && rename (temp_file_name, file_name) == 0;
+#endif
+
+        if (!result)
+            remove (temp_file_name);
+    }
+
+    free (temp_file_name);
+
+    return result;
+}
+
+/*
+ * Maps a whole file in memory for reading. Empty files cannot be mapped by
+ * every platform, so they are reported as a failure.
+ */
+bool
+eng_file_map_file (const char *file_name, EngFileMapping *mapping)
+{
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE map = NULL;
+    LARGE_INTEGER size;
+#else
+    int file = -1;
+    struct stat info;
+#endif
+    void *data = NULL;
+
+    mapping->data = NULL;
+    mapping->size = 0;
+    mapping->handle = NULL;
+    file_stats.nb_opens++;
+
+#ifdef _WIN32
+    file = CreateFileA (file_name, GENERIC_READ, FILE_SHARE_READ, NULL,
+                        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+
+    if (file != INVALID_HANDLE_VALUE && GetFileSizeEx (file, &size) &&
+        size.QuadPart > 0) {
+        map = CreateFileMappingA (file, NULL, PAGE_READONLY, 0, 0, NULL);
+
+        if (map != NULL) {
+            data = MapViewOfFile (map, FILE_MAP_READ, 0, 0, 0);
+
+            /* The mapping handle is closed along with the view. */
+            if (data != NULL) {
+                mapping->size = (long) size.QuadPart;
+                mapping->handle = map;
+            }
+            else
+                CloseHandle (map);
+        }
+    }
+
+    if (file != INVALID_HANDLE_VALUE)
+        CloseHandle (file);
+#else
+    file = open (file_name, O_RDONLY);
+
+    if (file >= 0 && fstat (file, &info) == 0 && info.st_size > 0) {
+        data = mmap (NULL, info.st_size, PROT_READ, MAP_SHARED, file, 0);
+
+        if (data == MAP_FAILED)
+            data = NULL;
+        else
+            mapping->size = (long) info.st_size;
+    }
+
+    /* The mapping stays valid once its file descriptor is closed. */
+    if (file >= 0)
+        close (file);
+#endif
+
+    if (data != NULL) {
+        mapping->data = (const char*) data;
+        file_stats.nb_maps++;
+    }
+
+    return data != NULL;
+}
+
+/* Releases a file mapped by eng_file_map_file (). */
+void
+eng_file_unmap_file (EngFileMapping *mapping)
+{
+    if (mapping->data != NULL) {
+#ifdef _WIN32
+        UnmapViewOfFile (mapping->data);
+        CloseHandle ((HANDLE) mapping->handle);
+#else
+        munmap ((void*) mapping->data, mapping->size);
+#endif
+    }
+
+    mapping->data = NULL;
+    mapping->size = 0;
+    mapping->handle = NULL;
+}
+
+/*
+ * Returns the file statistics accumulated by the calling thread since it
+ * started or since its last reset.
+ */
+EngFileStats
+eng_file_get_stats (void)
+{
+    return file_stats;
+}
+
+/* Resets the file statistics of the calling thread to zero. */
+void
+eng_file_reset_stats (void)
+{
+    file_stats.nb_opens = 0;
+    file_stats.nb_reads = 0;
+    file_stats.nb_bytes_read = 0;
+    file_stats.nb_maps = 0;
+    file_stats.nb_writes = 0;
+}
+
 /*
  * Safely closes a file if it was open.
  * This function can be called back to back safely, which is why it was
@@ -4,6 +4,29 @@
 #include <stdio.h>
 #include <stdbool.h>
 
+typedef struct _EngFileStats {
+    int nb_opens;
+    int nb_reads;
+    long nb_bytes_read;
+    int nb_maps;
+    int nb_writes;
+} EngFileStats;
+/**<
+ * Structure counting the file operations made through the file utilities,
+ * used to measure the cost of loading data from files. Operations are
+ * counted per thread.
+ */
+
+typedef struct _EngFileMapping {
+    const char *data;
+    long size;
+    void *handle;
+} EngFileMapping;
+/**<
+ * Structure containing a read-only view of a whole file mapped in memory. The
+ * handle is used by the platform to release the mapping.
+ */
+
 /**
  * @brief Tries to find a word in a file and returns the position of the cursor
  *        at the end of it.
@@ -31,6 +54,100 @@ int eng_file_get_index_after_string (const char *file_name, const char *word);
 bool eng_file_replace_with_string (const char *file_name, const char *text,
                                    int start_index, int end_index);
 
+/**
+ * @brief Opens a file (same as fopen) and counts the attempt in the file
+ *        statistics.
+ *
+ * @param file_name: A string containing the location of the file.
+ * @param mode:      Mode in which the file is opened (same as fopen).
+ *
+ * @return The opened file or NULL if it could not be opened.
+ *
+ * @sa eng_file_get_stats ()
+ */
+FILE * eng_file_open (const char *file_name, const char *mode);
+
+/**
+ * @brief Reads the whole content of a file with a single read.
+ *
+ * @param file_name: A string containing the location of the file.
+ * @param size:      Pointer receiving the size of the content in bytes.
+ *
+ * @return A dynamically allocated buffer containing the content of the file
+ *         followed by a null character (must be freed), or NULL if the file
+ *         could not be read.
+ */
+char * eng_file_read_file (const char *file_name, long *size);
+
+/**
+ * @brief Reads a block of bytes at a position of an open file with a single
+ *        read.
+ *
+ * @param file:   File opened in binary mode.
+ * @param offset: Position of the block from the start of the file.
+ * @param buffer: Buffer receiving the block.
+ * @param size:   Size of the block in bytes.
+ *
+ * @return True if the whole block was read, false otherwise.
+ */
+bool eng_file_read_at (FILE *file, long offset, void *buffer, long size);
+
+/**
+ * @brief Replaces the content of a file with a single write. The content is
+ *        written to a temporary file which then replaces the file, so a crash
+ *        leaves either the old or the new content, never a part of it.
+ *
+ * @param file_name: A string containing the location of the file.
+ * @param buffer:    The new content of the file.
+ * @param size:      Size of the content in bytes.
+ *
+ * @return True if the file was replaced, false otherwise (the file is then
+ *         left untouched).
+ */
+bool eng_file_write_file (const char *file_name, const char *buffer,
+                          long size);
+
+/**
+ * @brief Maps a whole file in memory for reading, without copying it. The
+ *        pages are loaded by the operating system when they are accessed and
+ *        are shared with its file cache.
+ *
+ * @param file_name: A string containing the location of the file.
+ * @param mapping:   Mapping receiving the view of the file.
+ *
+ * @return True if the file was mapped, false otherwise (the mapping is then
+ *         left empty).
+ *
+ * @sa eng_file_unmap_file ()
+ */
+bool eng_file_map_file (const char *file_name, EngFileMapping *mapping);
+
+/**
+ * @brief Releases a file mapped by eng_file_map_file (). Can be called on an
+ *        empty mapping.
+ *
+ * @param mapping: Mapping to release, left empty.
+ */
+void eng_file_unmap_file (EngFileMapping *mapping);
+
+/**
+ * @brief Returns the file statistics accumulated by the calling thread since
+ *        it started or since its last reset.
+ *
+ * @return A structure containing the number of opens, reads, bytes read,
+ *         mappings and writes.
+ *
+ * @sa eng_file_reset_stats ()
+ */
+EngFileStats eng_file_get_stats (void);
+
+/**
+ * @brief Resets the file statistics of the calling thread to zero.
+ *
+ * @sa eng_file_get_stats ()
+ */
+void eng_file_reset_stats (void);
+
 /**
  * @brief Safely closes a file if it was open.
  *
@@ -8,6 +8,7 @@
 /*===========================================================================*/
 
 #include "render.h"
+#include "../Chunks/tile.h"
 
 typedef struct _RenderObject {
     int y;
@@ -79,6 +80,7 @@ eng_render_tiles (SDL_Renderer *renderer, EngChunk chunk[],
                   int nb_textures)
 {
     int tile_texture_index = 0;
+    int tile_id = 0;
     int nb_horizontal_tiles = 0;
     int nb_vertical_tiles = 0;
 
@@ -95,17 +97,17 @@ eng_render_tiles (SDL_Renderer *renderer, EngChunk chunk[],
     for (int h = 0; h < NBCHUNKS; h++) {
         for (int i = 0; i < TILESY; i++) {
             for (int j = 0; j < TILESX; j++) {
-                src.x = (chunk[h].tile[j][i].id % nb_horizontal_tiles) *
-                        TILESIZE;
-                src.y = (chunk[h].tile[j][i].id / nb_vertical_tiles) *
-                        TILESIZE;
+                tile_id = eng_tile_get_frame_id (eng_tile_get_id (&chunk[h],
+                                                                  j, i));
+                src.x = (tile_id % nb_horizontal_tiles) * TILESIZE;
+                src.y = (tile_id / nb_vertical_tiles) * TILESIZE;
 
                 dst.x = j * TILESIZE + chunk[h].chunk_x*TILESX*TILESIZE +
                         player.dst.x + player.center_x - player.x;
                 dst.y = i * TILESIZE + chunk[h].chunk_y*TILESY*TILESIZE +
                         player.dst.y + player.center_y - player.y;
 
-                tile_texture_index = chunk[h].tile[j][i].id /
+                tile_texture_index = tile_id /
                                      (nb_horizontal_tiles * nb_vertical_tiles);
 
                 /*
@@ -6,7 +6,8 @@
 
 /**
  * @brief Pastes to the renderer all the tiles and objects from the array
- *        of chunk data.
+ *        of chunk data. Animated tiles are drawn at the frame given by the
+ *        animation clock (see eng_tile_set_animation_clock ()).
  *
  * @param renderer:     Target renderer.
  * @param chunk:        Array of chunk containing tiles and objects to display.
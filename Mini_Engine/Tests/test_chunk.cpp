@@ -2,10 +2,12 @@
 #include <string.h>
 #include <stdio.h>
 #include "../Chunks/chunk.h"
+#include "../Chunks/tile.h"
 #include "test_chunk.h"
 
 static void test_chunk_init (void);
 static void test_chunk_rotate_chunk (void);
+static void test_chunk_rotate_chunk_resident (void);
 static void test_chunk_get_file_name (void);
 
 void
@@ -14,6 +16,7 @@ test_chunk (void)
     printf("\n> Unit testing chunk functions...\n\n");
     test_chunk_init();
     test_chunk_rotate_chunk();
+    test_chunk_rotate_chunk_resident();
     test_chunk_get_file_name();
 }
 
@@ -25,10 +28,10 @@ test_chunk_init (void)
     for (int i = 0; i < NBCHUNKS; i++)
         chunk[i] =  eng_chunk_create_chunk ();
 
-    /* Testing chunkInit (simple assignment). */
+    /* Testing chunkInit (assignment to the slot of the chunk). */
     eng_chunk_set_main_chunk (chunk, -5, 5);
-    assert (chunk[0].chunk_x == -5);
-    assert (chunk[0].chunk_y == 5);
+    assert (eng_chunk_get_chunk (chunk, -5, 5) != NULL);
+    assert (eng_chunk_get_chunk (chunk, -5, 5)->chunk_y == 5);
 
     for (int i = 0; i < NBCHUNKS; i++)
         eng_chunk_destroy (&chunk[i]);
@@ -38,69 +41,95 @@ static void
 test_chunk_rotate_chunk (void)
 {
     EngChunk chunk[NBCHUNKS];
+    int origin_x = 0;
+    int origin_y = 0;
+
     for (int i = 0; i < NBCHUNKS; i++)
         chunk[i] = eng_chunk_create_chunk ();
 
     /*
-     * Testing chunkRotateChunks (4 scenarios).
-     * Case: (3, 2) on chunk 0, 0
-     *       (1, 0)
+     * Testing chunkRotateChunks (4 scenarios), with a window of 2 by 2.
+     * Case: top-left half of chunk 0, 0.
      */
     eng_chunk_rotate_chunks (chunk, 0, 0, 0, 0);
-    assert (chunk[0].chunk_x == 0);
-    assert (chunk[0].chunk_y == 0);
-    assert (chunk[1].chunk_x == -1);
-    assert (chunk[1].chunk_y == 0);
-    assert (chunk[2].chunk_x == 0);
-    assert (chunk[2].chunk_y == -1);
-    assert (chunk[3].chunk_x == -1);
-    assert (chunk[3].chunk_y == -1);
+    assert (eng_chunk_get_chunk (chunk, 0, 0) != NULL);
+    assert (eng_chunk_get_chunk (chunk, -1, 0) != NULL);
+    assert (eng_chunk_get_chunk (chunk, 0, -1) != NULL);
+    assert (eng_chunk_get_chunk (chunk, -1, -1) != NULL);
+    assert (eng_chunk_get_chunk (chunk, 1, 0) == NULL);
+    eng_chunk_get_window_origin (chunk, &origin_x, &origin_y);
+    assert (origin_x == -1);
+    assert (origin_y == -1);
 
-    /*
-     * Case: (2, 3) in close negatives
-     *       (0, 1)
-     */
+    /* Case: top-right half of chunk -1, 0, in close negatives. */
     eng_chunk_rotate_chunks (chunk, -1, 0, -1, 0);
-    assert (chunk[0].chunk_x == -1);
-    assert (chunk[0].chunk_y == 0);
-    assert (chunk[1].chunk_x == 0);
-    assert (chunk[1].chunk_y == 0);
-    assert (chunk[2].chunk_x == -1);
-    assert (chunk[2].chunk_y == -1);
-    assert (chunk[3].chunk_x == 0);
-    assert (chunk[3].chunk_y == -1);
+    assert (eng_chunk_get_chunk (chunk, -1, 0) != NULL);
+    assert (eng_chunk_get_chunk (chunk, 0, 0) != NULL);
+    assert (eng_chunk_get_chunk (chunk, -1, -1) != NULL);
+    assert (eng_chunk_get_chunk (chunk, 0, -1) != NULL);
 
-    /*
-     * Case: (0, 1) in far negatives
-     *       (2, 3)
-     */
+    /* Case: bottom-right half of chunk -10, -10, in far negatives. */
     eng_chunk_rotate_chunks (chunk, -1 -10 * TILESIZE * TILESX,
                              -1 -10 * TILESIZE * TILESY, -10, -10);
-    assert (chunk[0].chunk_x == -10);
-    assert (chunk[0].chunk_y == -10);
-    assert (chunk[1].chunk_x == -9);
-    assert (chunk[1].chunk_y == -10);
-    assert (chunk[2].chunk_x == -10);
-    assert (chunk[2].chunk_y == -9);
-    assert (chunk[3].chunk_x == -9);
-    assert (chunk[3].chunk_y == -9);
-
-    /*
-     * Case: (1, 0) in far positives
-     *       (3, 2)
-     */
+    assert (eng_chunk_get_chunk (chunk, -10, -10) != NULL);
+    assert (eng_chunk_get_chunk (chunk, -9, -10) != NULL);
+    assert (eng_chunk_get_chunk (chunk, -10, -9) != NULL);
+    assert (eng_chunk_get_chunk (chunk, -9, -9) != NULL);
+    eng_chunk_get_window_origin (chunk, &origin_x, &origin_y);
+    assert (origin_x == -10);
+    assert (origin_y == -10);
 
+    /* Case: bottom-left half of chunk 4, 5, in far positives. */
     eng_chunk_rotate_chunks (chunk, 4 * TILESIZE * TILESX + 1,
                              TILESIZE * TILESY / 2 + 5 * TILESIZE * TILESY,
                              4, 5);
-    assert (chunk[0].chunk_x == 4);
-    assert (chunk[0].chunk_y == 5);
-    assert (chunk[1].chunk_x == 3);
-    assert (chunk[1].chunk_y == 5);
-    assert (chunk[2].chunk_x == 4);
-    assert (chunk[2].chunk_y == 6);
-    assert (chunk[3].chunk_x == 3);
-    assert (chunk[3].chunk_y == 6);
+    assert (eng_chunk_get_chunk (chunk, 4, 5) != NULL);
+    assert (eng_chunk_get_chunk (chunk, 3, 5) != NULL);
+    assert (eng_chunk_get_chunk (chunk, 4, 6) != NULL);
+    assert (eng_chunk_get_chunk (chunk, 3, 6) != NULL);
+
+    /* Every chunk of a window has its own slot. */
+    for (int i = 0; i < NBCHUNKS; i++) {
+        assert (eng_chunk_get_index (chunk[i].chunk_x, chunk[i].chunk_y) ==
+                i);
+    }
+
+    for (int i = 0; i < NBCHUNKS; i++)
+        eng_chunk_destroy (&chunk[i]);
+}
+
+static void
+test_chunk_rotate_chunk_resident (void)
+{
+    EngChunk chunk[NBCHUNKS];
+    for (int i = 0; i < NBCHUNKS; i++)
+        chunk[i] = eng_chunk_create_chunk ();
+
+    /* Mark every chunk in memory with its slot. */
+    eng_chunk_rotate_chunks (chunk, 0, 0, 0, 0);
+
+    for (int i = 0; i < NBCHUNKS; i++)
+        eng_tile_set_id (&chunk[i], 0, 0, 100 + i);
+
+    /* Moving to chunk -1, 0 keeps the same four chunks in the same slots. */
+    assert (!eng_chunk_rotate_chunks (chunk, -1, 0, -1, 0));
+
+    for (int i = 0; i < NBCHUNKS; i++)
+        assert (eng_tile_get_id (&chunk[i], 0, 0) == 100 + i);
+
+    /*
+     * Moving to the right half of chunk -2, 0 keeps chunks -1, 0 and -1, -1
+     * in memory, only the column of the two other chunks is loaded.
+     */
+    assert (eng_chunk_rotate_chunks (chunk, -TILESIZE * TILESX - 1, 0,
+                                     -2, 0));
+    assert (eng_tile_get_id (eng_chunk_get_chunk (chunk, -1, 0), 0, 0) ==
+            100 + eng_chunk_get_index (-1, 0));
+    assert (eng_tile_get_id (eng_chunk_get_chunk (chunk, -1, -1), 0, 0) ==
+            100 + eng_chunk_get_index (-1, -1));
+    assert (eng_tile_get_id (eng_chunk_get_chunk (chunk, -2, 0), 0, 0) < 100);
+    assert (eng_tile_get_id (eng_chunk_get_chunk (chunk, -2, -1), 0, 0) <
+            100);
 
     for (int i = 0; i < NBCHUNKS; i++)
         eng_chunk_destroy (&chunk[i]);
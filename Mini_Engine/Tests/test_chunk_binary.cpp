@@ -0,0 +1,131 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "../Engine/globals.h"
+#include "../Chunks/chunk.h"
+#include "../Chunks/chunk_binary.h"
+#include "../Chunks/tile.h"
+#include "test_chunk_binary.h"
+
+static void test_chunk_binary_convert (void);
+static void test_chunk_binary_load (void);
+static void test_chunk_binary_compression (void);
+
+void
+test_chunk_binary (void)
+{
+    printf("\n> Unit testing binary chunk functions...\n\n");
+    test_chunk_binary_convert ();
+    test_chunk_binary_load ();
+    test_chunk_binary_compression ();
+}
+
+static void
+test_chunk_binary_convert (void)
+{
+    /* Regular test. */
+    assert (eng_chunk_binary_convert (-2000, -2000));
+
+    /* Test with a non-existent text file. */
+    assert (!eng_chunk_binary_convert (-2000000, -2000000));
+
+    eng_chunk_binary_remove (-2000, -2000);
+}
+
+static void
+test_chunk_binary_load (void)
+{
+    EngChunk chunk = eng_chunk_create_chunk ();
+    chunk.chunk_x = -2000;
+    chunk.chunk_y = -2000;
+
+    /* Test without a binary file. */
+    assert (!eng_chunk_binary_load (&chunk));
+
+    /* All tiles in this file are of id 14 and there are two objects. */
+    eng_chunk_binary_convert (-2000, -2000);
+    assert (eng_chunk_binary_load (&chunk));
+
+    for (int i = 0; i < TILESX; i++) {
+        for (int j = 0; j < TILESY; j++) {
+            assert (eng_tile_get_id (&chunk, i, j) == 14);
+        }
+    }
+
+    assert (chunk.nb_objects == 2);
+    assert (chunk.object[0].id == 5);
+    assert (chunk.object[0].x == 200);
+    assert (chunk.object[0].y == 10);
+    assert (chunk.object[1].id == -2);
+    assert (chunk.object[1].x == -10024);
+    assert (chunk.object[1].y == 13);
+
+    /* Test that a change in the binary file is what gets loaded. */
+    eng_tile_set_id (&chunk, 3, 5, 7);
+    assert (eng_chunk_binary_save (&chunk));
+    assert (eng_chunk_load_chunk (&chunk, true));
+    assert (eng_tile_get_id (&chunk, 3, 5) == 7);
+
+    /* Once removed, the text file is loaded again. */
+    eng_chunk_binary_remove (-2000, -2000);
+    assert (!eng_chunk_binary_load (&chunk));
+    assert (eng_chunk_load_chunk (&chunk, true));
+    assert (eng_tile_get_id (&chunk, 3, 5) == 14);
+
+    eng_chunk_destroy (&chunk);
+}
+
+static void
+test_chunk_binary_compression (void)
+{
+    EngChunk chunk = eng_chunk_create_chunk ();
+    EngChunk decoded = eng_chunk_create_chunk ();
+    long raw_size = 0;
+    long size = 0;
+    char *buffer = NULL;
+
+    /* A chunk of a single id is compressed to a single run. */
+    for (int i = 0; i < TILESX; i++) {
+        for (int j = 0; j < TILESY; j++)
+            eng_tile_set_id (&chunk, i, j, 14);
+    }
+
+    eng_tile_set_id (&chunk, TILESX - 1, TILESY - 1, 3);
+    free (eng_chunk_binary_encode (&chunk, ENG_COMPRESSION_NONE, &raw_size));
+    buffer = eng_chunk_binary_encode (&chunk, ENG_COMPRESSION_AUTO, &size);
+    assert (size < raw_size / 100);
+    assert (eng_chunk_binary_decode (&decoded, buffer, size));
+    assert (eng_tile_get_id (&decoded, 0, 0) == 14);
+    assert (eng_tile_get_id (&decoded, TILESX - 2, TILESY - 1) == 14);
+    assert (eng_tile_get_id (&decoded, TILESX - 1, TILESY - 1) == 3);
+
+    /* Test with a corrupted run count. */
+    ((int32_t*) (buffer + size - 2 * sizeof(int32_t)))[0] = 2;
+    assert (!eng_chunk_binary_decode (&decoded, buffer, size));
+    free (buffer);
+
+    /* Tiles without repeated ids are stored uncompressed. */
+    for (int i = 0; i < TILESX; i++) {
+        for (int j = 0; j < TILESY; j++)
+            eng_tile_set_id (&chunk, i, j, i + j * TILESX);
+    }
+
+    buffer = eng_chunk_binary_encode (&chunk, ENG_COMPRESSION_AUTO, &size);
+    assert (size == raw_size);
+    free (buffer);
+
+    /* Forced compression still gives back the same tiles. */
+    buffer = eng_chunk_binary_encode (&chunk, ENG_COMPRESSION_RLE, &size);
+    assert (size > raw_size);
+    assert (eng_chunk_binary_decode (&decoded, buffer, size));
+    assert (eng_tile_get_id (&decoded, 5, 7) == 5 + 7 * TILESX);
+
+    /* Test with a number of objects whose size overflows 32 bits. */
+    ((int32_t*) buffer)[4] = 0x40000000;
+    assert (!eng_chunk_binary_decode (&decoded, buffer, size));
+    free (buffer);
+
+    eng_chunk_destroy (&decoded);
+    eng_chunk_destroy (&chunk);
+}
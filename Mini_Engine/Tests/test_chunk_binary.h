@@ -0,0 +1,6 @@
+#ifndef TEST_CHUNK_BINARY_H_INCLUDED
+#define TEST_CHUNK_BINARY_H_INCLUDED
+
+void test_chunk_binary (void);
+
+#endif /* TEST_CHUNK_BINARY_H_INCLUDED */
@@ -0,0 +1,138 @@
+#include <assert.h>
+#include <stdio.h>
+#include "../Engine/globals.h"
+#include "../Chunks/chunk.h"
+#include "../Chunks/chunk_cache.h"
+#include "../Chunks/objects.h"
+#include "../Chunks/tile.h"
+#include "test_chunk_cache.h"
+
+static void test_chunk_cache_store_fetch (void);
+static void test_chunk_cache_budget (void);
+static void test_chunk_cache_rotate_chunks (void);
+
+void
+test_chunk_cache (void)
+{
+    printf("\n> Unit testing chunk cache functions...\n\n");
+    test_chunk_cache_store_fetch ();
+    test_chunk_cache_budget ();
+    test_chunk_cache_rotate_chunks ();
+}
+
+static void
+test_chunk_cache_store_fetch (void)
+{
+    EngChunk chunk = eng_chunk_create_chunk ();
+    EngChunkCacheStats stats;
+
+    eng_chunk_cache_clear ();
+    eng_chunk_cache_reset_stats ();
+
+    chunk.chunk_x = 7;
+    chunk.chunk_y = -3;
+    eng_tile_set_id (&chunk, 2, 4, 9);
+    eng_tile_set_has_collision (&chunk, 2, 4, true);
+    eng_object_allocate (&chunk, 1);
+    chunk.object[0] = eng_object_create_object (5, 10, 20);
+
+    /* The cache takes the objects of a stored chunk. */
+    eng_chunk_cache_store (&chunk);
+    assert (chunk.nb_objects == 0);
+    stats = eng_chunk_cache_get_stats ();
+    assert (stats.nb_chunks == 1);
+    assert (stats.nb_bytes > 0);
+
+    /* Regular test, tiles, collisions and objects come back. */
+    chunk = eng_chunk_create_chunk ();
+    chunk.chunk_x = 7;
+    chunk.chunk_y = -3;
+    assert (eng_chunk_cache_fetch (&chunk));
+    assert (eng_tile_get_id (&chunk, 2, 4) == 9);
+    assert (eng_tile_has_collision (&chunk, 2, 4));
+    assert (chunk.nb_objects == 1);
+    assert (chunk.object[0].x == 10);
+
+    /* A fetched chunk leaves the cache. */
+    assert (!eng_chunk_cache_fetch (&chunk));
+    stats = eng_chunk_cache_get_stats ();
+    assert (stats.nb_hits == 1);
+    assert (stats.nb_misses == 1);
+    assert (stats.nb_chunks == 0);
+    assert (stats.nb_bytes == 0);
+
+    /* Test with an invalidated chunk. */
+    eng_chunk_cache_store (&chunk);
+    eng_chunk_cache_invalidate (7, -3);
+    assert (!eng_chunk_cache_fetch (&chunk));
+
+    eng_chunk_destroy (&chunk);
+}
+
+static void
+test_chunk_cache_budget (void)
+{
+    EngChunk chunk = eng_chunk_create_chunk ();
+    long chunk_size = 0;
+
+    eng_chunk_cache_clear ();
+
+    /* Measure the size of one chunk without objects. */
+    eng_chunk_cache_store (&chunk);
+    chunk_size = eng_chunk_cache_get_stats ().nb_bytes;
+    eng_chunk_cache_clear ();
+
+    /* Only the two most recently used chunks fit in the budget. */
+    eng_chunk_cache_set_budget (2 * chunk_size);
+
+    for (int i = 0; i < 3; i++) {
+        chunk.chunk_x = i;
+        eng_chunk_cache_store (&chunk);
+    }
+
+    assert (eng_chunk_cache_get_stats ().nb_chunks == 2);
+    chunk.chunk_x = 0;
+    assert (!eng_chunk_cache_fetch (&chunk));
+    chunk.chunk_x = 2;
+    assert (eng_chunk_cache_fetch (&chunk));
+
+    /* A budget of 0 disables the cache. */
+    eng_chunk_cache_set_budget (0);
+    assert (eng_chunk_cache_get_stats ().nb_chunks == 0);
+    eng_chunk_cache_store (&chunk);
+    assert (eng_chunk_cache_get_stats ().nb_chunks == 0);
+
+    eng_chunk_cache_set_budget (ENG_CHUNK_CACHE_DEFAULT_BUDGET);
+    eng_chunk_destroy (&chunk);
+}
+
+static void
+test_chunk_cache_rotate_chunks (void)
+{
+    EngChunk chunk[NBCHUNKS];
+    int left_half = -TILESIZE * TILESX / 2 - 1;
+    int right_half = -TILESIZE * TILESX / 2 + 1;
+
+    for (int i = 0; i < NBCHUNKS; i++)
+        chunk[i] = eng_chunk_create_chunk ();
+
+    eng_chunk_cache_clear ();
+    eng_chunk_rotate_chunks (chunk, left_half, 0, -1, 0);
+    eng_chunk_cache_reset_stats ();
+
+    /* Walking back and forth over the half chunk line hits the cache. */
+    for (int i = 0; i < 3; i++) {
+        assert (eng_chunk_rotate_chunks (chunk, right_half, 0, -1, 0));
+        assert (eng_chunk_get_chunk (chunk, 0, 0) != NULL);
+        assert (eng_chunk_rotate_chunks (chunk, left_half, 0, -1, 0));
+        assert (eng_chunk_get_chunk (chunk, -2, 0) != NULL);
+    }
+
+    assert (eng_chunk_cache_get_stats ().nb_hits == 10);
+    assert (eng_chunk_cache_get_stats ().nb_misses == 2);
+
+    for (int i = 0; i < NBCHUNKS; i++)
+        eng_chunk_destroy (&chunk[i]);
+
+    eng_chunk_cache_clear ();
+}
@@ -0,0 +1,6 @@
+#ifndef TEST_CHUNK_CACHE_H_INCLUDED
+#define TEST_CHUNK_CACHE_H_INCLUDED
+
+void test_chunk_cache (void);
+
+#endif /* TEST_CHUNK_CACHE_H_INCLUDED */
@@ -0,0 +1,182 @@
+#include <assert.h>
+#include <stdio.h>
+#include "../Engine/globals.h"
+#include "../Chunks/chunk.h"
+#include "../Chunks/chunk_cache.h"
+#include "../Chunks/chunk_directory.h"
+#include "../Chunks/chunk_writer.h"
+#include "../Chunks/tile.h"
+#include "test_chunk_directory.h"
+
+static void test_chunk_directory_pin (void);
+static void test_chunk_directory_window (void);
+static void test_chunk_directory_many_chunks (void);
+
+void
+test_chunk_directory (void)
+{
+    printf("\n> Unit testing chunk directory functions...\n\n");
+    test_chunk_directory_pin ();
+    test_chunk_directory_window ();
+    test_chunk_directory_many_chunks ();
+}
+
+static void
+test_chunk_directory_pin (void)
+{
+    static const int x = -2000 * TILESX * TILESIZE + 5 * TILESIZE + 3;
+    static const int y = -2000 * TILESY * TILESIZE + 7 * TILESIZE;
+    EngChunk *chunk = NULL;
+    int id = -1;
+    bool has_collision = true;
+
+    eng_chunk_cache_clear ();
+
+    /* Chunks that are not pinned are not loaded. */
+    assert (eng_chunk_directory_find (-2000, -2000) == NULL);
+    assert (!eng_chunk_directory_get_tile (x, y, &id, &has_collision));
+    assert (id == -1 && has_collision);
+
+    /* Pinning reads the chunk, which contains only tiles with the id 14. */
+    chunk = eng_chunk_directory_pin (-2000, -2000);
+    assert (chunk != NULL);
+    assert (eng_chunk_directory_find (-2000, -2000) == chunk);
+    assert (eng_chunk_directory_get_tile (x, y, &id, &has_collision));
+    assert (id == 14 && !has_collision);
+    assert (eng_chunk_directory_get_tile (x, y, NULL, NULL));
+
+    /* The chunk is released with its last pin, and goes to the cache. */
+    assert (eng_chunk_directory_pin (-2000, -2000) == chunk);
+    assert (eng_chunk_directory_get_nb_pinned () == 1);
+    assert (eng_chunk_directory_unpin (-2000, -2000));
+    assert (eng_chunk_directory_find (-2000, -2000) == chunk);
+    assert (eng_chunk_directory_unpin (-2000, -2000));
+    assert (eng_chunk_directory_find (-2000, -2000) == NULL);
+    assert (!eng_chunk_directory_unpin (-2000, -2000));
+    assert (eng_chunk_cache_contains (-2000, -2000));
+
+    /* Edits made to a pinned chunk are found before the pinned copy. */
+    chunk = eng_chunk_directory_pin (-2000, -2000);
+    eng_tile_modify_file_id (-2000, -2000, 5, 7, 9);
+    assert (eng_chunk_directory_find (-2000, -2000) != chunk);
+    assert (eng_chunk_directory_get_tile (x, y, &id, NULL));
+    assert (id == 9);
+
+    /* Releasing the chunk writes the edits instead of caching the copy. */
+    assert (eng_chunk_directory_unpin (-2000, -2000));
+    assert (eng_chunk_writer_find (-2000, -2000) == NULL);
+    assert (!eng_chunk_cache_contains (-2000, -2000));
+
+    eng_tile_modify_file_id (-2000, -2000, 5, 7, 14);
+    assert (eng_chunk_writer_flush () == 1);
+
+    /* Chunks without a file cannot be pinned. */
+    assert (eng_chunk_directory_pin (-3000, -3000) == NULL);
+    assert (eng_chunk_directory_get_nb_pinned () == 0);
+
+    eng_chunk_cache_clear ();
+}
+
+static void
+test_chunk_directory_window (void)
+{
+    EngChunk chunk[NBCHUNKS];
+    EngChunk copy;
+    EngChunk *pinned = NULL;
+    int id = 0;
+
+    for (int i = 0; i < NBCHUNKS; i++) {
+        chunk[i] = eng_chunk_create_chunk ();
+        chunk[i].chunk_x = i % CHUNKSX - 1;
+        chunk[i].chunk_y = i / CHUNKSX;
+    }
+
+    /* Chunks of the window are found without being pinned. */
+    eng_chunk_set_main_chunk (chunk, -1, 0);
+    eng_tile_set_id (eng_chunk_get_chunk (chunk, -1, 0), 1, 2, 33);
+    eng_chunk_directory_set_window (chunk);
+
+    assert (eng_chunk_directory_find (-1, 0) ==
+            eng_chunk_get_chunk (chunk, -1, 0));
+    assert (eng_chunk_directory_get_tile (-(TILESX - 1) * TILESIZE + 3,
+                                          2 * TILESIZE + TILESIZE - 1, &id,
+                                          NULL));
+    assert (id == 33);
+    assert (!eng_chunk_directory_get_tile (-TILESX * TILESIZE - 1, 0, &id,
+                                           NULL));
+
+    /* Placeholders are not loaded yet. */
+    eng_chunk_get_chunk (chunk, -1, 0)->is_placeholder = true;
+    assert (eng_chunk_directory_find (-1, 0) == NULL);
+    eng_chunk_get_chunk (chunk, -1, 0)->is_placeholder = false;
+
+    /* Pinned chunks are copied to the chunks entering the window. */
+    pinned = eng_chunk_directory_pin (-2000, -2000);
+    assert (pinned != NULL);
+    copy = eng_chunk_create_chunk ();
+    copy.chunk_x = -2000;
+    copy.chunk_y = -2000;
+    assert (eng_chunk_directory_fetch (&copy));
+    assert (eng_tile_get_id (&copy, 3, 3) == 14);
+    assert (eng_chunk_directory_find (-2000, -2000) == pinned);
+
+    copy.chunk_x = -2001;
+    assert (!eng_chunk_directory_fetch (&copy));
+
+    eng_chunk_directory_clear ();
+    eng_chunk_directory_set_window (NULL);
+    assert (eng_chunk_directory_find (-1, 0) == NULL);
+    eng_chunk_cache_clear ();
+
+    eng_chunk_destroy (&copy);
+
+    for (int i = 0; i < NBCHUNKS; i++)
+        eng_chunk_destroy (&chunk[i]);
+}
+
+static void
+test_chunk_directory_many_chunks (void)
+{
+    static const int nb_chunks = 100;
+    EngChunk chunk = eng_chunk_create_chunk ();
+    int id = 0;
+
+    /* The chunks come from the cache, so no file is read. */
+    eng_chunk_cache_clear ();
+
+    for (int i = 0; i < nb_chunks; i++) {
+        chunk.chunk_x = 100 + i % 10;
+        chunk.chunk_y = -100 - i / 10;
+        eng_tile_set_id (&chunk, 0, 0, i);
+        eng_chunk_cache_store (&chunk);
+        eng_chunk_destroy (&chunk);
+    }
+
+    for (int i = 0; i < nb_chunks; i++)
+        assert (eng_chunk_directory_pin (100 + i % 10, -100 - i / 10) != NULL);
+
+    assert (eng_chunk_directory_get_nb_pinned () == nb_chunks);
+
+    /* Chunks are still found after others were released. */
+    for (int i = 0; i < nb_chunks; i += 2)
+        assert (eng_chunk_directory_unpin (100 + i % 10, -100 - i / 10));
+
+    for (int i = 0; i < nb_chunks; i++) {
+        if (i % 2 == 0) {
+            assert (eng_chunk_directory_find (100 + i % 10,
+                                              -100 - i / 10) == NULL);
+        }
+        else {
+            assert (eng_chunk_directory_get_tile ((100 + i % 10) * TILESX *
+                                                  TILESIZE,
+                                                  (-100 - i / 10) * TILESY *
+                                                  TILESIZE, &id, NULL));
+            assert (id == i);
+        }
+    }
+
+    eng_chunk_directory_clear ();
+    assert (eng_chunk_directory_get_nb_pinned () == 0);
+    assert (eng_chunk_directory_find (101, -100) == NULL);
+    eng_chunk_cache_clear ();
+}
@@ -0,0 +1,132 @@
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include "../Engine/globals.h"
+#include "../Chunks/chunk.h"
+#include "../Chunks/chunk_parser.h"
+#include "../Chunks/tile.h"
+#include "../Chunks/objects.h"
+#include "../File_Utilities/file_utilities.h"
+#include "test_chunk_parser.h"
+
+static void test_chunk_parse_text_buffer (void);
+static void test_chunk_parse_text_file (void);
+static void test_chunk_get_load_stats (void);
+
+void
+test_chunk_parser (void)
+{
+    printf("\n> Unit testing chunk parser functions...\n\n");
+    test_chunk_parse_text_buffer ();
+    test_chunk_parse_text_file ();
+    test_chunk_get_load_stats ();
+}
+
+static void
+test_chunk_parse_text_buffer (void)
+{
+    EngChunk chunk = eng_chunk_create_chunk ();
+    char buffer[TILESX * TILESY * 3 + 64] = "tile{";
+    int nb_values_parsed = 0;
+
+    /* Regular test, every tile is of id 3 except the last one. */
+    for (int i = 0; i < TILESX * TILESY - 1; i++)
+        strcat (buffer, "3,");
+
+    strcat (buffer, "12}\r\nobjects{1 -5 6,\n2 7 8}");
+
+    assert (eng_chunk_parse_text_buffer (&chunk, buffer, strlen (buffer),
+                                         &nb_values_parsed));
+    assert (nb_values_parsed == TILESX * TILESY + 6);
+    assert (eng_tile_get_id (&chunk, 0, 0) == 3);
+    assert (eng_tile_get_id (&chunk, TILESX - 1, TILESY - 1) == 12);
+    assert (chunk.nb_objects == 2);
+    assert (chunk.object[0].id == 1);
+    assert (chunk.object[0].x == -5);
+    assert (chunk.object[0].y == 6);
+    assert (chunk.object[1].id == 2);
+    assert (chunk.object[1].x == 7);
+    assert (chunk.object[1].y == 8);
+
+    /* Test with missing tiles and no objects. */
+    strcpy (buffer, "tile{1,2}objects{}");
+    assert (!eng_chunk_parse_text_buffer (&chunk, buffer, strlen (buffer),
+                                          &nb_values_parsed));
+    assert (nb_values_parsed == 2);
+    assert (eng_tile_get_id (&chunk, 1, 0) == 2);
+    assert (eng_tile_get_id (&chunk, 2, 0) == -1);
+    assert (chunk.nb_objects == 0);
+
+    /* Test with a tile id too large for an int and a bad object. */
+    strcpy (buffer, "tile{1,99999999999,3}objects{1 2 3,4 - 5,6 7 8}");
+    assert (!eng_chunk_parse_text_buffer (&chunk, buffer, strlen (buffer),
+                                          &nb_values_parsed));
+    assert (eng_tile_get_id (&chunk, 0, 0) == 1);
+    assert (eng_tile_get_id (&chunk, 1, 0) == -1);
+    assert (chunk.nb_objects == 1);
+    assert (chunk.object[0].id == 1);
+    assert (chunk.object[0].y == 3);
+
+    eng_chunk_destroy (&chunk);
+}
+
+static void
+test_chunk_parse_text_file (void)
+{
+    EngChunk chunk = eng_chunk_create_chunk ();
+    chunk.chunk_x = -2000;
+    chunk.chunk_y = -2000;
+
+    /* All tiles in this file are of id 14 and there are two objects. */
+    assert (eng_chunk_parse_text_file (&chunk, NULL));
+
+    for (int i = 0; i < TILESX; i++) {
+        for (int j = 0; j < TILESY; j++) {
+            assert (eng_tile_get_id (&chunk, i, j) == 14);
+        }
+    }
+
+    assert (chunk.nb_objects == 2);
+    assert (chunk.object[1].id == -2);
+    assert (chunk.object[1].x == -10024);
+    assert (chunk.object[1].y == 13);
+
+    /* Test with a non-existent file. */
+    chunk.chunk_x = -2000000;
+    chunk.chunk_y = -2000000;
+    eng_chunk_destroy (&chunk);
+    assert (!eng_chunk_parse_text_file (&chunk, NULL));
+    assert (eng_tile_get_id (&chunk, 0, 0) == 0);
+    assert (chunk.nb_objects == 0);
+}
+
+static void
+test_chunk_get_load_stats (void)
+{
+    EngChunk chunk = eng_chunk_create_chunk ();
+    EngChunkLoadStats stats;
+    EngFileStats file_stats;
+    chunk.chunk_x = -2000;
+    chunk.chunk_y = -2000;
+
+    /* The text file is opened and read once (after the binary file lookup). */
+    assert (eng_chunk_load_chunk (&chunk, true));
+    stats = eng_chunk_get_load_stats ();
+    assert (stats.nb_file_opens == 2);
+    assert (stats.nb_file_reads == 1);
+    assert (stats.nb_bytes_read > 0);
+    assert (stats.nb_values_parsed == TILESX * TILESY + 6);
+
+    /* The previous path opens the same file at least five times. */
+    eng_file_reset_stats ();
+    eng_chunk_destroy (&chunk);
+    eng_tile_load_tiles (&chunk);
+    eng_object_load_objects (&chunk);
+    file_stats = eng_file_get_stats ();
+    assert (file_stats.nb_opens >= 5);
+
+    printf ("Chunk load: %d open(s) and %d read(s) instead of %d open(s)\n",
+            stats.nb_file_opens, stats.nb_file_reads, file_stats.nb_opens);
+
+    eng_chunk_destroy (&chunk);
+}
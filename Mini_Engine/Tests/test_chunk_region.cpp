@@ -0,0 +1,167 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "../Engine/globals.h"
+#include "../Chunks/chunk.h"
+#include "../Chunks/chunk_binary.h"
+#include "../Chunks/chunk_region.h"
+#include "../Chunks/chunk_writer.h"
+#include "../Chunks/tile.h"
+#include "../File_Utilities/file_utilities.h"
+#include "test_chunk_region.h"
+
+static void test_chunk_region_get_region (void);
+static void test_chunk_region_pack_and_load (void);
+static void test_chunk_region_edit (void);
+static void test_chunk_region_remove_loose (void);
+
+void
+test_chunk_region (void)
+{
+    printf("\n> Unit testing chunk region functions...\n\n");
+    test_chunk_region_get_region ();
+    test_chunk_region_pack_and_load ();
+    test_chunk_region_edit ();
+    test_chunk_region_remove_loose ();
+}
+
+static void
+test_chunk_region_get_region (void)
+{
+    assert (eng_chunk_region_get_region (0) == 0);
+    assert (eng_chunk_region_get_region (ENG_REGION_SIZE - 1) == 0);
+    assert (eng_chunk_region_get_region (ENG_REGION_SIZE) == 1);
+    assert (eng_chunk_region_get_region (-1) == -1);
+    assert (eng_chunk_region_get_region (-ENG_REGION_SIZE) == -1);
+    assert (eng_chunk_region_get_region (-ENG_REGION_SIZE - 1) == -2);
+}
+
+static void
+test_chunk_region_pack_and_load (void)
+{
+    EngChunk chunk = eng_chunk_create_chunk ();
+    EngFileStats file_stats;
+    int region = eng_chunk_region_get_region (-2000);
+    const char *file_name = eng_chunk_region_get_file_name (region, region);
+    chunk.chunk_x = -2000;
+    chunk.chunk_y = -2000;
+
+    /* The region of chunk -2000,-2000 contains at least that chunk. */
+    assert (eng_chunk_region_pack (region, region, false) > 0);
+
+    /* The region file is mapped once, then chunks are loaded without reads. */
+    eng_file_reset_stats ();
+    assert (eng_chunk_region_load (&chunk));
+    eng_chunk_destroy (&chunk);
+    assert (eng_chunk_region_load (&chunk));
+    file_stats = eng_file_get_stats ();
+    assert (file_stats.nb_opens == 1);
+    assert (file_stats.nb_maps == 1);
+    assert (file_stats.nb_reads == 0);
+
+    /* All tiles in this chunk are of id 14 and there are two objects. */
+    for (int i = 0; i < TILESX; i++) {
+        for (int j = 0; j < TILESY; j++) {
+            assert (eng_tile_get_id (&chunk, i, j) == 14);
+        }
+    }
+
+    assert (chunk.nb_objects == 2);
+    assert (chunk.object[1].id == -2);
+    assert (chunk.object[1].x == -10024);
+    assert (chunk.object[1].y == 13);
+    eng_chunk_destroy (&chunk);
+
+    /* Test with a chunk absent from the region and with a missing region. */
+    chunk.chunk_x = -2001;
+    assert (!eng_chunk_region_load (&chunk));
+    chunk.chunk_x = -2000000;
+    assert (!eng_chunk_region_load (&chunk));
+    assert (eng_chunk_region_pack (-2000000, -2000000, false) == 0);
+
+    eng_chunk_region_unmap_all ();
+    remove (file_name);
+    free ((char*) file_name);
+}
+
+static void
+test_chunk_region_edit (void)
+{
+    EngChunk chunk = eng_chunk_create_chunk ();
+    int region = eng_chunk_region_get_region (-2000);
+    const char *file_name = eng_chunk_get_file_name (-2000, -2000);
+    const char *region_name = eng_chunk_region_get_file_name (region, region);
+    chunk.chunk_x = -2000;
+    chunk.chunk_y = -2000;
+
+    assert (eng_chunk_region_pack (region, region, false) > 0);
+
+    /* Editing a chunk only found in its region writes a text copy of it. */
+    assert (rename (file_name, "Demo/chunks/region_test.txt") == 0);
+    eng_tile_modify_file_id (-2000, -2000, 0, 0, 7);
+    assert (eng_chunk_writer_flush () == 1);
+    assert (eng_chunk_read_chunk (&chunk, NULL));
+    assert (eng_tile_get_id (&chunk, 0, 0) == 7);
+    assert (eng_tile_get_id (&chunk, 1, 0) == 14);
+    assert (chunk.nb_objects == 2);
+    assert (chunk.object[1].x == -10024);
+    eng_chunk_destroy (&chunk);
+
+    /* The region copy of the chunk is left untouched. */
+    assert (eng_chunk_region_load (&chunk));
+    assert (eng_tile_get_id (&chunk, 0, 0) == 14);
+    eng_chunk_destroy (&chunk);
+
+    remove (file_name);
+    assert (rename ("Demo/chunks/region_test.txt", file_name) == 0);
+    eng_chunk_region_unmap_all ();
+    remove (region_name);
+    free ((char*) file_name);
+    free ((char*) region_name);
+}
+
+static void
+test_chunk_region_remove_loose (void)
+{
+    EngChunk chunk = eng_chunk_create_chunk ();
+    EngFileStats file_stats;
+    long size = 0;
+    int region = eng_chunk_region_get_region (-2000);
+    const char *file_name = eng_chunk_get_file_name (-2000, -2000);
+    const char *region_name = eng_chunk_region_get_file_name (region, region);
+    char *text = eng_file_read_file (file_name, &size);
+    FILE *file = NULL;
+    chunk.chunk_x = -2000;
+    chunk.chunk_y = -2000;
+
+    assert (text != NULL);
+
+    /* The chunk files packed are deleted once the region file is written. */
+    assert (eng_chunk_binary_convert (-2000, -2000));
+    assert (eng_chunk_region_pack (region, region, true) > 0);
+    assert (!eng_chunk_binary_load (&chunk));
+    assert ((file = fopen (file_name, "r")) == NULL);
+
+    /* The chunk is then loaded from the packed map alone. */
+    eng_file_reset_stats ();
+    assert (eng_chunk_read_chunk (&chunk, NULL));
+    file_stats = eng_file_get_stats ();
+    assert (file_stats.nb_maps == 1);
+    assert (file_stats.nb_reads == 0);
+    assert (eng_tile_get_id (&chunk, 5, 5) == 14);
+    assert (chunk.nb_objects == 2);
+    assert (chunk.object[1].x == -10024);
+    eng_chunk_destroy (&chunk);
+
+    /* Restore the text chunk file of the tests. */
+    file = fopen (file_name, "wb");
+    assert (file != NULL);
+    assert (fwrite (text, 1, size, file) == (size_t) size);
+    file = eng_file_close_file (file);
+
+    eng_chunk_region_unmap_all ();
+    remove (region_name);
+    free (text);
+    free ((char*) file_name);
+    free ((char*) region_name);
+}
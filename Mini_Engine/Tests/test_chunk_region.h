@@ -0,0 +1,6 @@
+#ifndef TEST_CHUNK_REGION_H_INCLUDED
+#define TEST_CHUNK_REGION_H_INCLUDED
+
+void test_chunk_region (void);
+
+#endif /* TEST_CHUNK_REGION_H_INCLUDED */
@@ -0,0 +1,144 @@
+#include <assert.h>
+#include <stdio.h>
+#include <SDL.h>
+#include "../Engine/globals.h"
+#include "../Chunks/chunk.h"
+#include "../Chunks/chunk_cache.h"
+#include "../Chunks/chunk_streamer.h"
+#include "../Chunks/tile.h"
+#include "test_chunk_streamer.h"
+
+static void test_chunk_streamer_request (void);
+static void test_chunk_streamer_placeholder (void);
+static void test_chunk_streamer_prefetch (void);
+
+void
+test_chunk_streamer (void)
+{
+    printf("\n> Unit testing chunk streamer functions...\n\n");
+    test_chunk_streamer_request ();
+    test_chunk_streamer_placeholder ();
+    test_chunk_streamer_prefetch ();
+}
+
+static void
+test_chunk_streamer_request (void)
+{
+    EngChunk chunk = eng_chunk_create_chunk ();
+    chunk.chunk_x = -2000;
+    chunk.chunk_y = -2000;
+
+    /* Test with a stopped streamer. */
+    assert (!eng_chunk_streamer_request (-2000, -2000));
+    assert (!eng_chunk_streamer_collect (&chunk));
+
+    assert (eng_chunk_streamer_start ());
+    eng_chunk_streamer_reset_stats ();
+
+    /* A chunk is only requested once. */
+    assert (eng_chunk_streamer_request (-2000, -2000));
+    assert (eng_chunk_streamer_request (-2000, -2000));
+    assert (eng_chunk_streamer_is_requested (-2000, -2000));
+    assert (eng_chunk_streamer_get_stats ().nb_requests == 1);
+
+    /* All tiles in this file are of id 14 and there are two objects. */
+    for (int i = 0; i < 2000 && !eng_chunk_streamer_collect (&chunk); i++)
+        SDL_Delay (1);
+
+    assert (!eng_chunk_streamer_is_requested (-2000, -2000));
+    assert (eng_tile_get_id (&chunk, 5, 9) == 14);
+    assert (chunk.nb_objects == 2);
+    assert (chunk.object[1].x == -10024);
+
+    eng_chunk_streamer_stop ();
+    assert (!eng_chunk_streamer_is_running ());
+    eng_chunk_destroy (&chunk);
+}
+
+static void
+test_chunk_streamer_placeholder (void)
+{
+    EngChunk chunk = eng_chunk_create_chunk ();
+    chunk.chunk_x = -2000;
+    chunk.chunk_y = -2000;
+
+    eng_chunk_cache_clear ();
+    assert (eng_chunk_streamer_start ());
+
+    /* The chunk is shown as placeholder tiles with collision at first. */
+    assert (eng_chunk_load_chunk (&chunk, false));
+    assert (chunk.is_placeholder);
+    assert (!chunk.updated);
+    assert (eng_tile_get_id (&chunk, 0, 0) == ENG_CHUNK_PLACEHOLDER_ID);
+    assert (eng_tile_has_collision (&chunk, 0, 0));
+
+    /* Then the loaded chunk replaces it without blocking. */
+    for (int i = 0; i < 2000 && !eng_chunk_load_chunk (&chunk, false); i++)
+        SDL_Delay (1);
+
+    assert (!chunk.is_placeholder);
+    assert (chunk.updated);
+    assert (eng_tile_get_id (&chunk, 0, 0) == 14);
+    assert (chunk.nb_objects == 2);
+
+    /* A forced load still reads the files directly. */
+    assert (eng_chunk_load_chunk (&chunk, true));
+    assert (!chunk.is_placeholder);
+    assert (eng_tile_get_id (&chunk, 0, 0) == 14);
+
+    eng_chunk_streamer_stop ();
+    eng_chunk_destroy (&chunk);
+}
+
+static void
+test_chunk_streamer_prefetch (void)
+{
+    EngChunk chunk[NBCHUNKS];
+    int char_x = TILESIZE * TILESX / 2 - 2;
+
+    for (int i = 0; i < NBCHUNKS; i++)
+        chunk[i] = eng_chunk_create_chunk ();
+
+    eng_chunk_cache_clear ();
+
+    /* Nothing is prefetched while the streamer is stopped. */
+    assert (eng_chunk_prefetch_chunks (chunk, 0, 0, ENG_RIGHT) == 0);
+
+    eng_chunk_rotate_chunks (chunk, char_x, 0, 0, 0);
+    assert (eng_chunk_streamer_start ());
+    eng_chunk_streamer_reset_stats ();
+
+    /*
+     * Facing right near the half of chunk 0, 0, the chunks 1, 0 and 1, -1 of
+     * the next window are requested.
+     */
+    assert (eng_chunk_prefetch_chunks (chunk, char_x, 0, ENG_RIGHT) == 2);
+    assert (eng_chunk_streamer_is_requested (1, 0));
+    assert (eng_chunk_streamer_is_requested (1, -1));
+    assert (eng_chunk_prefetch_chunks (chunk, char_x, 0, ENG_RIGHT) == 0);
+
+    /* Once loaded, prefetched chunks wait in the cache. */
+    for (int i = 0; i < 2000 && eng_chunk_streamer_get_stats ().nb_loaded < 2;
+         i++) {
+        SDL_Delay (1);
+    }
+
+    eng_chunk_load_chunks (chunk, false);
+    assert (eng_chunk_cache_contains (1, 0));
+    assert (eng_chunk_cache_contains (1, -1));
+
+    /* Crossing the half chunk line needs no placeholder. */
+    eng_chunk_streamer_reset_stats ();
+    assert (eng_chunk_rotate_chunks (chunk, char_x + 4, 0, 0, 0));
+    assert (eng_chunk_get_chunk (chunk, 1, 0) != NULL);
+    assert (!eng_chunk_get_chunk (chunk, 1, 0)->is_placeholder);
+    assert (!eng_chunk_get_chunk (chunk, 1, -1)->is_placeholder);
+    assert (eng_chunk_streamer_get_stats ().nb_placeholders == 0);
+
+    eng_chunk_streamer_stop ();
+
+    for (int i = 0; i < NBCHUNKS; i++)
+        eng_chunk_destroy (&chunk[i]);
+
+    eng_chunk_cache_clear ();
+}
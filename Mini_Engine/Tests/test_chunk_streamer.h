@@ -0,0 +1,6 @@
+#ifndef TEST_CHUNK_STREAMER_H_INCLUDED
+#define TEST_CHUNK_STREAMER_H_INCLUDED
+
+void test_chunk_streamer (void);
+
+#endif /* TEST_CHUNK_STREAMER_H_INCLUDED */
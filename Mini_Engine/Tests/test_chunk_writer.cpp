@@ -0,0 +1,139 @@
+#include <assert.h>
+#include <stdio.h>
+#include "../Engine/globals.h"
+#include "../Chunks/chunk.h"
+#include "../Chunks/chunk_binary.h"
+#include "../Chunks/chunk_writer.h"
+#include "../Chunks/objects.h"
+#include "../Chunks/tile.h"
+#include "../File_Utilities/file_utilities.h"
+#include "test_chunk_writer.h"
+
+#ifdef _WIN32
+#include <direct.h>
+#define make_directory(name) _mkdir (name)
+#define remove_directory(name) _rmdir (name)
+#else
+#include <sys/stat.h>
+#include <unistd.h>
+#define make_directory(name) mkdir (name, 0700)
+#define remove_directory(name) rmdir (name)
+#endif
+
+static void test_chunk_writer_batch (void);
+static void test_chunk_writer_load (void);
+static void test_chunk_writer_failure (void);
+
+void
+test_chunk_writer (void)
+{
+    printf("\n> Unit testing chunk writer functions...\n\n");
+    test_chunk_writer_batch ();
+    test_chunk_writer_load ();
+    test_chunk_writer_failure ();
+}
+
+static void
+test_chunk_writer_batch (void)
+{
+    EngChunk chunk = eng_chunk_create_chunk ();
+    int nb_edits = TILESX < 100 ? TILESX : 100;
+    chunk.chunk_x = -2000;
+    chunk.chunk_y = -2000;
+
+    /* Painting a row of tiles does not touch the chunk file. */
+    eng_file_reset_stats ();
+
+    for (int i = 0; i < nb_edits; i++)
+        eng_tile_modify_file_id (-2000, -2000, i, 0, 3);
+
+    eng_object_add_file_object (-2000, -2000, 57, 10, 320);
+    assert (eng_file_get_stats ().nb_writes == 0);
+    assert (eng_chunk_writer_find (-2000, -2000) != NULL);
+    assert (eng_object_get_nb_objects (-2000, -2000) == 3);
+
+    eng_tile_load_tiles (&chunk);
+    assert (eng_tile_get_id (&chunk, 0, 0) == 14);
+
+    /* All the edits are written with a single write. */
+    assert (eng_chunk_writer_flush () == 1);
+    assert (eng_file_get_stats ().nb_writes == 1);
+    assert (eng_chunk_writer_find (-2000, -2000) == NULL);
+
+    eng_tile_load_tiles (&chunk);
+    assert (eng_tile_get_id (&chunk, 0, 0) == 3);
+    assert (eng_tile_get_id (&chunk, nb_edits - 1, 0) == 3);
+    assert (eng_object_get_nb_objects (-2000, -2000) == 3);
+
+    /* Reset the file to its original content. */
+    for (int i = 0; i < nb_edits; i++)
+        eng_tile_modify_file_id (-2000, -2000, i, 0, 14);
+
+    eng_object_remove_file_object (-2000, -2000, 2);
+    assert (eng_chunk_writer_flush_chunk (-2000, -2000) == ENG_FLUSH_WRITTEN);
+    assert (eng_chunk_writer_flush_chunk (-2000, -2000) ==
+            ENG_FLUSH_NOTHING_PENDING);
+
+    eng_tile_load_tiles (&chunk);
+    assert (eng_tile_get_id (&chunk, 0, 0) == 14);
+    assert (eng_object_get_nb_objects (-2000, -2000) == 2);
+
+    /* Chunks without a file cannot be edited. */
+    assert (eng_chunk_writer_edit (-2000000, -2000000) == NULL);
+
+    eng_chunk_destroy (&chunk);
+}
+
+static void
+test_chunk_writer_load (void)
+{
+    EngChunk chunk = eng_chunk_create_chunk ();
+    chunk.chunk_x = -2000;
+    chunk.chunk_y = -2000;
+
+    /* Edits not written yet are loaded before the chunk files. */
+    eng_tile_modify_file_id (-2000, -2000, 1, 1, 9);
+    assert (eng_chunk_load_chunk (&chunk, true));
+    assert (eng_tile_get_id (&chunk, 1, 1) == 9);
+    assert (chunk.nb_objects == 2);
+
+    eng_tile_modify_file_id (-2000, -2000, 1, 1, 14);
+    assert (eng_chunk_writer_flush () == 1);
+    assert (eng_chunk_load_chunk (&chunk, true));
+    assert (eng_tile_get_id (&chunk, 1, 1) == 14);
+
+    eng_chunk_destroy (&chunk);
+}
+
+static void
+test_chunk_writer_failure (void)
+{
+    EngChunk chunk = eng_chunk_create_chunk ();
+    chunk.chunk_x = -2000;
+    chunk.chunk_y = -2000;
+
+    /*
+     * A directory in place of the temporary file makes the write fail. The
+     * edits, the binary file and the cache are kept for the next flush.
+     */
+    eng_tile_modify_file_id (-2000, -2000, 2, 2, 9);
+    assert (eng_chunk_binary_convert (-2000, -2000));
+    assert (make_directory ("Demo/chunks/-2000,-2000.txt.tmp") == 0);
+    assert (eng_chunk_writer_flush () == 0);
+    assert (eng_chunk_writer_flush_chunk (-2000, -2000) == ENG_FLUSH_FAILED);
+    assert (eng_chunk_writer_find (-2000, -2000) != NULL);
+    assert (eng_chunk_binary_load (&chunk));
+    assert (eng_chunk_load_chunk (&chunk, true));
+    assert (eng_tile_get_id (&chunk, 2, 2) == 9);
+
+    /* Once the file can be written, the flush succeeds. */
+    assert (remove_directory ("Demo/chunks/-2000,-2000.txt.tmp") == 0);
+    eng_tile_modify_file_id (-2000, -2000, 2, 2, 14);
+    assert (eng_chunk_writer_flush () == 1);
+    assert (eng_chunk_writer_find (-2000, -2000) == NULL);
+    assert (!eng_chunk_binary_load (&chunk));
+    assert (eng_chunk_load_chunk (&chunk, true));
+    assert (eng_tile_get_id (&chunk, 2, 2) == 14);
+
+    eng_chunk_destroy (&chunk);
+}
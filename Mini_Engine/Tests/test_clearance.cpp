@@ -0,0 +1,209 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "../Engine/globals.h"
+#include "../Chunks/chunk.h"
+#include "../Chunks/clearance.h"
+#include "../Chunks/pathfinding.h"
+#include "../Chunks/tile.h"
+#include "test_clearance.h"
+
+static void test_clearance_chunk (void);
+static void test_clearance_incremental (void);
+static void test_clearance_window (void);
+static void test_clearance_path (void);
+
+void
+test_clearance (void)
+{
+    printf("\n> Unit testing clearance functions...\n\n");
+    test_clearance_chunk ();
+    test_clearance_incremental ();
+    test_clearance_window ();
+    test_clearance_path ();
+}
+
+static void
+test_clearance_chunk (void)
+{
+    EngChunk chunk = eng_chunk_create_chunk ();
+    EngChunk copy = eng_chunk_create_chunk ();
+
+    /* The clearance is only allocated once it is needed. */
+    assert (chunk.tile_clearance == NULL);
+    assert (eng_tile_get_memory_size (&chunk) == 0);
+
+    /* Without collision, every tile has the largest clearance. */
+    assert (eng_clearance_get_tile (&chunk, 0, 0) == ENG_CLEARANCE_MAX);
+    assert (eng_tile_get_memory_size (&chunk) == TILESX * TILESY);
+    assert (eng_clearance_get_tile (&chunk, TILESX - 1, TILESY - 1) ==
+            ENG_CLEARANCE_MAX);
+
+    /* Diagonals count as one tile, tiles outside of the chunk are free. */
+    eng_tile_set_has_collision (&chunk, 2, 3, true);
+    assert (eng_clearance_get_tile (&chunk, 2, 3) == 0);
+    assert (eng_clearance_get_tile (&chunk, 3, 3) == 1);
+    assert (eng_clearance_get_tile (&chunk, 1, 2) == 1);
+    assert (eng_clearance_get_tile (&chunk, 4, 5) == 2);
+    assert (eng_clearance_get_tile (&chunk, 0, 0) == 3);
+    assert (eng_clearance_get_tile (&chunk, 2, 3 + ENG_CLEARANCE_MAX + 2) ==
+            ENG_CLEARANCE_MAX);
+
+    /* Removing the collision gives the tiles around their clearance back. */
+    eng_tile_set_has_collision (&chunk, 2, 3, false);
+    assert (eng_clearance_get_tile (&chunk, 2, 3) == ENG_CLEARANCE_MAX);
+    assert (eng_clearance_get_tile (&chunk, 3, 3) == ENG_CLEARANCE_MAX);
+
+    /* Setting a tile to the collision it has does not change the chunk. */
+    eng_tile_set_has_collision (&chunk, 2, 3, false);
+    assert (chunk.clearance_dirty.w == 0 && chunk.clearance_dirty.h == 0);
+
+    /* Copies keep the clearance, freeing the tiles frees it. */
+    eng_tile_set_has_collision (&chunk, 2, 3, true);
+    eng_tile_copy_tiles (&copy, &chunk);
+    assert (eng_clearance_get_tile (&copy, 3, 3) == 1);
+    eng_tile_deallocate_tiles (&chunk);
+    assert (chunk.tile_clearance == NULL);
+    assert (eng_clearance_get_tile (&chunk, 3, 3) == 1);
+
+    eng_chunk_destroy (&copy);
+    eng_chunk_destroy (&chunk);
+}
+
+/* Clearance updated tile by tile must match the clearance of a new chunk. */
+static void
+test_clearance_incremental (void)
+{
+    EngChunk chunk = eng_chunk_create_chunk ();
+    EngChunk copy = eng_chunk_create_chunk ();
+    int x = 0;
+    int y = 0;
+
+    srand (20);
+
+    for (int i = 0; i < 400; i++) {
+        x = rand () % TILESX;
+        y = rand () % TILESY;
+        eng_tile_set_has_collision (&chunk, x, y, rand () % 3 != 0);
+
+        if (i % 40 == 0)
+            eng_clearance_update_chunk (&chunk);
+    }
+
+    eng_tile_copy_tiles (&copy, &chunk);
+    eng_clearance_mark_chunk (&copy);
+
+    for (y = 0; y < TILESY; y++) {
+        for (x = 0; x < TILESX; x++) {
+            assert (eng_clearance_get_tile (&chunk, x, y) ==
+                    eng_clearance_get_tile (&copy, x, y));
+        }
+    }
+
+    eng_chunk_destroy (&chunk);
+    eng_chunk_destroy (&copy);
+}
+
+static void
+test_clearance_window (void)
+{
+    EngChunk chunk[NBCHUNKS];
+    int width = TILESX * CHUNKSX;
+    int height = TILESY * CHUNKSY;
+    int version = 0;
+
+    for (int i = 0; i < NBCHUNKS; i++) {
+        chunk[i] = eng_chunk_create_chunk ();
+        chunk[i].chunk_x = 40 + i % CHUNKSX;
+        chunk[i].chunk_y = 40 + i / CHUNKSX;
+    }
+
+    /* The border of the window has collision. */
+    eng_clearance_update_window (chunk);
+    assert (eng_clearance_get_window_tile (0, height / 2) == 1);
+    assert (eng_clearance_get_window_tile (width - 1, height / 2) == 1);
+    assert (eng_clearance_get_window_tile (3, 5) == 4);
+    assert (eng_clearance_get_window_tile (width / 2, height / 2) ==
+            ENG_CLEARANCE_MAX);
+    assert (eng_clearance_get_window_tile (-1, 0) == 0);
+    assert (eng_clearance_get_window_tile (width, 0) == 0);
+    assert (eng_clearance_get_world_tile (40 * TILESX + 3, 40 * TILESY + 5) ==
+            4);
+
+    /* The clearance of the window crosses chunk borders. */
+    eng_tile_set_has_collision (&chunk[1], 0, TILESY / 2, true);
+    version = chunk[0].clearance_version;
+    eng_clearance_update_window (chunk);
+    assert (chunk[0].clearance_version == (unsigned int) version);
+    assert (eng_clearance_get_window_tile (TILESX, TILESY / 2) == 0);
+    assert (eng_clearance_get_window_tile (TILESX - 1, TILESY / 2 + 1) == 1);
+    assert (eng_clearance_get_window_tile (TILESX - 3, TILESY / 2) == 3);
+
+    /* Missing chunks have collision. */
+    chunk[NBCHUNKS - 1].chunk_x = 400;
+    eng_clearance_update_window (chunk);
+    assert (eng_clearance_get_window_tile (width - 1, height - 1) == 0);
+    assert (eng_clearance_get_window_tile (width - TILESX - 2,
+                                           height - TILESY / 2) == 2);
+
+    /* Moving the window computes the whole window again. */
+    for (int i = 0; i < NBCHUNKS; i++) {
+        chunk[i].chunk_x = i % CHUNKSX - CHUNKSX;
+        chunk[i].chunk_y = i / CHUNKSX;
+    }
+
+    eng_clearance_update_window (chunk);
+    assert (eng_clearance_get_window_tile (width - 1, height - 1) == 1);
+    assert (eng_clearance_get_window_tile (TILESX, TILESY / 2) == 0);
+    assert (eng_clearance_get_world_tile (-CHUNKSX * TILESX + TILESX,
+                                          TILESY / 2) == 0);
+
+    for (int i = 0; i < NBCHUNKS; i++)
+        eng_chunk_destroy (&chunk[i]);
+}
+
+static void
+test_clearance_path (void)
+{
+#if TILESX == 64 && TILESY == 64
+    EngChunk chunk[NBCHUNKS];
+    EngChunk *curr_chunk = NULL;
+    EngPath *path = NULL;
+    int wall_x = 60;
+
+    for (int i = 0; i < NBCHUNKS; i++) {
+        chunk[i] = eng_chunk_create_chunk ();
+        chunk[i].chunk_x = i % CHUNKSX;
+        chunk[i].chunk_y = i / CHUNKSX;
+    }
+
+    /* A wall with a passage of one tile and a passage of five tiles. */
+    for (int y = 0; y < TILESY * CHUNKSY; y++) {
+        curr_chunk = &chunk[eng_chunk_get_index (0, y / TILESY)];
+
+        if (y != 20 && (y < 90 || y > 94))
+            eng_tile_set_has_collision (curr_chunk, wall_x, y % TILESY, true);
+    }
+
+    /* Any free tile lets the path through the narrow passage. */
+    path = eng_pathfind_get_path (chunk, wall_x - 10, 20, wall_x + 10, 20);
+    assert (path != NULL && path->does_path_exist);
+    assert (path->nb_steps == 20);
+    eng_pathfind_destroy_path (&path);
+
+    /* A larger clearance goes around through the wide passage. */
+    path = eng_pathfind_get_clear_path (chunk, wall_x - 10, 20, wall_x + 10,
+                                        20, 3);
+    assert (path != NULL && path->does_path_exist);
+    assert (path->nb_steps == 20 + 2 * (92 - 20));
+    eng_pathfind_destroy_path (&path);
+
+    /* No passage is wide enough. */
+    path = eng_pathfind_get_clear_path (chunk, wall_x - 10, 20, wall_x + 10,
+                                        20, 4);
+    assert (path == NULL);
+
+    for (int i = 0; i < NBCHUNKS; i++)
+        eng_chunk_destroy (&chunk[i]);
+#endif
+}
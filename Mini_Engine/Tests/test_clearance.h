@@ -0,0 +1,6 @@
+#ifndef TEST_CLEARANCE_H_INCLUDED
+#define TEST_CLEARANCE_H_INCLUDED
+
+void test_clearance (void);
+
+#endif /* TEST_CLEARANCE_H_INCLUDED */
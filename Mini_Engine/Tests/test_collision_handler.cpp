@@ -0,0 +1,320 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "../Engine/globals.h"
+#include "../Characters/character.h"
+#include "../Chunks/chunk.h"
+#include "../Chunks/objects.h"
+#include "../Chunks/tile.h"
+#include "../Collision/collision_handler.h"
+#include "test_collision_handler.h"
+
+static void create_window (EngChunk chunk[]);
+static void destroy_window (EngChunk chunk[]);
+static void set_wall (EngChunk chunk[], int x, int y);
+static void test_collision_swept_movement (void);
+static void test_collision_high_speed (void);
+static void test_collision_across_chunks (void);
+static void test_collision_char_collision (void);
+static void test_collision_batch (void);
+static void test_collision_objects (void);
+
+void
+test_collision_handler (void)
+{
+    printf("\n> Unit testing collision functions...\n\n");
+    test_collision_swept_movement ();
+    test_collision_high_speed ();
+    test_collision_across_chunks ();
+    test_collision_char_collision ();
+    test_collision_batch ();
+    test_collision_objects ();
+}
+
+/* Creates a window of chunks starting at chunk 0,0 without any collision. */
+static void
+create_window (EngChunk chunk[])
+{
+    int chunk_x = 0;
+    int chunk_y = 0;
+
+    for (int i = 0; i < NBCHUNKS; i++) {
+        chunk_x = i % CHUNKSX;
+        chunk_y = i / CHUNKSX;
+        chunk[eng_chunk_get_index (chunk_x, chunk_y)] =
+        eng_chunk_create_chunk ();
+        chunk[eng_chunk_get_index (chunk_x, chunk_y)].chunk_x = chunk_x;
+        chunk[eng_chunk_get_index (chunk_x, chunk_y)].chunk_y = chunk_y;
+    }
+}
+
+static void
+destroy_window (EngChunk chunk[])
+{
+    for (int i = 0; i < NBCHUNKS; i++)
+        eng_chunk_destroy (&chunk[i]);
+}
+
+/* Gives collision to a tile from its world tile coordinates. */
+static void
+set_wall (EngChunk chunk[], int x, int y)
+{
+    EngChunk *curr_chunk = eng_chunk_get_chunk (chunk, x / TILESX,
+                                                y / TILESY);
+
+    eng_tile_set_has_collision (curr_chunk, x % TILESX, y % TILESY, true);
+}
+
+static void
+test_collision_swept_movement (void)
+{
+    EngChunk chunk[NBCHUNKS];
+    SDL_Rect hitbox = {2 * TILESIZE + 10, 2 * TILESIZE - 20, 2 * TILESIZE + 40,
+                       TILESIZE - 1};
+    EngPoint2d movement = {0, 0};
+
+    create_window (chunk);
+
+    /* Nothing stops the hit box. */
+    movement = eng_get_swept_movement (chunk, hitbox, 5, -7);
+    assert (movement.x == 5 && movement.y == -7);
+    movement = eng_get_swept_movement (chunk, hitbox, 0, 0);
+    assert (movement.x == 0 && movement.y == 0);
+
+    /* A wall under the middle of the hit box, between its corners. */
+    set_wall (chunk, 3, 3);
+    movement = eng_get_swept_movement (chunk, hitbox, 0, 50);
+    assert (movement.y == 20);
+    movement = eng_get_swept_movement (chunk, hitbox, 0, 20);
+    assert (movement.y == 20);
+
+    /* The hit box can leave a wall it touches. */
+    hitbox.y += 20;
+    movement = eng_get_swept_movement (chunk, hitbox, 0, 1);
+    assert (movement.y == 0);
+    movement = eng_get_swept_movement (chunk, hitbox, 0, -10);
+    assert (movement.y == -10);
+
+    /* The hit box is moved in x before being moved in y. */
+    movement = eng_get_swept_movement (chunk, hitbox, 2 * TILESIZE, 30);
+    assert (movement.x == 2 * TILESIZE && movement.y == 30);
+
+    /* A wall above the hit box. */
+    set_wall (chunk, 4, 0);
+    movement = eng_get_swept_movement (chunk, hitbox, 0, -3 * TILESIZE);
+    assert (movement.y == -TILESIZE);
+
+    destroy_window (chunk);
+}
+
+static void
+test_collision_high_speed (void)
+{
+    EngChunk chunk[NBCHUNKS];
+    SDL_Rect hitbox = {2 * TILESIZE, 5 * TILESIZE + 10, 20, 20};
+    EngPoint2d movement = {0, 0};
+
+    create_window (chunk);
+    set_wall (chunk, 10, 5);
+
+    /* A wall one tile thick is not jumped over, whatever the speed. */
+    movement = eng_get_swept_movement (chunk, hitbox, 20 * TILESIZE, 0);
+    assert (movement.x == 8 * TILESIZE - 21);
+
+    hitbox.x = 15 * TILESIZE;
+    movement = eng_get_swept_movement (chunk, hitbox, -20 * TILESIZE, 0);
+    assert (movement.x == -4 * TILESIZE);
+
+    /* Tiles outside of the chunk window have collision. */
+    hitbox.x = 2 * TILESIZE;
+    movement = eng_get_swept_movement (chunk, hitbox, -10 * TILESIZE, 0);
+    assert (movement.x == -2 * TILESIZE);
+    movement = eng_get_swept_movement (chunk, hitbox, 0, -10 * TILESIZE);
+    assert (movement.y == -5 * TILESIZE - 10);
+
+    destroy_window (chunk);
+}
+
+static void
+test_collision_across_chunks (void)
+{
+    EngChunk chunk[NBCHUNKS];
+    SDL_Rect hitbox = {(TILESX - 3) * TILESIZE, TILESIZE, 10, 10};
+    EngPoint2d movement = {0, 0};
+
+    create_window (chunk);
+
+    /* Walls in the next chunks stop the hit box at the right place. */
+    set_wall (chunk, TILESX + 2, 1);
+    movement = eng_get_swept_movement (chunk, hitbox, 10 * TILESIZE, 0);
+    assert (movement.x == 5 * TILESIZE - 11);
+
+    set_wall (chunk, TILESX - 3, TILESY + 1);
+    movement = eng_get_swept_movement (chunk, hitbox, 0, TILESY * TILESIZE);
+    assert (movement.y == TILESY * TILESIZE - 11);
+
+    /* Moving back towards the first chunk. */
+    hitbox.x = (TILESX + 6) * TILESIZE;
+    movement = eng_get_swept_movement (chunk, hitbox, -20 * TILESIZE, 0);
+    assert (movement.x == -3 * TILESIZE);
+
+    destroy_window (chunk);
+}
+
+static void
+test_collision_char_collision (void)
+{
+    EngChunk chunk[NBCHUNKS];
+    EngCharacter character = eng_char_create_character (0, 0, 0, 0, 50, 75,
+                                                        3 * TILESIZE, 20,
+                                                        true);
+    EngEvent event = {true, true, true, true, false};
+    EngCollision collision = {false, false, false, false};
+
+    create_window (chunk);
+
+    /* Only the middle of the hit box would enter the wall. */
+    character.hitbox.x = 2 * TILESIZE + 10;
+    character.hitbox.y = 3 * TILESIZE - 22;
+    set_wall (chunk, 3, 3);
+
+    collision = eng_get_char_collision (chunk, character, event);
+    assert (collision.down && !collision.up);
+    assert (!collision.left && !collision.right);
+
+    character.speed = 1;
+    collision = eng_get_char_collision (chunk, character, event);
+    assert (!collision.down);
+
+    destroy_window (chunk);
+    eng_char_destroy_character (&character);
+}
+
+static void
+test_collision_batch (void)
+{
+    static const int nb_hitboxes = 600;
+    EngChunk chunk[NBCHUNKS];
+    SDL_Rect hitbox[nb_hitboxes];
+    EngPoint2d move[nb_hitboxes];
+    EngPoint2d movement[nb_hitboxes];
+    EngPoint2d expected = {0, 0};
+    EngCharacter character[3];
+    EngCollision collision[3];
+
+    create_window (chunk);
+    srand (0);
+
+    for (int i = 0; i < 200; i++) {
+        set_wall (chunk, rand () % (CHUNKSX * TILESX),
+                  rand () % (CHUNKSY * TILESY));
+    }
+
+    /* Batches give the same movements as single queries. */
+    for (int i = 0; i < nb_hitboxes; i++) {
+        hitbox[i].x = rand () % (CHUNKSX * TILESX * TILESIZE);
+        hitbox[i].y = rand () % (CHUNKSY * TILESY * TILESIZE);
+        hitbox[i].w = rand () % (3 * TILESIZE);
+        hitbox[i].h = rand () % (3 * TILESIZE);
+        move[i].x = rand () % (8 * TILESIZE) - 4 * TILESIZE;
+        move[i].y = rand () % (8 * TILESIZE) - 4 * TILESIZE;
+    }
+
+    eng_get_swept_movements (chunk, hitbox, move, movement, nb_hitboxes);
+
+    for (int i = 0; i < nb_hitboxes; i++) {
+        expected = eng_get_swept_movement (chunk, hitbox[i], move[i].x,
+                                           move[i].y);
+        assert (movement[i].x == expected.x && movement[i].y == expected.y);
+    }
+
+    /* Characters only collide in the directions they move towards. */
+    eng_tile_reset_collision (&chunk[eng_chunk_get_index (0, 0)]);
+    set_wall (chunk, 3, 3);
+
+    for (int i = 0; i < 3; i++) {
+        character[i] = eng_char_create_character (0, 0, 0, 0, 50, 75, 20, 20,
+                                                  true);
+        character[i].hitbox.x = 3 * TILESIZE + 10;
+        character[i].hitbox.y = 2 * TILESIZE + 10;
+    }
+
+    move[0].x = 0;
+    move[0].y = TILESIZE;
+    move[1].x = 0;
+    move[1].y = -TILESIZE;
+    move[2].x = -TILESIZE;
+    move[2].y = TILESIZE;
+
+    eng_get_chars_collision (chunk, character, move, collision, 3);
+    assert (collision[0].down && !collision[0].up);
+    assert (!collision[0].left && !collision[0].right);
+    assert (!collision[1].down && !collision[1].up);
+    assert (!collision[2].left && !collision[2].down);
+
+    for (int i = 0; i < 3; i++)
+        eng_char_destroy_character (&character[i]);
+
+    destroy_window (chunk);
+}
+
+static void
+test_collision_objects (void)
+{
+    static const int chunk_width = TILESX * TILESIZE;
+    EngChunk chunk[NBCHUNKS];
+    EngChunk *right_chunk = NULL;
+    SDL_Rect footprint = {-20, 0, 40, 30};
+    SDL_Rect hitbox = {chunk_width - 100, 100, 50, 20};
+    EngCharacter character = eng_char_create_character (0, 0, 0, 0, 50, 20,
+                                                        50, 20, true);
+    EngEvent event = {true, true, true, true, false};
+    EngCollision collision = {false, false, false, false};
+    EngPoint2d movement = {0, 0};
+
+    create_window (chunk);
+    eng_object_register_footprint (1, footprint);
+
+    /* The footprint of an object of the right chunk goes past its chunk. */
+    right_chunk = eng_chunk_get_chunk (chunk, 1, 0);
+    eng_object_allocate (right_chunk, 1);
+    right_chunk->object[0] = eng_object_create_object (1, 0, 100);
+    eng_object_build_grid (right_chunk);
+
+    movement = eng_get_swept_movement (chunk, hitbox, 200, 0);
+    assert (movement.x == 29 && movement.y == 0);
+
+    /* Hit boxes going around the footprint are not stopped. */
+    hitbox.x = chunk_width - 30;
+    hitbox.y = 131;
+    movement = eng_get_swept_movement (chunk, hitbox, 200, 0);
+    assert (movement.x == 200);
+    movement = eng_get_swept_movement (chunk, hitbox, 0, -5);
+    assert (movement.y == -1);
+
+    hitbox.x = chunk_width + 30;
+    hitbox.y = 100;
+    movement = eng_get_swept_movement (chunk, hitbox, -200, 0);
+    assert (movement.x == -10);
+
+    hitbox.x = chunk_width;
+    hitbox.y = 200;
+    movement = eng_get_swept_movement (chunk, hitbox, 0, -500);
+    assert (movement.y == -70);
+
+    /* A hit box already overlapping the footprint can walk out of it. */
+    hitbox.y = 110;
+    movement = eng_get_swept_movement (chunk, hitbox, 0, 50);
+    assert (movement.y == 50);
+
+    character.hitbox.x = chunk_width - 72;
+    character.hitbox.y = 100;
+    character.speed = 3;
+    collision = eng_get_char_collision (chunk, character, event);
+    assert (collision.right && !collision.left);
+    assert (!collision.up && !collision.down);
+
+    destroy_window (chunk);
+    eng_object_clear_footprints ();
+    eng_char_destroy_character (&character);
+}
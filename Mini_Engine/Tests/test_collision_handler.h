@@ -0,0 +1,6 @@
+#ifndef TEST_COLLISION_HANDLER_H_INCLUDED
+#define TEST_COLLISION_HANDLER_H_INCLUDED
+
+void test_collision_handler (void);
+
+#endif /* TEST_COLLISION_HANDLER_H_INCLUDED */
@@ -3,6 +3,7 @@
 #include "../Engine/globals.h"
 #include "../Chunks/chunk.h"
 #include "../Chunks/objects.h"
+#include "../Chunks/chunk_writer.h"
 #include "test_objects.h"
 
 static void test_object_load_objects (void);
@@ -10,6 +11,7 @@ static void test_object_get_nb_objects (void);
 static void test_object_add_file_object (void);
 static void test_object_remove_file_object (void);
 static void test_object_modify_file_object (void);
+static void test_object_build_grid (void);
 
 void
 test_objects (void)
@@ -20,6 +22,7 @@ test_objects (void)
     test_object_add_file_object ();
     test_object_remove_file_object ();
     test_object_modify_file_object ();
+    test_object_build_grid ();
 }
 
 static void
@@ -64,6 +67,7 @@ test_object_add_file_object (void)
 
     /* We add an object in a file that already contains two. */
     eng_object_add_file_object (-2000, -2000, 57, 10, 320);
+    eng_chunk_writer_flush ();
     eng_object_load_objects (&chunk);
     nb_objects = eng_object_get_nb_objects (-2000, -2000);
 
@@ -74,6 +78,7 @@ test_object_add_file_object (void)
 
     /* Reset the file to its original content. */
     eng_object_remove_file_object (-2000, -2000, 2);
+    eng_chunk_writer_flush ();
 
     eng_chunk_destroy (&chunk);
 }
@@ -88,12 +93,14 @@ test_object_remove_file_object (void)
 
     /* We remove an object in a file that contains two. */
     eng_object_remove_file_object (-2000, -2000, 1);
+    eng_chunk_writer_flush ();
     nb_objects = eng_object_get_nb_objects (-2000, -2000);
 
     assert (nb_objects == 1);
 
     /* Reset the file to its original content. */
     eng_object_add_file_object (-2000, -2000, -2, -10024, 13);
+    eng_chunk_writer_flush ();
 
     eng_chunk_destroy (&chunk);
 }
@@ -112,6 +119,7 @@ test_object_modify_file_object (void)
     assert (chunk.object[0].y == 10);
 
     eng_object_modify_file_object (-2000, -2000, 0, -15, 24, 903);
+    eng_chunk_writer_flush ();
 
     eng_object_load_objects (&chunk);
 
@@ -121,6 +129,76 @@ test_object_modify_file_object (void)
 
     /* Reset file to its original content. */
     eng_object_modify_file_object (-2000, -2000, 0, 5, 200, 10);
+    eng_chunk_writer_flush ();
 
     eng_chunk_destroy (&chunk);
 }
+
+static void
+test_object_build_grid (void)
+{
+    EngChunk chunk = eng_chunk_create_chunk ();
+    SDL_Rect small = {2, -4, 10, 10};
+    SDL_Rect wide = {0, 0, 2 * ENG_OBJECT_CELL_SIZE + 1, 20};
+    SDL_Rect footprint;
+    const EngObjectGrid *grid = NULL;
+    int cell = 0;
+
+    assert (eng_object_register_footprint (3, small));
+    assert (eng_object_register_footprint (6, wide));
+    assert (!eng_object_register_footprint (-1, small));
+    footprint = eng_object_get_footprint (4);
+    assert (footprint.w == 0 && footprint.h == 0);
+    footprint = eng_object_get_footprint (3);
+    assert (footprint.x == 2 && footprint.y == -4 && footprint.w == 10);
+
+    /* Objects without a footprint give no grid. */
+    eng_object_allocate (&chunk, 3);
+    chunk.object[0] = eng_object_create_object (4, 100, 100);
+    chunk.object[1] = eng_object_create_object (5, 10, 10);
+    chunk.object[2] = eng_object_create_object (-3, 10, 10);
+    eng_object_build_grid (&chunk);
+    assert (chunk.object_grid == NULL);
+
+    /* A footprint is found in every cell it overlaps. */
+    chunk.object[1] = eng_object_create_object (3, ENG_OBJECT_CELL_SIZE, 20);
+    chunk.object[2] = eng_object_create_object (6, -10, 2);
+    eng_object_build_grid (&chunk);
+    grid = chunk.object_grid;
+    assert (grid != NULL);
+    assert (grid->cell_start[ENG_OBJECT_CELLSX * ENG_OBJECT_CELLSY] == 3);
+    assert (grid->bounds.x == -10 && grid->bounds.y == 2);
+    assert (grid->bounds.w == 2 * ENG_OBJECT_CELL_SIZE + 1);
+    assert (grid->bounds.h == 24);
+    assert (grid->cell_start[1] - grid->cell_start[0] == 1);
+    assert (grid->cell_start[2] - grid->cell_start[1] == 2);
+
+    cell = grid->cell_start[0];
+    assert (grid->footprint[cell].x == -10 && grid->footprint[cell].y == 2);
+    cell = grid->cell_start[1];
+    assert (grid->footprint[cell].x == ENG_OBJECT_CELL_SIZE + 2 ||
+            grid->footprint[cell + 1].x == ENG_OBJECT_CELL_SIZE + 2);
+
+    assert (eng_object_get_grid_memory_size (&chunk) ==
+            (long) (sizeof(EngObjectGrid) + 3 * sizeof(SDL_Rect)));
+
+    /* Changing the objects frees the grid, it is built again when used. */
+    eng_object_allocate (&chunk, 2);
+    assert (chunk.object_grid == NULL);
+    assert (eng_object_get_grid_memory_size (&chunk) == 0);
+    grid = eng_object_get_grid (&chunk);
+    assert (grid != NULL && grid == chunk.object_grid);
+    assert (grid->cell_start[ENG_OBJECT_CELLSX * ENG_OBJECT_CELLSY] == 1);
+    assert (eng_object_get_grid (&chunk) == grid);
+
+    assert (eng_object_get_cell (-5, ENG_OBJECT_CELLSX) == 0);
+    assert (eng_object_get_cell (ENG_OBJECT_CELL_SIZE, ENG_OBJECT_CELLSX) ==
+            1);
+    assert (eng_object_get_cell (TILESX * TILESIZE, ENG_OBJECT_CELLSX) ==
+            ENG_OBJECT_CELLSX - 1);
+
+    eng_chunk_destroy (&chunk);
+    eng_object_clear_footprints ();
+    footprint = eng_object_get_footprint (3);
+    assert (footprint.w == 0);
+}
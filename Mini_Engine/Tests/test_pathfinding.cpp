@@ -1,17 +1,29 @@
 #include <stdio.h>
+#include <stdlib.h>
 #include <assert.h>
 #include "../Chunks/chunk.h"
+#include "../Chunks/clearance.h"
 #include "../Chunks/tile.h"
 #include "../Chunks/pathfinding.h"
 #include "test_pathfinding.h"
 
 static void test_pathfind_get_path (void);
+static void test_pathfind_context (void);
+static void test_pathfind_wave (void);
+static void test_pathfind_astar (void);
+static void test_pathfind_jump (void);
+static void test_pathfind_flow_field (void);
 
 void
 test_pathfinding (void)
 {
     printf("\n> Unit testing pathfinding functions...\n\n");
     test_pathfind_get_path();
+    test_pathfind_context ();
+    test_pathfind_wave ();
+    test_pathfind_astar ();
+    test_pathfind_jump ();
+    test_pathfind_flow_field ();
 }
 
 static void
@@ -36,8 +48,8 @@ test_pathfind_get_path (void)
     chunk[3].chunk_y = -1;
 
     /* Test when the starting tile is a tile with collision. */
-    chunk[0].tile[0][0].id = 0;
-    chunk[0].tile[1][0].id = 1;
+    eng_tile_set_id (&chunk[0], 0, 0, 0);
+    eng_tile_set_id (&chunk[0], 1, 0, 1);
     eng_tile_set_collision (chunk, 0, true);
     path = eng_pathfind_get_path (chunk, tiles_x, tiles_y, tiles_x + 1,
                                   tiles_y);
@@ -64,17 +76,17 @@ test_pathfind_get_path (void)
 
     /* Test destination unreachable. */
     eng_tile_set_collision(chunk, 0, true);
-    chunk[0].tile[0][0].has_collision = false;
-    chunk[1].tile[tiles_x - 2][0].has_collision = false;
+    eng_tile_set_has_collision (&chunk[0], 0, 0, false);
+    eng_tile_set_has_collision (&chunk[1], tiles_x - 2, 0, false);
     path = eng_pathfind_get_path(chunk, tiles_x, tiles_y, tiles_x - 2, tiles_y);
     assert(path == NULL);
 
 
     /* Test starting point = ending point. */
-    chunk[0].tile[0][0].has_collision = false;
-    chunk[1].tile[0][0].has_collision = false;
-    chunk[2].tile[0][0].has_collision = false;
-    chunk[3].tile[0][0].has_collision = false;
+    eng_tile_set_has_collision (&chunk[0], 0, 0, false);
+    eng_tile_set_has_collision (&chunk[1], 0, 0, false);
+    eng_tile_set_has_collision (&chunk[2], 0, 0, false);
+    eng_tile_set_has_collision (&chunk[3], 0, 0, false);
     path = eng_pathfind_get_path (chunk, 66, 66, 66, 66);
     assert (path == NULL);
 
@@ -84,11 +96,11 @@ test_pathfind_get_path (void)
      * Note: This is hard to test if TILESX is different than tilesX or
      *       TILESY is different than tilesY
      */
-    chunk[0].tile[0][0].has_collision = false;
-    chunk[1].tile[tiles_x - 1][0].has_collision = false;
-    chunk[1].tile[tiles_x - 2][0].has_collision = false;
-    chunk[1].tile[tiles_x - 2][1].has_collision = false;
-    chunk[1].tile[tiles_x - 2][2].has_collision = false;
+    eng_tile_set_has_collision (&chunk[0], 0, 0, false);
+    eng_tile_set_has_collision (&chunk[1], tiles_x - 1, 0, false);
+    eng_tile_set_has_collision (&chunk[1], tiles_x - 2, 0, false);
+    eng_tile_set_has_collision (&chunk[1], tiles_x - 2, 1, false);
+    eng_tile_set_has_collision (&chunk[1], tiles_x - 2, 2, false);
     path = eng_pathfind_get_path (chunk, tiles_x, tiles_y, tiles_x - 2,
                                   tiles_y + 2);
     assert (path->nb_steps == 4);
@@ -100,3 +112,367 @@ test_pathfind_get_path (void)
     for (int i = 0; i < nb_chunks; i++)
         eng_chunk_destroy (&chunk[i]);
 }
+
+/* Paths found in a context must match the paths returned as new paths. */
+static void
+test_pathfind_context (void)
+{
+    EngChunk chunk[NBCHUNKS];
+    EngPathContext *context = eng_pathfind_create_context ();
+    const EngPath *found = NULL;
+    EngPath *path = NULL;
+    int start_x = 0;
+    int start_y = 0;
+    int end_x = 0;
+    int end_y = 0;
+
+    assert (context != NULL);
+
+    for (int i = 0; i < NBCHUNKS; i++) {
+        chunk[i] = eng_chunk_create_chunk ();
+        chunk[i].chunk_x = i % CHUNKSX;
+        chunk[i].chunk_y = i / CHUNKSX;
+    }
+
+    srand (21);
+
+    for (int i = 0; i < TILESX * TILESY; i++) {
+        eng_tile_set_has_collision (&chunk[rand () % NBCHUNKS],
+                                    rand () % TILESX, rand () % TILESY, true);
+    }
+
+    for (int i = 0; i < 50; i++) {
+        start_x = rand () % ENG_PATH_MAP_WIDTH;
+        start_y = rand () % ENG_PATH_MAP_HEIGHT;
+        end_x = rand () % ENG_PATH_MAP_WIDTH;
+        end_y = rand () % ENG_PATH_MAP_HEIGHT;
+        path = eng_pathfind_get_path (chunk, start_x, start_y, end_x, end_y);
+        found = eng_pathfind_find_path (context, chunk, start_x, start_y,
+                                        end_x, end_y, 1);
+
+        assert ((path == NULL) == (found == NULL));
+
+        if (path == NULL)
+            continue;
+
+        assert (found->does_path_exist);
+        assert (found->nb_steps == path->nb_steps);
+        assert (found->nb_steps >= abs (end_x - start_x) +
+                                   abs (end_y - start_y));
+
+        /* The path goes from the start to the end through free tiles. */
+        for (int j = 0; j < found->nb_steps; j++) {
+            assert (found->direction[j] == path->direction[j]);
+            start_x += found->direction[j] == ENG_RIGHT ? 1 :
+                       found->direction[j] == ENG_LEFT ? -1 : 0;
+            start_y += found->direction[j] == ENG_DOWN ? 1 :
+                       found->direction[j] == ENG_UP ? -1 : 0;
+            assert (eng_clearance_get_window_tile (start_x, start_y) > 0);
+        }
+
+        assert (start_x == end_x && start_y == end_y);
+        eng_pathfind_destroy_path (&path);
+    }
+
+    /* A path without steps does not exist. */
+    assert (eng_pathfind_find_path (context, chunk, end_x, end_y, end_x,
+                                    end_y, 1) == NULL);
+
+    eng_pathfind_destroy_context (&context);
+    assert (context == NULL);
+
+    for (int i = 0; i < NBCHUNKS; i++)
+        eng_chunk_destroy (&chunk[i]);
+}
+
+/*
+ * Waves of tiles must cross the words of the rows: a wall beside the border
+ * of two words makes the path go around it, through the words of every row.
+ */
+static void
+test_pathfind_wave (void)
+{
+    EngChunk chunk[NBCHUNKS];
+    EngPathContext *context = eng_pathfind_create_context ();
+    const EngPath *found = NULL;
+    int wall_x = ENG_PATH_MAP_WIDTH / 2 + 1;
+
+    assert (context != NULL);
+
+    for (int i = 0; i < NBCHUNKS; i++) {
+        chunk[i] = eng_chunk_create_chunk ();
+        chunk[i].chunk_x = i % CHUNKSX;
+        chunk[i].chunk_y = i / CHUNKSX;
+    }
+
+    /* The wall only has a gap in the last row of the map. */
+    for (int y = 0; y < ENG_PATH_MAP_HEIGHT - 1; y++) {
+        eng_tile_set_has_collision (&chunk[y / TILESY * CHUNKSX +
+                                           wall_x / TILESX],
+                                    wall_x % TILESX, y % TILESY, true);
+    }
+
+    found = eng_pathfind_find_path (context, chunk, 10, 10, wall_x + 1, 10,
+                                    1);
+    assert (found != NULL);
+    assert (found->nb_steps == wall_x + 1 - 10 +
+                               2 * (ENG_PATH_MAP_HEIGHT - 1 - 10));
+
+    found = eng_pathfind_find_path (context, chunk, wall_x + 1, 10, 10, 10,
+                                    1);
+    assert (found != NULL);
+    assert (found->nb_steps == wall_x + 1 - 10 +
+                               2 * (ENG_PATH_MAP_HEIGHT - 1 - 10));
+
+    /* Closing the gap leaves the two sides apart. */
+    eng_tile_set_has_collision (&chunk[NBCHUNKS - 1], wall_x % TILESX,
+                                TILESY - 1, true);
+    assert (eng_pathfind_find_path (context, chunk, 10, 10, wall_x + 1, 10,
+                                    1) == NULL);
+
+    eng_pathfind_destroy_context (&context);
+
+    for (int i = 0; i < NBCHUNKS; i++)
+        eng_chunk_destroy (&chunk[i]);
+}
+
+/* A* paths must be as short as breadth-first search paths. */
+static void
+test_pathfind_astar (void)
+{
+    EngChunk chunk[NBCHUNKS];
+    EngPathContext *context = eng_pathfind_create_context ();
+    const EngPath *found = NULL;
+    int nb_steps = 0;
+    int nb_expanded = 0;
+    int start_x = 0;
+    int start_y = 0;
+    int end_x = 0;
+    int end_y = 0;
+
+    assert (context != NULL);
+
+    for (int i = 0; i < NBCHUNKS; i++) {
+        chunk[i] = eng_chunk_create_chunk ();
+        chunk[i].chunk_x = i % CHUNKSX;
+        chunk[i].chunk_y = i / CHUNKSX;
+    }
+
+    /* Without walls, A* only expands the tiles along the path. */
+    found = eng_pathfind_find_path (context, chunk, 10, 10, 40, 30, 1);
+    assert (found != NULL && found->nb_steps == 50);
+    nb_expanded = context->nb_expanded;
+    found = eng_pathfind_find_path_astar (context, chunk, 10, 10, 40, 30, 1);
+    assert (found != NULL && found->nb_steps == 50);
+    assert (context->nb_expanded <= 51 && context->nb_expanded < nb_expanded);
+
+    srand (22);
+
+    for (int i = 0; i < TILESX * TILESY; i++) {
+        eng_tile_set_has_collision (&chunk[rand () % NBCHUNKS],
+                                    rand () % TILESX, rand () % TILESY, true);
+    }
+
+    for (int i = 0; i < 50; i++) {
+        start_x = rand () % ENG_PATH_MAP_WIDTH;
+        start_y = rand () % ENG_PATH_MAP_HEIGHT;
+        end_x = rand () % ENG_PATH_MAP_WIDTH;
+        end_y = rand () % ENG_PATH_MAP_HEIGHT;
+        found = eng_pathfind_find_path (context, chunk, start_x, start_y,
+                                        end_x, end_y, 1);
+        nb_steps = found != NULL ? found->nb_steps : -1;
+        found = eng_pathfind_find_path_astar (context, chunk, start_x,
+                                              start_y, end_x, end_y, 1);
+
+        assert ((found != NULL ? found->nb_steps : -1) == nb_steps);
+
+        if (found == NULL)
+            continue;
+
+        /* The path goes from the start to the end through free tiles. */
+        for (int j = 0; j < found->nb_steps; j++) {
+            start_x += found->direction[j] == ENG_RIGHT ? 1 :
+                       found->direction[j] == ENG_LEFT ? -1 : 0;
+            start_y += found->direction[j] == ENG_DOWN ? 1 :
+                       found->direction[j] == ENG_UP ? -1 : 0;
+            assert (eng_clearance_get_window_tile (start_x, start_y) > 0);
+        }
+
+        assert (start_x == end_x && start_y == end_y);
+    }
+
+    eng_pathfind_destroy_context (&context);
+
+    for (int i = 0; i < NBCHUNKS; i++)
+        eng_chunk_destroy (&chunk[i]);
+}
+
+/*
+ * Jump Point Search paths must be as short as breadth-first search paths, in
+ * maps with more and more walls and for wide characters.
+ */
+static void
+test_pathfind_jump (void)
+{
+    EngChunk chunk[NBCHUNKS];
+    EngPathContext *context = eng_pathfind_create_context ();
+    const EngPath *found = NULL;
+    int nb_steps = 0;
+    int clearance = 1;
+    int start_x = 0;
+    int start_y = 0;
+    int end_x = 0;
+    int end_y = 0;
+
+    assert (context != NULL);
+
+    for (int i = 0; i < NBCHUNKS; i++) {
+        chunk[i] = eng_chunk_create_chunk ();
+        chunk[i].chunk_x = i % CHUNKSX;
+        chunk[i].chunk_y = i / CHUNKSX;
+    }
+
+    /* Without walls, only the ends of the path and its turn are expanded. */
+    found = eng_pathfind_find_path_jump (context, chunk, 10, 10, 40, 30, 1);
+    assert (found != NULL && found->nb_steps == 50);
+    assert (context->nb_expanded <= 3);
+
+    srand (23);
+
+    for (int density = 0; density < 4; density++) {
+        for (int i = 0; i < TILESX * TILESY / 4; i++) {
+            eng_tile_set_has_collision (&chunk[rand () % NBCHUNKS],
+                                        rand () % TILESX, rand () % TILESY,
+                                        true);
+        }
+
+        for (int i = 0; i < 100; i++) {
+            clearance = i % 4 == 0 ? 2 : 1;
+            start_x = rand () % ENG_PATH_MAP_WIDTH;
+            start_y = rand () % ENG_PATH_MAP_HEIGHT;
+            end_x = rand () % ENG_PATH_MAP_WIDTH;
+            end_y = rand () % ENG_PATH_MAP_HEIGHT;
+            found = eng_pathfind_find_path (context, chunk, start_x, start_y,
+                                            end_x, end_y, clearance);
+            nb_steps = found != NULL ? found->nb_steps : -1;
+            found = eng_pathfind_find_path_jump (context, chunk, start_x,
+                                                 start_y, end_x, end_y,
+                                                 clearance);
+
+            assert ((found != NULL ? found->nb_steps : -1) == nb_steps);
+
+            if (found == NULL)
+                continue;
+
+            /* The path goes from the start to the end, one tile per step. */
+            for (int j = 0; j < found->nb_steps; j++) {
+                start_x += found->direction[j] == ENG_RIGHT ? 1 :
+                           found->direction[j] == ENG_LEFT ? -1 : 0;
+                start_y += found->direction[j] == ENG_DOWN ? 1 :
+                           found->direction[j] == ENG_UP ? -1 : 0;
+                assert (eng_clearance_get_window_tile (start_x, start_y) >=
+                        clearance);
+            }
+
+            assert (start_x == end_x && start_y == end_y);
+        }
+    }
+
+    eng_pathfind_destroy_context (&context);
+
+    for (int i = 0; i < NBCHUNKS; i++)
+        eng_chunk_destroy (&chunk[i]);
+}
+
+/*
+ * Following a flow field must take the paths of the breadth-first search, and
+ * the field must be computed again when the collision of the map changes.
+ */
+static void
+test_pathfind_flow_field (void)
+{
+    EngChunk chunk[NBCHUNKS];
+    EngPathContext *context = eng_pathfind_create_context ();
+    const EngFlowField *field = NULL;
+    const EngPath *found = NULL;
+    int direction = 0;
+    int nb_steps = 0;
+    int start_x = 0;
+    int start_y = 0;
+    int end_x = 0;
+    int end_y = 0;
+
+    assert (context != NULL);
+
+    for (int i = 0; i < NBCHUNKS; i++) {
+        chunk[i] = eng_chunk_create_chunk ();
+        chunk[i].chunk_x = i % CHUNKSX;
+        chunk[i].chunk_y = i / CHUNKSX;
+    }
+
+    srand (25);
+
+    for (int i = 0; i < TILESX * TILESY; i++) {
+        eng_tile_set_has_collision (&chunk[rand () % NBCHUNKS],
+                                    rand () % TILESX, rand () % TILESY, true);
+    }
+
+    do {
+        end_x = rand () % ENG_PATH_MAP_WIDTH;
+        end_y = rand () % ENG_PATH_MAP_HEIGHT;
+        field = eng_pathfind_get_flow_field (chunk, end_x, end_y, 1);
+    } while (field == NULL);
+
+    /* The field is kept while the map does not change. */
+    assert (eng_pathfind_get_flow_field (chunk, end_x, end_y, 1) == field);
+    assert (eng_pathfind_get_flow_direction (field, end_x, end_y) == -1);
+    assert (eng_pathfind_get_flow_direction (field, -1, 0) == -1);
+    assert (eng_pathfind_get_flow_direction (field, 0,
+                                             ENG_PATH_MAP_HEIGHT) == -1);
+
+    for (int i = 0; i < 50; i++) {
+        start_x = rand () % ENG_PATH_MAP_WIDTH;
+        start_y = rand () % ENG_PATH_MAP_HEIGHT;
+        found = eng_pathfind_find_path (context, chunk, start_x, start_y,
+                                        end_x, end_y, 1);
+        direction = eng_pathfind_get_flow_direction (field, start_x,
+                                                     start_y);
+
+        if (found == NULL) {
+            assert (direction == -1);
+            continue;
+        }
+
+        for (nb_steps = 0; direction != -1; nb_steps++) {
+            assert (nb_steps < found->nb_steps);
+            assert (direction == found->direction[nb_steps]);
+            start_x += direction == ENG_RIGHT ? 1 :
+                       direction == ENG_LEFT ? -1 : 0;
+            start_y += direction == ENG_DOWN ? 1 :
+                       direction == ENG_UP ? -1 : 0;
+            direction = eng_pathfind_get_flow_direction (field, start_x,
+                                                         start_y);
+        }
+
+        assert (nb_steps == found->nb_steps);
+        assert (start_x == end_x && start_y == end_y);
+    }
+
+    /* A tile with collision next to the goal leaves the field. */
+    start_x = end_x > 0 ? end_x - 1 : end_x + 1;
+    eng_tile_set_has_collision (&chunk[end_y / TILESY * CHUNKSX +
+                                       start_x / TILESX],
+                                start_x % TILESX, end_y % TILESY, true);
+    field = eng_pathfind_get_flow_field (chunk, end_x, end_y, 1);
+    assert (field != NULL);
+    assert (field->version == eng_clearance_get_window_version ());
+    assert (eng_pathfind_get_flow_direction (field, start_x, end_y) == -1);
+
+    /* A goal with collision has no field. */
+    assert (eng_pathfind_get_flow_field (chunk, start_x, end_y, 1) == NULL);
+
+    eng_pathfind_destroy_context (&context);
+
+    for (int i = 0; i < NBCHUNKS; i++)
+        eng_chunk_destroy (&chunk[i]);
+}
@@ -3,10 +3,16 @@
 #include "../Engine/globals.h"
 #include "../Chunks/chunk.h"
 #include "../Chunks/tile.h"
+#include "../Chunks/chunk_writer.h"
 #include "test_tile.h"
 
 static void test_tile_modify_tile_id (void);
 static void test_tile_load_tiles (void);
+static void test_tile_accessors (void);
+static void test_tile_properties (void);
+static void test_tile_palette (void);
+static void test_tile_get_index (void);
+static void test_tile_animation (void);
 
 void
 test_tile (void)
@@ -14,6 +20,11 @@ test_tile (void)
     printf("\n> Unit testing tile functions...\n\n");
     test_tile_modify_tile_id ();
     test_tile_load_tiles ();
+    test_tile_accessors ();
+    test_tile_properties ();
+    test_tile_palette ();
+    test_tile_get_index ();
+    test_tile_animation ();
 }
 
 static void
@@ -26,32 +37,36 @@ test_tile_modify_tile_id (void)
 
     /* We make a change to the tile x: 0, y: 0 in the file. */
     eng_tile_modify_file_id (-2000, -2000, 0, 0, 12);
+    eng_chunk_writer_flush ();
     eng_tile_load_tiles (&chunk);
 
-    assert (chunk.tile[0][0].id == 12);
+    assert (eng_tile_get_id (&chunk, 0, 0) == 12);
 
 #if TILESX >= 20 && TILESY >= 19
     /* We make a change to the tile x: 20, y: 19 in the file. */
     eng_tile_modify_file_id (-2000, -2000, 20, 19, 6);
+    eng_chunk_writer_flush ();
     eng_tile_load_tiles (&chunk);
 
-    assert (chunk.tile[20][19].id == 6);
+    assert (eng_tile_get_id (&chunk, 20, 19) == 6);
 #endif
 
     /* Reset the file to its original content. */
     eng_tile_modify_file_id (-2000, -2000, 0, 0, 14);
     eng_tile_modify_file_id (-2000, -2000, 20, 19, 14);
+    eng_chunk_writer_flush ();
 
     /*
      * Now we try to make a change that is out of bounds and check
      * that all tiles are still 14.
      */
     eng_tile_modify_file_id (-2000, -2000, -10, 4805, 34);
+    eng_chunk_writer_flush ();
     eng_tile_load_tiles (&chunk);
 
     for (int i = 0; i < TILESX; i++) {
         for (int j = 0; j < TILESY; j++) {
-            assert (chunk.tile[i][j].id == 14);
+            assert (eng_tile_get_id (&chunk, i, j) == 14);
         }
     }
 
@@ -70,9 +85,209 @@ test_tile_load_tiles (void)
 
     for (int i = 0; i < TILESX; i++) {
         for (int j = 0; j < TILESY; j++) {
-            assert (chunk.tile[i][j].id == 14);
+            assert (eng_tile_get_id (&chunk, i, j) == 14);
         }
     }
 
     eng_chunk_destroy (&chunk);
 }
+
+static void
+test_tile_accessors (void)
+{
+    EngChunk chunk = eng_chunk_create_chunk ();
+    EngChunk copy = eng_chunk_create_chunk ();
+
+    /* Collision bits of neighbouring tiles do not affect each other. */
+    eng_tile_set_has_collision (&chunk, TILESX - 1, TILESY - 1, true);
+    eng_tile_set_has_collision (&chunk, 1, 0, true);
+    assert (eng_tile_has_collision (&chunk, TILESX - 1, TILESY - 1));
+    assert (eng_tile_has_collision (&chunk, 1, 0));
+    assert (!eng_tile_has_collision (&chunk, 0, 0));
+    assert (!eng_tile_has_collision (&chunk, TILESX - 2, TILESY - 1));
+    eng_tile_set_has_collision (&chunk, 1, 0, false);
+    assert (!eng_tile_has_collision (&chunk, 1, 0));
+
+    eng_tile_reset_collision (&chunk);
+    assert (!eng_tile_has_collision (&chunk, TILESX - 1, TILESY - 1));
+
+    /* Copies keep ids and collision. */
+    eng_tile_set_id (&chunk, 3, 4, 8);
+    eng_tile_set_has_collision (&chunk, 3, 4, true);
+    eng_tile_copy_tiles (&copy, &chunk);
+    assert (eng_tile_get_id (&copy, 3, 4) == 8);
+    assert (eng_tile_has_collision (&copy, 3, 4));
+
+    eng_chunk_destroy (&chunk);
+    eng_chunk_destroy (&copy);
+}
+
+static void
+test_tile_properties (void)
+{
+    EngChunk chunk = eng_chunk_create_chunk ();
+    chunk.chunk_x = -2000;
+    chunk.chunk_y = -2000;
+
+    /* Unregistered ids have the default properties. */
+    assert (eng_tile_get_properties (14).flags == 0);
+    assert (eng_tile_get_properties (14).movement_cost == 1);
+    assert (!eng_tile_register_properties (-1, ENG_TILE_SOLID, 1));
+
+    assert (eng_tile_register_properties (14, ENG_TILE_SOLID | ENG_TILE_WATER,
+                                          3));
+    assert (eng_tile_get_properties (14).flags ==
+            (ENG_TILE_SOLID | ENG_TILE_WATER));
+    assert (eng_tile_get_properties (14).movement_cost == 3);
+    assert (eng_tile_get_properties (13).flags == 0);
+
+    /* Loaded tiles are given the collision of their id. */
+    eng_tile_load_tiles (&chunk);
+    assert (eng_tile_has_collision (&chunk, 0, 0));
+    assert (eng_tile_has_collision (&chunk, TILESX - 1, TILESY - 1));
+
+    assert (eng_chunk_read_chunk (&chunk, NULL));
+    assert (eng_tile_has_collision (&chunk, TILESX / 2, TILESY / 2));
+
+    eng_tile_stamp_id (&chunk, 1, 1, 13);
+    assert (!eng_tile_has_collision (&chunk, 1, 1));
+
+    eng_tile_fill (&chunk, 14);
+    assert (eng_tile_has_collision (&chunk, 1, 1));
+
+    eng_tile_clear_properties ();
+    assert (eng_tile_get_properties (14).flags == 0);
+
+    eng_chunk_destroy (&chunk);
+}
+
+static void
+test_tile_palette (void)
+{
+    EngChunk chunk = eng_chunk_create_chunk ();
+    EngChunk copy = eng_chunk_create_chunk ();
+    int32_t id[TILESX * TILESY];
+
+    /* Chunks without tile data only have tiles of id 0. */
+    assert (chunk.tile_bits == 0);
+    assert (eng_tile_get_id (&chunk, 5, 5) == 0);
+    assert (eng_tile_get_memory_size (&chunk) == 0);
+
+    /* Up to 16 ids (including id 0) use 4 bit indices. */
+    for (int i = 0; i < 15; i++)
+        eng_tile_set_id (&chunk, i, 0, 100 + i);
+
+    assert (chunk.tile_bits == 4);
+    assert (eng_tile_get_id (&chunk, 14, 0) == 114);
+    assert (eng_tile_get_id (&chunk, 0, 1) == 0);
+
+    /* The palette grows to 8 bit indices, then to 16 bit ids. */
+    eng_tile_set_id (&chunk, 15, 0, 115);
+    assert (chunk.tile_bits == 8);
+    assert (eng_tile_get_id (&chunk, 3, 0) == 103);
+    assert (eng_tile_get_id (&chunk, 15, 0) == 115);
+
+    for (int i = 0; i < TILESX * TILESY && i < 300; i++)
+        eng_tile_set_id (&chunk, i % TILESX, i / TILESX, i);
+
+    assert (chunk.tile_bits == (TILESX * TILESY > 256 ? 16 : 8));
+    assert (eng_tile_get_id (&chunk, 1, 0) == 1);
+    assert (eng_tile_get_id (&chunk, TILESX - 1, 0) == TILESX - 1);
+
+    /* Ids that do not fit on 16 bits are rejected. */
+    eng_tile_set_id (&chunk, 1, 0, ENG_TILE_MAX_ID);
+    assert (eng_tile_get_id (&chunk, 1, 0) == ENG_TILE_MAX_ID);
+    eng_tile_set_id (&chunk, 1, 0, ENG_TILE_MAX_ID + 1);
+    assert (eng_tile_get_id (&chunk, 1, 0) == ENG_TILE_MAX_ID);
+    eng_tile_set_id (&chunk, 1, 0, 1);
+
+        /* Copies and moves keep the ids. */
+    eng_tile_copy_tiles (&copy, &chunk);
+    assert (eng_tile_get_id (&copy, TILESX - 1, 0) == TILESX - 1);
+    eng_tile_move_tiles (&copy, &chunk);
+    assert (eng_tile_get_id (&copy, 1, 0) == 1);
+    assert (chunk.tile_bits == 0);
+    assert (eng_tile_get_id (&chunk, 1, 0) == 0);
+
+    /* Ids read from files that do not fit on 16 bits are stored as -1. */
+    for (int i = 0; i < TILESX * TILESY; i++)
+        id[i] = 14;
+
+    id[1] = ENG_TILE_MAX_ID + 1;
+    eng_tile_load_ids (&chunk, id);
+    assert (chunk.tile_bits == 4);
+    assert (eng_tile_get_id (&chunk, 0, 0) == 14);
+    assert (eng_tile_get_id (&chunk, 1, 0) == -1);
+
+    eng_chunk_destroy (&copy);
+    eng_chunk_destroy (&chunk);
+}
+
+static void
+test_tile_get_index (void)
+{
+    static bool is_used[TILESX * TILESY];
+    int index = 0;
+
+    /* Every tile has its own position, whatever the tile layout. */
+    for (int y = 0; y < TILESY; y++) {
+        for (int x = 0; x < TILESX; x++) {
+            index = eng_tile_get_index (x, y);
+            assert (index >= 0 && index < TILESX * TILESY);
+            assert (!is_used[index]);
+            is_used[index] = true;
+        }
+    }
+
+    /* The Z curve visits a 2 by 2 block before the next one. */
+    assert (eng_tile_get_morton_index (0, 0) == 0);
+    assert (eng_tile_get_morton_index (1, 0) == 1);
+    assert (eng_tile_get_morton_index (0, 1) == 2);
+    assert (eng_tile_get_morton_index (1, 1) == 3);
+    assert (eng_tile_get_morton_index (2, 0) == 4);
+    assert (eng_tile_get_morton_index (3, 5) == 39);
+}
+
+static void
+test_tile_animation (void)
+{
+    /* Ids that are not animated are drawn as they are. */
+    eng_tile_set_animation_clock (10.0);
+    assert (eng_tile_get_frame_id (7) == 7);
+    assert (eng_tile_get_frame_id (-1) == -1);
+
+    assert (!eng_tile_register_animation (-1, 4, 250));
+    assert (!eng_tile_register_animation (7, 0, 250));
+    assert (!eng_tile_register_animation (7, 4, 0));
+
+    /* The animation keeps the other properties of the id. */
+    assert (eng_tile_register_properties (7, ENG_TILE_WATER, 3));
+    assert (eng_tile_register_animation (7, 4, 250));
+    assert (eng_tile_get_properties (7).flags ==
+            (ENG_TILE_WATER | ENG_TILE_ANIMATED));
+    assert (eng_tile_get_properties (7).movement_cost == 3);
+
+    /* The frame follows the clock and loops. */
+    eng_tile_set_animation_clock (0.0);
+    assert (eng_tile_get_frame_id (7) == 7);
+    eng_tile_set_animation_clock (0.26);
+    assert (eng_tile_get_frame_id (7) == 8);
+    eng_tile_set_animation_clock (0.76);
+    assert (eng_tile_get_frame_id (7) == 10);
+    eng_tile_set_animation_clock (1.01);
+    assert (eng_tile_get_frame_id (7) == 7);
+
+    /* Registering the properties again keeps the animation. */
+    assert (eng_tile_register_properties (7, ENG_TILE_ANIMATED, 1));
+    assert (eng_tile_get_frame_id (7) == 7);
+    eng_tile_set_animation_clock (0.51);
+    assert (eng_tile_get_frame_id (7) == 9);
+
+    /* Without the animated flag, the id is drawn as it is. */
+    assert (eng_tile_register_properties (7, ENG_TILE_WATER, 1));
+    assert (eng_tile_get_frame_id (7) == 7);
+
+    eng_tile_clear_properties ();
+    assert (eng_tile_get_frame_id (7) == 7);
+    eng_tile_set_animation_clock (0.0);
+}
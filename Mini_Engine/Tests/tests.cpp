@@ -12,8 +12,17 @@
 #include "test_hud.h"
 #include "test_file_utilities.h"
 #include "test_character.h"
+#include "test_collision_handler.h"
 #include "test_pathfinding.h"
 #include "test_chunk.h"
+#include "test_chunk_binary.h"
+#include "test_chunk_parser.h"
+#include "test_chunk_region.h"
+#include "test_chunk_cache.h"
+#include "test_chunk_directory.h"
+#include "test_clearance.h"
+#include "test_chunk_streamer.h"
+#include "test_chunk_writer.h"
 #include "test_objects.h"
 #include "test_tile.h"
 
@@ -34,10 +43,19 @@ eng_test_all (void)
     test_hud ();
     test_file_utilities ();
     test_character ();
+    test_collision_handler ();
     test_chunk ();
+    test_clearance ();
     test_pathfinding ();
     test_objects ();
     test_tile ();
+    test_chunk_binary ();
+    test_chunk_parser ();
+    test_chunk_region ();
+    test_chunk_cache ();
+    test_chunk_directory ();
+    test_chunk_streamer ();
+    test_chunk_writer ();
 
     printf ("\n!---- ENGINE FUNCTION UNIT TESTING END ----!\n\n"
             "The error messages above are normal and generated by function "
@@ -7,6 +7,7 @@
 /*===========================================================================*/
 
 #include <time.h>
+#include <SDL.h>
 #include "time.h"
 
 /*
@@ -19,6 +20,18 @@ eng_get_real_time (void)
     return (double) clock () / CLOCKS_PER_SEC;
 }
 
+/*
+ * Returns a wall clock time in seconds from the high resolution counter of
+ * the system. Unlike clock (), it does not depend on the processor time used
+ * by the program.
+ */
+double
+eng_get_precise_time (void)
+{
+    return (double) SDL_GetPerformanceCounter () /
+           SDL_GetPerformanceFrequency ();
+}
+
 /*
  * Returns the real clock time in seconds since start of program, affected by
  * a time ratio (game time ratio).
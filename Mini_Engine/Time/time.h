@@ -26,6 +26,14 @@ typedef struct _EngTime {
  */
 double eng_get_real_time (void);
 
+/**
+ * @return A wall clock time in seconds from the high resolution counter of
+ *         the system, used to measure short durations.
+ *
+ * @sa eng_get_real_time ()
+ */
+double eng_get_precise_time (void);
+
 /**
  * @return The real clock time in seconds since start of program, affected by
  *         a time ratio (game time ratio).
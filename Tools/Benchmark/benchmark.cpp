@@ -0,0 +1,23 @@
+/*===========================================================================*/
+/* File: benchmark.cpp                                                       */
+/* Author: YOAN BERNATCHEZ                                                   */
+/* Created On: 2026-10-16                                                    */
+/* Developed Using: SDL2                                                     */
+/* Function: Offline tool that runs the engine benchmarks on the Demo data.  */
+/*===========================================================================*/
+
+#define SDL_MAIN_HANDLED
+
+#include "../../Mini_Engine/Benchmarks/benchmarks.h"
+
+/*
+ * Runs every benchmark. The tool must be run from the root of the project,
+ * where the Demo directory is located.
+ */
+int
+main (void)
+{
+    eng_bench_all ();
+
+    return 0;
+}
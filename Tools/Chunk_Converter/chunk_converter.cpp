@@ -0,0 +1,52 @@
+/*===========================================================================*/
+/* File: chunk_converter.cpp                                                 */
+/* Author: YOAN BERNATCHEZ                                                   */
+/* Created On: 2026-10-16                                                    */
+/* Developed Using: SDL2                                                     */
+/* Function: Offline tool that converts the text chunk files of a range of   */
+/*           chunks to the binary chunk format used by the engine.           */
+/*===========================================================================*/
+
+#define SDL_MAIN_HANDLED
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../../Mini_Engine/Chunks/chunk_binary.h"
+
+/*
+ * Converts every text chunk file found between (min_x, min_y) and
+ * (max_x, max_y). The tool must be run from the root of the project, where
+ * the Demo/chunks directory is located.
+ */
+int
+main (int argc, char *argv[])
+{
+    int min_x = 0;
+    int min_y = 0;
+    int max_x = 0;
+    int max_y = 0;
+    int nb_converted = 0;
+
+    if (argc != 5) {
+        printf ("Usage: %s min_x min_y max_x max_y\n", argv[0]);
+        return 1;
+    }
+
+    min_x = atoi (argv[1]);
+    min_y = atoi (argv[2]);
+    max_x = atoi (argv[3]);
+    max_y = atoi (argv[4]);
+
+    for (int y = min_y; y <= max_y; y++) {
+        for (int x = min_x; x <= max_x; x++) {
+            if (eng_chunk_binary_convert (x, y)) {
+                printf ("Converted chunk %d,%d\n", x, y);
+                nb_converted++;
+            }
+        }
+    }
+
+    printf ("%d chunk(s) converted.\n", nb_converted);
+
+    return 0;
+}
@@ -0,0 +1,68 @@
+/*===========================================================================*/
+/* File: region_packer.cpp                                                   */
+/* Author: YOAN BERNATCHEZ                                                   */
+/* Created On: 2026-10-16                                                    */
+/* Developed Using: SDL2                                                     */
+/* Function: Offline tool that packs the chunk files of a range of chunks in */
+/*           region files of ENG_REGION_SIZE by ENG_REGION_SIZE chunks.      */
+/*===========================================================================*/
+
+#define SDL_MAIN_HANDLED
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../../Mini_Engine/Chunks/chunk_region.h"
+
+/*
+ * Packs every region containing a chunk between (min_x, min_y) and
+ * (max_x, max_y). The tool must be run from the root of the project, where
+ * the Demo/chunks directory is located. Loose chunk files take precedence
+ * over the region files, so the files packed are deleted once their region
+ * is written, unless --keep-loose is given.
+ */
+int
+main (int argc, char *argv[])
+{
+    int min_x = 0;
+    int min_y = 0;
+    int max_x = 0;
+    int max_y = 0;
+    int nb_chunks = 0;
+    int nb_regions = 0;
+    int nb_packed = 0;
+    bool remove_loose = true;
+
+    if (argc == 6 && strcmp (argv[5], "--keep-loose") == 0)
+        remove_loose = false;
+    else if (argc != 5) {
+        printf ("Usage: %s min_chunk_x min_chunk_y max_chunk_x max_chunk_y "
+                "[--keep-loose]\n", argv[0]);
+        return 1;
+    }
+
+    min_x = eng_chunk_region_get_region (atoi (argv[1]));
+    min_y = eng_chunk_region_get_region (atoi (argv[2]));
+    max_x = eng_chunk_region_get_region (atoi (argv[3]));
+    max_y = eng_chunk_region_get_region (atoi (argv[4]));
+
+    for (int y = min_y; y <= max_y; y++) {
+        for (int x = min_x; x <= max_x; x++) {
+            nb_packed = eng_chunk_region_pack (x, y, remove_loose);
+
+            if (nb_packed > 0) {
+                printf ("Packed %d chunk(s) in region %d,%d\n", nb_packed, x,
+                        y);
+                nb_chunks += nb_packed;
+                nb_regions++;
+            }
+        }
+    }
+
+    printf ("%d chunk(s) packed in %d region(s).\n", nb_chunks, nb_regions);
+
+    if (remove_loose && nb_chunks > 0)
+        printf ("The chunk files packed were deleted.\n");
+
+    return 0;
+}